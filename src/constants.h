@@ -51,6 +51,34 @@ constexpr int FRAME_TIME_MS_LOOKUP[] = {
 // At 120fps we do 1x, at 60fps 2x, at 30fps 4x, at 15fps 8x
 constexpr int PHYSICS_SCALE[] = {8, 4, 2, 1};
 
+// Physics steps per second (physics values are tuned for 120fps)
+constexpr int PHYSICS_RATE = 120;
+
+// Most physics steps run for one frame when they follow elapsed time
+// (one 15fps frame), so a stall doesn't turn into a burst of catch-up steps
+constexpr int MAX_PHYSICS_STEPS = 8;
+
+// Immediate mode: the last millisecond of a frame's wait is slept in steps
+// of at most this long, so a frame is late by at most the scheduler's timer
+// slack (tens of microseconds) and the limiter never keeps a core busy
+constexpr int FRAME_SLEEP_MICROS = 100;
+
+// Presentation modes (user-selectable at runtime)
+// - VSync: present waits for the vertical blank and the frame limiter also
+//   sleeps to the target frame time (frames are paced by both)
+// - Immediate: present never waits, frames are paced by the game's own
+//   limiter against a fixed schedule
+// - Paced: present waits for the vertical blank, the limiter measures when
+//   presents complete and rounds the frame time to whole refresh intervals,
+//   and physics follows elapsed time
+enum class PresentMode {
+    VSync,
+    Immediate,
+    Paced
+};
+constexpr int PRESENT_MODE_COUNT = 3;
+constexpr const char* PRESENT_MODE_NAMES[] = {"vsync", "immediate", "paced"};
+
 // For backward compatibility (used in init logging)
 constexpr int TARGET_FPS = 120;
 constexpr int FRAME_TIME_MS = 1000 / TARGET_FPS;
@@ -0,0 +1,120 @@
+// cpu_dispatch.cpp
+// CPU feature detection and the kernel tables bound at startup
+
+#include "cpu_dispatch.h"
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define LANDER_CPU_X86 1
+#endif
+
+#if defined(LANDER_CPU_X86) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Defined by the cpu_kernels_<level>.cpp files
+extern const CpuKernels CPU_KERNELS_SCALAR;
+extern const CpuKernels CPU_KERNELS_BASELINE;
+extern const CpuKernels CPU_KERNELS_AVX2;
+extern const CpuKernels CPU_KERNELS_AVX512;
+
+namespace {
+
+const CpuKernels* const LEVEL_KERNELS[CPU_LEVEL_COUNT] = {
+    &CPU_KERNELS_SCALAR,
+    &CPU_KERNELS_BASELINE,
+    &CPU_KERNELS_AVX2,
+    &CPU_KERNELS_AVX512,
+};
+
+// Whether the CPU (and the OS, which has to save the wider registers) can
+// run a level's instructions
+bool cpuSupports(CpuLevel level) {
+    if (level == CpuLevel::Scalar || level == CpuLevel::Baseline) {
+        return true;
+    }
+#if defined(LANDER_CPU_X86) && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+    __cpuid(info, 1);
+    bool osSavesAvx = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0;
+    if (!osSavesAvx) {
+        return false;
+    }
+    unsigned long long enabled = _xgetbv(0);
+    __cpuidex(info, 7, 0);
+    if (level == CpuLevel::AVX2) {
+        return (enabled & 0x06) == 0x06 && (info[1] & (1 << 5)) != 0;
+    }
+    return (enabled & 0xE6) == 0xE6 && (info[1] & (1 << 16)) != 0;
+#elif defined(LANDER_CPU_X86) && (defined(__GNUC__) || defined(__clang__))
+    // These check the OS state as well as the CPUID bits
+    __builtin_cpu_init();
+    if (level == CpuLevel::AVX2) {
+        return __builtin_cpu_supports("avx2");
+    }
+    return __builtin_cpu_supports("avx512f");
+#else
+    return false;
+#endif
+}
+
+} // namespace
+
+// =============================================================================
+// CpuDispatch Implementation
+// =============================================================================
+
+namespace CpuDispatch {
+    const CpuKernels* kernels = &CPU_KERNELS_BASELINE;
+    CpuLevel level = CpuLevel::Baseline;
+}
+
+CpuLevel CpuDispatch::detect() {
+    static const CpuLevel detected = [] {
+        for (int index = CPU_LEVEL_COUNT - 1; index > 0; index--) {
+            CpuLevel candidate = static_cast<CpuLevel>(index);
+            if (LEVEL_KERNELS[index]->targeted && cpuSupports(candidate)) {
+                return candidate;
+            }
+        }
+        return CpuLevel::Scalar;
+    }();
+    return detected;
+}
+
+CpuLevel CpuDispatch::select(CpuLevel requested) {
+    int index = static_cast<int>(requested);
+    int best = static_cast<int>(detect());
+    if (index > best) {
+        index = best;
+    }
+    while (index > 0 && !LEVEL_KERNELS[index]->targeted) {
+        index--;
+    }
+    level = static_cast<CpuLevel>(index);
+    kernels = LEVEL_KERNELS[index];
+    return level;
+}
+
+const CpuKernels& CpuDispatch::getKernels(CpuLevel level) {
+    return *LEVEL_KERNELS[static_cast<int>(level)];
+}
+
+const char* CpuDispatch::getLevelName(CpuLevel level) {
+    int index = static_cast<int>(level);
+    return (index >= 0 && index < CPU_LEVEL_COUNT) ? LEVEL_KERNELS[index]->name : "?";
+}
+
+bool CpuDispatch::findLevel(const char* name, CpuLevel& level) {
+    for (int index = 0; index < CPU_LEVEL_COUNT; index++) {
+        if (std::strcmp(name, LEVEL_KERNELS[index]->name) == 0) {
+            level = static_cast<CpuLevel>(index);
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,94 @@
+// cpu_dispatch.h
+// CPU feature detection and the kernel tables bound at startup
+
+#ifndef LANDER_CPU_DISPATCH_H
+#define LANDER_CPU_DISPATCH_H
+
+#include <cstdint>
+
+// =============================================================================
+// CPU Dispatch
+// =============================================================================
+//
+// One binary has to run well on everything from SSE2-only machines to ones
+// with AVX2 and AVX-512. The hot kernels (cpu_kernels.h) are compiled once
+// per CPU level, each translation unit with that level's instruction set
+// flags, into a table of function pointers per kernel family. At startup the
+// game detects what the CPU supports and binds the tables of the best level
+// it can run:
+//
+//   scalar    Plain loops (the reference the other levels must match)
+//   sse2      The compiler's baseline: SSE2 on x86-64, NEON ("neon") on
+//             AArch64
+//   avx2      AVX2 (x86 only)
+//   avx512    AVX-512F (x86 only)
+//
+// Until then the baseline tables are bound, so code running before startup
+// (and tests) gets working kernels. --cpu-level forces a lower level, to
+// compare levels on the same machine; every level gives exactly the same
+// results.
+//
+// Levels the build can't target (the x86 levels on other architectures) are
+// still compiled, with baseline flags, but never selected.
+//
+// =============================================================================
+
+enum class CpuLevel {
+    Scalar,
+    Baseline,
+    AVX2,
+    AVX512,
+    Count
+};
+
+constexpr int CPU_LEVEL_COUNT = static_cast<int>(CpuLevel::Count);
+
+// Span fills for the rasterizer
+struct RasterKernels {
+    // Set count pixels from dest to color
+    void (*fillPixels)(uint32_t* dest, int count, uint32_t color);
+};
+
+// Landscape altitude synthesis
+struct LandscapeKernels {
+    // Raw altitudes of count corners one tile apart along x from (x, z), as
+    // getLandscapeAltitudeRow() gives them
+    void (*altitudeRow)(int32_t x, int32_t z, int count, int32_t* altitudes);
+};
+
+// Audio mixing
+struct AudioKernels {
+    // dest[i] += src[i] * volume (truncated), clamped to 16 bits
+    void (*mixScaled)(int16_t* dest, const int16_t* src, int count, float volume);
+};
+
+// The kernels of one CPU level
+struct CpuKernels {
+    const char* name;        // Level name, as --cpu-level takes it
+    bool targeted;           // Built with the level's instruction set
+    RasterKernels raster;
+    LandscapeKernels landscape;
+    AudioKernels audio;
+};
+
+namespace CpuDispatch {
+    // Kernels in use (the baseline ones until select() is called)
+    extern const CpuKernels* kernels;
+    extern CpuLevel level;
+
+    // Highest level this CPU and build support (detected once)
+    CpuLevel detect();
+
+    // Bind the kernels of a level, or of the best one below it the CPU can
+    // run; returns the level bound
+    CpuLevel select(CpuLevel requested);
+
+    // Kernel table of a level, whether or not it can run here (for tests)
+    const CpuKernels& getKernels(CpuLevel level);
+
+    // Name of a level, and the level with a name (false if there is none)
+    const char* getLevelName(CpuLevel level);
+    bool findLevel(const char* name, CpuLevel& level);
+}
+
+#endif // LANDER_CPU_DISPATCH_H
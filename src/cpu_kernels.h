@@ -0,0 +1,263 @@
+// cpu_kernels.h
+// Hot kernels, compiled once per CPU level (see cpu_dispatch.h)
+
+#ifndef LANDER_CPU_KERNELS_H
+#define LANDER_CPU_KERNELS_H
+
+// =============================================================================
+// CPU Level Kernels
+// =============================================================================
+//
+// Included only by the cpu_kernels_<level>.cpp files, each built with its
+// level's instruction set flags. Each sets, before including this:
+//
+//   LANDER_SIMD_NAMESPACE    Namespace for its copy of the fixed_simd.h types
+//   LANDER_KERNEL_TABLE      Name of the CpuKernels table it defines
+//   LANDER_KERNEL_NAME       Level name
+//   LANDER_KERNEL_TARGETED   true if built with the level's instruction set
+//
+// The kernels only use raw values, the fixed_simd.h types and intrinsics.
+// Calling any other inline function (Fixed's operators, std::min) from here
+// could leave a copy of it built with this unit's instructions for the
+// linker to pick for the rest of the game too.
+//
+// Every level gives exactly the results of the scalar one.
+//
+// =============================================================================
+
+#include "cpu_dispatch.h"
+#include "fixed_simd.h"
+#include "lookup_tables.h"
+
+// AVX-512 units also get the AVX2 fixed-point backend, plus 512-bit fills
+#if defined(LANDER_SIMD_AVX2) && defined(__AVX512F__)
+#define LANDER_KERNEL_AVX512 1
+#endif
+
+namespace {
+
+// =============================================================================
+// Raster
+// =============================================================================
+
+void fillPixels(uint32_t* dest, int count, uint32_t color) {
+    int i = 0;
+#if defined(LANDER_KERNEL_AVX512)
+    const __m512i wide = _mm512_set1_epi32(static_cast<int>(color));
+    for (; i + 16 <= count; i += 16) {
+        _mm512_storeu_si512(dest + i, wide);
+    }
+    if (i < count) {
+        _mm512_mask_storeu_epi32(dest + i, static_cast<__mmask16>((1u << (count - i)) - 1), wide);
+    }
+    return;
+#elif defined(LANDER_SIMD_AVX2)
+    const __m256i wide = _mm256_set1_epi32(static_cast<int>(color));
+    for (; i + 8 <= count; i += 8) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i), wide);
+    }
+#elif defined(LANDER_SIMD_SSE2)
+    const __m128i wide = _mm_set1_epi32(static_cast<int>(color));
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i), wide);
+    }
+#elif defined(LANDER_SIMD_NEON)
+    const uint32x4_t wide = vdupq_n_u32(color);
+    for (; i + 4 <= count; i += 4) {
+        vst1q_u32(dest + i, wide);
+    }
+#endif
+    for (; i < count; i++) {
+        dest[i] = color;
+    }
+}
+
+// =============================================================================
+// Landscape
+// =============================================================================
+//
+// The renderer asks for a whole row of corners at a time, so the six angles,
+// the sea level clamp and the launchpad test are done a pack of corners at a
+// time. With AVX2 the sine lookups are gathers and the sum stays in the
+// lanes: each term is split into its value >> 8 and its low 8 bits, and
+//
+//   (sum of w * s) >> 8  =  sum of w * (s >> 8)  +  (sum of w * (s & 255)) >> 8
+//
+// exactly, with both sums fitting in 32 bits. Otherwise the lookups are one
+// per corner, and so is the 64-bit sum.
+//
+// =============================================================================
+
+void altitudeRow(int32_t x, int32_t z, int count, int32_t* altitudes) {
+    constexpr int LANES = FixedPack::LANES;
+    constexpr int32_t TILE = GameConstants::TILE_SIZE.raw;
+    constexpr int32_t PAD_SIZE = GameConstants::LAUNCHPAD_SIZE.raw;
+
+    int32_t lanes[LANES];
+    for (int i = 0; i < LANES; i++) {
+        lanes[i] = static_cast<int32_t>(static_cast<uint32_t>(i) * static_cast<uint32_t>(TILE));
+    }
+    const FixedPack laneOffsets = FixedPack::load(lanes);
+    const FixedPack packStep = FixedPack::splat(LANES * TILE);
+
+    // Every angle is a small multiple of x plus one of z
+    auto times = [](FixedPack value, int32_t factor) {
+        return FixedPack::mulInt(value, FixedPack::splat(factor));
+    };
+
+    const FixedPack zr = FixedPack::splat(z);
+    const FixedPack zero = FixedPack::splat(0);
+    const FixedPack padEdge = FixedPack::splat(PAD_SIZE - 1);
+    const bool zOffPad = (z < 0 || z >= PAD_SIZE);
+
+    static const int32_t WEIGHTS[6] = {2, 2, 2, 2, 1, 1};
+
+    FixedPack xr = FixedPack::splat(x) + laneOffsets;
+    for (int first = 0; first < count; first += LANES, xr = xr + packStep) {
+        FixedPack angles[6] = {
+            (xr - times(zr, 2)) >> 22,
+            (times(xr, 4) + times(zr, 3)) >> 22,
+            (times(zr, 3) - times(xr, 5)) >> 22,
+            (times(xr, 3) + times(zr, 3)) >> 22,
+            (times(xr, 5) + times(zr, 11)) >> 22,
+            (times(xr, 10) + times(zr, 7)) >> 22,
+        };
+
+#if defined(LANDER_SIMD_AVX2)
+        const FixedPack indexMask = FixedPack::splat(SIN_TABLE_SIZE - 1);
+        const FixedPack lowMask = FixedPack::splat(0xFF);
+        FixedPack high = zero;
+        FixedPack low = zero;
+        for (int term = 0; term < 6; term++) {
+            FixedPack sine = FixedPack::make(_mm256_i32gather_epi32(
+                reinterpret_cast<const int*>(sinTable), (angles[term] & indexMask).v, 4));
+            FixedPack weight = FixedPack::splat(WEIGHTS[term]);
+            high = high + FixedPack::mulInt(sine >> 8, weight);
+            low = low + FixedPack::mulInt(sine & lowMask, weight);
+        }
+        FixedPack offset = high + (low >> 8);
+#else
+        int32_t indices[6][LANES];
+        for (int term = 0; term < 6; term++) {
+            angles[term].store(indices[term]);
+        }
+        int32_t offsets[LANES];
+        for (int i = 0; i < LANES; i++) {
+            int64_t sum = 0;
+            for (int term = 0; term < 6; term++) {
+                sum += static_cast<int64_t>(WEIGHTS[term]) * sinTable[indices[term][i] & (SIN_TABLE_SIZE - 1)];
+            }
+            offsets[i] = static_cast<int32_t>(sum >> 8);
+        }
+        FixedPack offset = FixedPack::load(offsets);
+#endif
+
+        FixedPack altitude = FixedPack::splat(GameConstants::LAND_MID_HEIGHT.raw) - offset;
+        altitude = FixedPack::min(altitude, FixedPack::splat(GameConstants::SEA_LEVEL.raw));
+
+        // Corners on the launchpad are flat
+        if (!zOffPad) {
+            FixedPack offPad = FixedPack::cmpGt(xr, padEdge) | FixedPack::cmpGt(zero, xr);
+            altitude = FixedPack::select(offPad, altitude,
+                                         FixedPack::splat(GameConstants::LAUNCHPAD_ALTITUDE.raw));
+        }
+
+        int lanesUsed = (count - first < LANES) ? count - first : LANES;
+        if (lanesUsed == LANES) {
+            altitude.store(altitudes + first);
+        } else {
+            int32_t results[LANES];
+            altitude.store(results);
+            for (int i = 0; i < lanesUsed; i++) {
+                altitudes[first + i] = results[i];
+            }
+        }
+    }
+}
+
+// =============================================================================
+// Audio
+// =============================================================================
+//
+// Samples are widened to 32 bits, converted to float, scaled and truncated
+// as the scalar code does, and narrowed back with saturation, which is the
+// scalar clamp. volume is a gain of a few at most, so products never leave
+// the 32-bit range where truncation is defined.
+//
+// =============================================================================
+
+void mixScaled(int16_t* dest, const int16_t* src, int count, float volume) {
+    int i = 0;
+#if defined(LANDER_KERNEL_AVX512)
+    // The zero-masked forms with every lane set are the plain conversions;
+    // GCC 12 warns about the plain ones' undefined pass-through values
+    const __m512 scale = _mm512_set1_ps(volume);
+    const __mmask16 all = 0xFFFF;
+    for (; i + 16 <= count; i += 16) {
+        __m512i s = _mm512_maskz_cvtepi16_epi32(all, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)));
+        __m512i d = _mm512_maskz_cvtepi16_epi32(all, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dest + i)));
+        __m512 scaled = _mm512_mul_ps(_mm512_maskz_cvtepi32_ps(all, s), scale);
+        __m512i sum = _mm512_add_epi32(d, _mm512_maskz_cvttps_epi32(all, scaled));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i), _mm512_maskz_cvtsepi32_epi16(all, sum));
+    }
+#elif defined(LANDER_SIMD_AVX2)
+    const __m256 scale = _mm256_set1_ps(volume);
+    for (; i + 16 <= count; i += 16) {
+        __m256i sLow = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)));
+        __m256i sHigh = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 8)));
+        __m256i dLow = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(dest + i)));
+        __m256i dHigh = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(dest + i + 8)));
+        __m256i low = _mm256_add_epi32(dLow, _mm256_cvttps_epi32(_mm256_mul_ps(_mm256_cvtepi32_ps(sLow), scale)));
+        __m256i high = _mm256_add_epi32(dHigh, _mm256_cvttps_epi32(_mm256_mul_ps(_mm256_cvtepi32_ps(sHigh), scale)));
+
+        // The pack works within 128-bit halves; put the quarters back in order
+        __m256i packed = _mm256_packs_epi32(low, high);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i), _mm256_permute4x64_epi64(packed, 0xD8));
+    }
+#elif defined(LANDER_SIMD_SSE2)
+    const __m128 scale = _mm_set1_ps(volume);
+    for (; i + 8 <= count; i += 8) {
+        __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dest + i));
+
+        // Sign-extend by placing each sample in the top half of a lane
+        __m128i sLow = _mm_srai_epi32(_mm_unpacklo_epi16(s, s), 16);
+        __m128i sHigh = _mm_srai_epi32(_mm_unpackhi_epi16(s, s), 16);
+        __m128i dLow = _mm_srai_epi32(_mm_unpacklo_epi16(d, d), 16);
+        __m128i dHigh = _mm_srai_epi32(_mm_unpackhi_epi16(d, d), 16);
+        __m128i low = _mm_add_epi32(dLow, _mm_cvttps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(sLow), scale)));
+        __m128i high = _mm_add_epi32(dHigh, _mm_cvttps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(sHigh), scale)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i), _mm_packs_epi32(low, high));
+    }
+#elif defined(LANDER_SIMD_NEON)
+    const float32x4_t scale = vdupq_n_f32(volume);
+    for (; i + 8 <= count; i += 8) {
+        int16x8_t s = vld1q_s16(src + i);
+        int16x8_t d = vld1q_s16(dest + i);
+        int32x4_t low = vaddq_s32(vmovl_s16(vget_low_s16(d)),
+                                  vcvtq_s32_f32(vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(s))), scale)));
+        int32x4_t high = vaddq_s32(vmovl_high_s16(d),
+                                   vcvtq_s32_f32(vmulq_f32(vcvtq_f32_s32(vmovl_high_s16(s)), scale)));
+        vst1q_s16(dest + i, vcombine_s16(vqmovn_s32(low), vqmovn_s32(high)));
+    }
+#endif
+    for (; i < count; i++) {
+        int32_t sample = dest[i] + static_cast<int32_t>(src[i] * volume);
+        if (sample > 32767) sample = 32767;
+        if (sample < -32768) sample = -32768;
+        dest[i] = static_cast<int16_t>(sample);
+    }
+}
+
+} // namespace
+
+extern const CpuKernels LANDER_KERNEL_TABLE;
+const CpuKernels LANDER_KERNEL_TABLE = {
+    LANDER_KERNEL_NAME,
+    LANDER_KERNEL_TARGETED,
+    {fillPixels},
+    {altitudeRow},
+    {mixScaled},
+};
+
+#endif // LANDER_CPU_KERNELS_H
@@ -0,0 +1,13 @@
+// cpu_kernels_avx2.cpp
+// Kernels for AVX2 (built with AVX2 enabled on x86, see CMakeLists.txt)
+
+#define LANDER_SIMD_NAMESPACE simd_avx2
+#define LANDER_KERNEL_TABLE CPU_KERNELS_AVX2
+#define LANDER_KERNEL_NAME "avx2"
+#if defined(__AVX2__)
+#define LANDER_KERNEL_TARGETED true
+#else
+#define LANDER_KERNEL_TARGETED false
+#endif
+
+#include "cpu_kernels.h"
@@ -0,0 +1,13 @@
+// cpu_kernels_avx512.cpp
+// Kernels for AVX-512F (built with AVX-512F enabled on x86, see CMakeLists.txt)
+
+#define LANDER_SIMD_NAMESPACE simd_avx512
+#define LANDER_KERNEL_TABLE CPU_KERNELS_AVX512
+#define LANDER_KERNEL_NAME "avx512"
+#if defined(__AVX512F__)
+#define LANDER_KERNEL_TARGETED true
+#else
+#define LANDER_KERNEL_TARGETED false
+#endif
+
+#include "cpu_kernels.h"
@@ -0,0 +1,8 @@
+// cpu_kernels_baseline.cpp
+// Kernels for the compiler's baseline instruction set (SSE2 or NEON)
+
+#define LANDER_KERNEL_TABLE CPU_KERNELS_BASELINE
+#define LANDER_KERNEL_NAME FixedSimd::backendName()
+#define LANDER_KERNEL_TARGETED true
+
+#include "cpu_kernels.h"
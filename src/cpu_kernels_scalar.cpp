@@ -0,0 +1,10 @@
+// cpu_kernels_scalar.cpp
+// Kernels with plain loops, the reference for the other CPU levels
+
+#define LANDER_SIMD_SCALAR 1
+#define LANDER_SIMD_NAMESPACE simd_scalar
+#define LANDER_KERNEL_TABLE CPU_KERNELS_SCALAR
+#define LANDER_KERNEL_NAME "scalar"
+#define LANDER_KERNEL_TARGETED true
+
+#include "cpu_kernels.h"
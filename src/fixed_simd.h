@@ -0,0 +1,421 @@
+#ifndef LANDER_FIXED_SIMD_H
+#define LANDER_FIXED_SIMD_H
+
+#include <cstdint>
+#include <cstring>
+#include "fixed.h"
+
+// =============================================================================
+// Packed Fixed-Point Values
+// =============================================================================
+//
+// FixedX4 and FixedX8 hold 4 and 8 raw 8.24 values and give the batch kernels
+// (vertex transforms, altitude synthesis, projection) one set of lane-wise
+// operations instead of each kernel using intrinsics of its own.
+//
+// Every operation gives exactly the result of the scalar code, lane by lane:
+//
+//   a + b, a - b      Fixed::operator+ / operator- (wrapping)
+//   a * b             Fixed::operator*: 64-bit product >> 24, truncated
+//   mulInt(a, b)      raw * raw, low 32 bits (integer multiply)
+//   a >> n            arithmetic shift of the raw value
+//   divShifted(a,b,n) static_cast<int32_t>((int64_t(a) << n) / b), n <= 21
+//
+// Comparisons return a mask (all bits set in lanes where they hold) for
+// select(), which picks lanes from its first or second value.
+//
+// The backend is chosen at compile time: AVX2 when the compiler targets it
+// (FixedX8 in one register), SSE2 on any x86-64, NEON on AArch64, otherwise
+// plain loops. FixedPack is the widest type the backend handles natively.
+// The kernels in cpu_kernels.h are compiled once per CPU level with that
+// level's instruction set flags, so there these types take the wider
+// backends, and the level is picked at startup (cpu_dispatch.h).
+//
+// divShifted() divides in double precision, which is exact here: the
+// numerator has at most 52 significant bits, so the rounding error is at
+// most half of 1 / |b|, the closest a quotient can be to an integer without
+// being one, and truncation never lands on the wrong side. Lanes whose
+// quotient doesn't fit in 32 bits are redone with the integer division. No
+// divisor lane may be zero (as for the scalar division).
+//
+// =============================================================================
+
+#if defined(LANDER_SIMD_SCALAR)
+    // Forced plain loops (for comparing backends)
+#elif defined(__AVX2__)
+    #define LANDER_SIMD_AVX2 1
+    #define LANDER_SIMD_SSE2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define LANDER_SIMD_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    #define LANDER_SIMD_NEON 1
+#endif
+
+#if defined(LANDER_SIMD_AVX2)
+#include <immintrin.h>
+#elif defined(LANDER_SIMD_SSE2)
+#include <emmintrin.h>
+#elif defined(LANDER_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
+// Everything below is inline, so a translation unit built for a wider
+// instruction set (the kernel levels in cpu_dispatch.h) would otherwise share
+// its out-of-line copies with the baseline code. Each such unit names its own
+// namespace; the linker keeps the copies apart.
+#if !defined(LANDER_SIMD_NAMESPACE)
+#define LANDER_SIMD_NAMESPACE simd_baseline
+#endif
+
+inline namespace LANDER_SIMD_NAMESPACE {
+
+namespace FixedSimd {
+    // Name of the compiled-in backend ("avx2", "sse2", "neon" or "scalar")
+    constexpr const char* backendName() {
+#if defined(LANDER_SIMD_AVX2)
+        return "avx2";
+#elif defined(LANDER_SIMD_SSE2)
+        return "sse2";
+#elif defined(LANDER_SIMD_NEON)
+        return "neon";
+#else
+        return "scalar";
+#endif
+    }
+
+    // Scalar definition of divShifted(), also used for lanes that overflow
+    inline int32_t divShifted(int32_t a, int32_t b, int shift) {
+        return static_cast<int32_t>((static_cast<int64_t>(a) * (int64_t(1) << shift)) / b);
+    }
+}
+
+// =============================================================================
+// FixedX4 - 4 lanes
+// =============================================================================
+
+struct FixedX4 {
+    static constexpr int LANES = 4;
+
+#if defined(LANDER_SIMD_SSE2)
+    __m128i v;
+
+    static FixedX4 make(__m128i value) { FixedX4 r; r.v = value; return r; }
+
+    static FixedX4 load(const int32_t* p) { return make(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))); }
+    void store(int32_t* p) const { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+    static FixedX4 splat(int32_t value) { return make(_mm_set1_epi32(value)); }
+    static FixedX4 set(int32_t a, int32_t b, int32_t c, int32_t d) { return make(_mm_setr_epi32(a, b, c, d)); }
+
+    FixedX4 operator+(FixedX4 o) const { return make(_mm_add_epi32(v, o.v)); }
+    FixedX4 operator-(FixedX4 o) const { return make(_mm_sub_epi32(v, o.v)); }
+    FixedX4 operator&(FixedX4 o) const { return make(_mm_and_si128(v, o.v)); }
+    FixedX4 operator|(FixedX4 o) const { return make(_mm_or_si128(v, o.v)); }
+    FixedX4 operator>>(int shift) const { return make(_mm_srai_epi32(v, shift)); }
+    FixedX4 operator<<(int shift) const { return make(_mm_slli_epi32(v, shift)); }
+
+    FixedX4 operator*(FixedX4 o) const {
+        // SSE2 only multiplies unsigned lanes 0 and 2 into 64 bits; lanes 1
+        // and 3 are shifted down to do the same
+        __m128i evenProduct = _mm_mul_epu32(v, o.v);
+        __m128i oddProduct = _mm_mul_epu32(_mm_srli_epi64(v, 32), _mm_srli_epi64(o.v, 32));
+
+        // Bits 24-55 of each product, back in their lanes
+        __m128i even = _mm_and_si128(_mm_srli_epi64(evenProduct, 24), _mm_setr_epi32(-1, 0, -1, 0));
+        __m128i odd = _mm_and_si128(_mm_slli_epi64(oddProduct, 8), _mm_setr_epi32(0, -1, 0, -1));
+        __m128i result = _mm_or_si128(even, odd);
+
+        // The signed product is the unsigned one less 2^32 times each
+        // operand that the other's sign bit stands for
+        __m128i correction = _mm_add_epi32(_mm_and_si128(_mm_srai_epi32(v, 31), o.v),
+                                           _mm_and_si128(_mm_srai_epi32(o.v, 31), v));
+        return make(_mm_sub_epi32(result, _mm_slli_epi32(correction, 8)));
+    }
+
+    static FixedX4 mulInt(FixedX4 a, FixedX4 b) {
+        __m128i even = _mm_mul_epu32(a.v, b.v);
+        __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a.v, 32), _mm_srli_epi64(b.v, 32));
+        return make(_mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                                       _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0))));
+    }
+
+    static FixedX4 cmpGt(FixedX4 a, FixedX4 b) { return make(_mm_cmpgt_epi32(a.v, b.v)); }
+    static FixedX4 cmpEq(FixedX4 a, FixedX4 b) { return make(_mm_cmpeq_epi32(a.v, b.v)); }
+    static FixedX4 select(FixedX4 mask, FixedX4 a, FixedX4 b) {
+        return make(_mm_or_si128(_mm_and_si128(mask.v, a.v), _mm_andnot_si128(mask.v, b.v)));
+    }
+
+    static FixedX4 divShifted(FixedX4 a, FixedX4 b, int shift) {
+        const __m128d scale = _mm_set1_pd(static_cast<double>(int64_t(1) << shift));
+        __m128i aHigh = _mm_shuffle_epi32(a.v, _MM_SHUFFLE(1, 0, 3, 2));
+        __m128i bHigh = _mm_shuffle_epi32(b.v, _MM_SHUFFLE(1, 0, 3, 2));
+        __m128d low = _mm_div_pd(_mm_mul_pd(_mm_cvtepi32_pd(a.v), scale), _mm_cvtepi32_pd(b.v));
+        __m128d high = _mm_div_pd(_mm_mul_pd(_mm_cvtepi32_pd(aHigh), scale), _mm_cvtepi32_pd(bHigh));
+        FixedX4 result = make(_mm_unpacklo_epi64(_mm_cvttpd_epi32(low), _mm_cvttpd_epi32(high)));
+
+        // Out-of-range quotients convert to INT32_MIN
+        FixedX4 overflow = cmpEq(result, splat(INT32_MIN));
+        if (_mm_movemask_epi8(overflow.v) != 0) {
+            fixOverflow(result, a, b, shift);
+        }
+        return result;
+    }
+
+#elif defined(LANDER_SIMD_NEON)
+    int32x4_t v;
+
+    static FixedX4 make(int32x4_t value) { FixedX4 r; r.v = value; return r; }
+
+    static FixedX4 load(const int32_t* p) { return make(vld1q_s32(p)); }
+    void store(int32_t* p) const { vst1q_s32(p, v); }
+    static FixedX4 splat(int32_t value) { return make(vdupq_n_s32(value)); }
+    static FixedX4 set(int32_t a, int32_t b, int32_t c, int32_t d) {
+        const int32_t lanes[4] = {a, b, c, d};
+        return load(lanes);
+    }
+
+    FixedX4 operator+(FixedX4 o) const { return make(vaddq_s32(v, o.v)); }
+    FixedX4 operator-(FixedX4 o) const { return make(vsubq_s32(v, o.v)); }
+    FixedX4 operator&(FixedX4 o) const { return make(vandq_s32(v, o.v)); }
+    FixedX4 operator|(FixedX4 o) const { return make(vorrq_s32(v, o.v)); }
+    FixedX4 operator>>(int shift) const { return make(vshlq_s32(v, vdupq_n_s32(-shift))); }
+    FixedX4 operator<<(int shift) const { return make(vshlq_s32(v, vdupq_n_s32(shift))); }
+
+    FixedX4 operator*(FixedX4 o) const {
+        // Signed 64-bit products, narrowed to bits 24-55
+        int64x2_t low = vmull_s32(vget_low_s32(v), vget_low_s32(o.v));
+        int64x2_t high = vmull_high_s32(v, o.v);
+        return make(vcombine_s32(vshrn_n_s64(low, 24), vshrn_n_s64(high, 24)));
+    }
+
+    static FixedX4 mulInt(FixedX4 a, FixedX4 b) { return make(vmulq_s32(a.v, b.v)); }
+
+    static FixedX4 cmpGt(FixedX4 a, FixedX4 b) { return make(vreinterpretq_s32_u32(vcgtq_s32(a.v, b.v))); }
+    static FixedX4 cmpEq(FixedX4 a, FixedX4 b) { return make(vreinterpretq_s32_u32(vceqq_s32(a.v, b.v))); }
+    static FixedX4 select(FixedX4 mask, FixedX4 a, FixedX4 b) {
+        return make(vbslq_s32(vreinterpretq_u32_s32(mask.v), a.v, b.v));
+    }
+
+    static FixedX4 divShifted(FixedX4 a, FixedX4 b, int shift) {
+        // Quotients below 2^53 convert to 64 bits exactly, and narrowing
+        // keeps the low 32 bits as the scalar cast does
+        const float64x2_t scale = vdupq_n_f64(static_cast<double>(int64_t(1) << shift));
+        float64x2_t aLow = vmulq_f64(vcvtq_f64_s64(vmovl_s32(vget_low_s32(a.v))), scale);
+        float64x2_t aHigh = vmulq_f64(vcvtq_f64_s64(vmovl_high_s32(a.v)), scale);
+        float64x2_t low = vdivq_f64(aLow, vcvtq_f64_s64(vmovl_s32(vget_low_s32(b.v))));
+        float64x2_t high = vdivq_f64(aHigh, vcvtq_f64_s64(vmovl_high_s32(b.v)));
+        return make(vcombine_s32(vmovn_s64(vcvtq_s64_f64(low)), vmovn_s64(vcvtq_s64_f64(high))));
+    }
+
+#else
+    int32_t v[4];
+
+    static FixedX4 load(const int32_t* p) { FixedX4 r; std::memcpy(r.v, p, sizeof(r.v)); return r; }
+    void store(int32_t* p) const { std::memcpy(p, v, sizeof(v)); }
+    static FixedX4 splat(int32_t value) { return set(value, value, value, value); }
+    static FixedX4 set(int32_t a, int32_t b, int32_t c, int32_t d) {
+        FixedX4 r;
+        r.v[0] = a; r.v[1] = b; r.v[2] = c; r.v[3] = d;
+        return r;
+    }
+
+    template <typename Op>
+    static FixedX4 map(FixedX4 a, FixedX4 b, Op op) {
+        FixedX4 r;
+        for (int i = 0; i < 4; i++) r.v[i] = op(a.v[i], b.v[i]);
+        return r;
+    }
+
+    FixedX4 operator+(FixedX4 o) const {
+        return map(*this, o, [](int32_t x, int32_t y) { return (Fixed::fromRaw(x) + Fixed::fromRaw(y)).raw; });
+    }
+    FixedX4 operator-(FixedX4 o) const {
+        return map(*this, o, [](int32_t x, int32_t y) { return (Fixed::fromRaw(x) - Fixed::fromRaw(y)).raw; });
+    }
+    FixedX4 operator&(FixedX4 o) const {
+        return map(*this, o, [](int32_t x, int32_t y) { return x & y; });
+    }
+    FixedX4 operator|(FixedX4 o) const {
+        return map(*this, o, [](int32_t x, int32_t y) { return x | y; });
+    }
+    FixedX4 operator>>(int shift) const {
+        FixedX4 r;
+        for (int i = 0; i < 4; i++) r.v[i] = v[i] >> shift;
+        return r;
+    }
+    FixedX4 operator<<(int shift) const {
+        FixedX4 r;
+        for (int i = 0; i < 4; i++) r.v[i] = static_cast<int32_t>(static_cast<uint32_t>(v[i]) << shift);
+        return r;
+    }
+    FixedX4 operator*(FixedX4 o) const {
+        return map(*this, o, [](int32_t x, int32_t y) { return (Fixed::fromRaw(x) * Fixed::fromRaw(y)).raw; });
+    }
+
+    static FixedX4 mulInt(FixedX4 a, FixedX4 b) {
+        return map(a, b, [](int32_t x, int32_t y) {
+            return static_cast<int32_t>(static_cast<uint32_t>(x) * static_cast<uint32_t>(y));
+        });
+    }
+
+    static FixedX4 cmpGt(FixedX4 a, FixedX4 b) {
+        return map(a, b, [](int32_t x, int32_t y) { return x > y ? -1 : 0; });
+    }
+    static FixedX4 cmpEq(FixedX4 a, FixedX4 b) {
+        return map(a, b, [](int32_t x, int32_t y) { return x == y ? -1 : 0; });
+    }
+    static FixedX4 select(FixedX4 mask, FixedX4 a, FixedX4 b) {
+        FixedX4 r;
+        for (int i = 0; i < 4; i++) r.v[i] = mask.v[i] ? a.v[i] : b.v[i];
+        return r;
+    }
+
+    static FixedX4 divShifted(FixedX4 a, FixedX4 b, int shift) {
+        FixedX4 r;
+        for (int i = 0; i < 4; i++) r.v[i] = FixedSimd::divShifted(a.v[i], b.v[i], shift);
+        return r;
+    }
+#endif
+
+    // Lane-wise minimum and maximum
+    static FixedX4 min(FixedX4 a, FixedX4 b) { return select(cmpGt(a, b), b, a); }
+    static FixedX4 max(FixedX4 a, FixedX4 b) { return select(cmpGt(a, b), a, b); }
+
+    // Read one lane (slow; for tests and tails)
+    int32_t lane(int i) const {
+        int32_t lanes[4];
+        store(lanes);
+        return lanes[i];
+    }
+
+private:
+    static void fixOverflow(FixedX4& result, FixedX4 a, FixedX4 b, int shift) {
+        int32_t r[4], x[4], y[4];
+        result.store(r);
+        a.store(x);
+        b.store(y);
+        for (int i = 0; i < 4; i++) {
+            if (r[i] == INT32_MIN) r[i] = FixedSimd::divShifted(x[i], y[i], shift);
+        }
+        result = load(r);
+    }
+};
+
+// =============================================================================
+// FixedX8 - 8 lanes (one AVX2 register, otherwise two FixedX4)
+// =============================================================================
+
+struct FixedX8 {
+    static constexpr int LANES = 8;
+
+#if defined(LANDER_SIMD_AVX2)
+    __m256i v;
+
+    static FixedX8 make(__m256i value) { FixedX8 r; r.v = value; return r; }
+
+    static FixedX8 load(const int32_t* p) { return make(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p))); }
+    void store(int32_t* p) const { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+    static FixedX8 splat(int32_t value) { return make(_mm256_set1_epi32(value)); }
+
+    FixedX8 operator+(FixedX8 o) const { return make(_mm256_add_epi32(v, o.v)); }
+    FixedX8 operator-(FixedX8 o) const { return make(_mm256_sub_epi32(v, o.v)); }
+    FixedX8 operator&(FixedX8 o) const { return make(_mm256_and_si256(v, o.v)); }
+    FixedX8 operator|(FixedX8 o) const { return make(_mm256_or_si256(v, o.v)); }
+    FixedX8 operator>>(int shift) const { return make(_mm256_srai_epi32(v, shift)); }
+    FixedX8 operator<<(int shift) const { return make(_mm256_slli_epi32(v, shift)); }
+
+    FixedX8 operator*(FixedX8 o) const {
+        // Signed 64-bit products of the even lanes, then of the odd lanes
+        __m256i evenProduct = _mm256_mul_epi32(v, o.v);
+        __m256i oddProduct = _mm256_mul_epi32(_mm256_srli_epi64(v, 32), _mm256_srli_epi64(o.v, 32));
+        return make(_mm256_blend_epi32(_mm256_srli_epi64(evenProduct, 24),
+                                       _mm256_slli_epi64(oddProduct, 8), 0xAA));
+    }
+
+    static FixedX8 mulInt(FixedX8 a, FixedX8 b) { return make(_mm256_mullo_epi32(a.v, b.v)); }
+
+    static FixedX8 cmpGt(FixedX8 a, FixedX8 b) { return make(_mm256_cmpgt_epi32(a.v, b.v)); }
+    static FixedX8 cmpEq(FixedX8 a, FixedX8 b) { return make(_mm256_cmpeq_epi32(a.v, b.v)); }
+    static FixedX8 select(FixedX8 mask, FixedX8 a, FixedX8 b) {
+        return make(_mm256_blendv_epi8(b.v, a.v, mask.v));
+    }
+    static FixedX8 min(FixedX8 a, FixedX8 b) { return make(_mm256_min_epi32(a.v, b.v)); }
+    static FixedX8 max(FixedX8 a, FixedX8 b) { return make(_mm256_max_epi32(a.v, b.v)); }
+
+    static FixedX8 divShifted(FixedX8 a, FixedX8 b, int shift) {
+        const __m256d scale = _mm256_set1_pd(static_cast<double>(int64_t(1) << shift));
+        __m256d low = _mm256_div_pd(_mm256_mul_pd(_mm256_cvtepi32_pd(_mm256_castsi256_si128(a.v)), scale),
+                                    _mm256_cvtepi32_pd(_mm256_castsi256_si128(b.v)));
+        __m256d high = _mm256_div_pd(_mm256_mul_pd(_mm256_cvtepi32_pd(_mm256_extracti128_si256(a.v, 1)), scale),
+                                     _mm256_cvtepi32_pd(_mm256_extracti128_si256(b.v, 1)));
+        FixedX8 result = make(_mm256_set_m128i(_mm256_cvttpd_epi32(high), _mm256_cvttpd_epi32(low)));
+
+        // Out-of-range quotients convert to INT32_MIN
+        FixedX8 overflow = cmpEq(result, splat(INT32_MIN));
+        if (_mm256_movemask_epi8(overflow.v) != 0) {
+            int32_t r[8], x[8], y[8];
+            result.store(r);
+            a.store(x);
+            b.store(y);
+            for (int i = 0; i < 8; i++) {
+                if (r[i] == INT32_MIN) r[i] = FixedSimd::divShifted(x[i], y[i], shift);
+            }
+            result = load(r);
+        }
+        return result;
+    }
+
+#else
+    FixedX4 lo, hi;
+
+    static FixedX8 make(FixedX4 low, FixedX4 high) { FixedX8 r; r.lo = low; r.hi = high; return r; }
+
+    static FixedX8 load(const int32_t* p) { return make(FixedX4::load(p), FixedX4::load(p + 4)); }
+    void store(int32_t* p) const { lo.store(p); hi.store(p + 4); }
+    static FixedX8 splat(int32_t value) { return make(FixedX4::splat(value), FixedX4::splat(value)); }
+
+    FixedX8 operator+(FixedX8 o) const { return make(lo + o.lo, hi + o.hi); }
+    FixedX8 operator-(FixedX8 o) const { return make(lo - o.lo, hi - o.hi); }
+    FixedX8 operator&(FixedX8 o) const { return make(lo & o.lo, hi & o.hi); }
+    FixedX8 operator|(FixedX8 o) const { return make(lo | o.lo, hi | o.hi); }
+    FixedX8 operator>>(int shift) const { return make(lo >> shift, hi >> shift); }
+    FixedX8 operator<<(int shift) const { return make(lo << shift, hi << shift); }
+    FixedX8 operator*(FixedX8 o) const { return make(lo * o.lo, hi * o.hi); }
+
+    static FixedX8 mulInt(FixedX8 a, FixedX8 b) {
+        return make(FixedX4::mulInt(a.lo, b.lo), FixedX4::mulInt(a.hi, b.hi));
+    }
+    static FixedX8 cmpGt(FixedX8 a, FixedX8 b) {
+        return make(FixedX4::cmpGt(a.lo, b.lo), FixedX4::cmpGt(a.hi, b.hi));
+    }
+    static FixedX8 cmpEq(FixedX8 a, FixedX8 b) {
+        return make(FixedX4::cmpEq(a.lo, b.lo), FixedX4::cmpEq(a.hi, b.hi));
+    }
+    static FixedX8 select(FixedX8 mask, FixedX8 a, FixedX8 b) {
+        return make(FixedX4::select(mask.lo, a.lo, b.lo), FixedX4::select(mask.hi, a.hi, b.hi));
+    }
+    static FixedX8 min(FixedX8 a, FixedX8 b) { return make(FixedX4::min(a.lo, b.lo), FixedX4::min(a.hi, b.hi)); }
+    static FixedX8 max(FixedX8 a, FixedX8 b) { return make(FixedX4::max(a.lo, b.lo), FixedX4::max(a.hi, b.hi)); }
+
+    static FixedX8 divShifted(FixedX8 a, FixedX8 b, int shift) {
+        return make(FixedX4::divShifted(a.lo, b.lo, shift), FixedX4::divShifted(a.hi, b.hi, shift));
+    }
+#endif
+
+    // Read one lane (slow; for tests and tails)
+    int32_t lane(int i) const {
+        int32_t lanes[8];
+        store(lanes);
+        return lanes[i];
+    }
+};
+
+// The widest pack the backend handles in one register
+#if defined(LANDER_SIMD_AVX2)
+using FixedPack = FixedX8;
+#else
+using FixedPack = FixedX4;
+#endif
+
+} // inline namespace LANDER_SIMD_NAMESPACE
+
+#endif // LANDER_FIXED_SIMD_H
@@ -0,0 +1,189 @@
+// flight_recorder.cpp
+// Recent frame history, written out when a frame runs over budget
+
+#include "flight_recorder.h"
+#include "stb_image_write.h"
+#include <cstring>
+
+// =============================================================================
+// FlightRecorder Implementation
+// =============================================================================
+
+FlightRecorder::FlightRecorder()
+{
+    prefix[0] = '\0';
+}
+
+FlightRecorder::~FlightRecorder()
+{
+    close();
+}
+
+bool FlightRecorder::open(const char* path, uint32_t budget, bool screenshots,
+                          std::function<void()> start)
+{
+    close();
+    if (std::strlen(path) + 32 > sizeof(prefix)) {
+        return false;
+    }
+    std::strcpy(prefix, path);
+
+    // Everything a dump needs is allocated here, not when a frame is slow
+    ring.reset(new FlightFrame[HISTORY]);
+    dumpFrames.reset(new FlightFrame[HISTORY]);
+    dumpPixels.reset(screenshots ? new uint8_t[ScreenBuffer::getBufferSize()] : nullptr);
+    ringHead = 0;
+    ringCount = 0;
+    framesSinceDump = HISTORY;
+    budgetMicros = budget;
+
+    stopping = false;
+    dumpQueued = false;
+    threadStart = std::move(start);
+    writer = std::thread(&FlightRecorder::writerLoop, this);
+    return true;
+}
+
+void FlightRecorder::close()
+{
+    if (!writer.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeUp.notify_all();
+    writer.join();
+}
+
+bool FlightRecorder::record(const FlightFrame& frame, const ScreenBuffer* screen)
+{
+    if (!ring) {
+        return false;
+    }
+
+    ring[ringHead] = frame;
+    ringHead = (ringHead + 1) % HISTORY;
+    if (ringCount < HISTORY) ringCount++;
+    framesSinceDump++;
+
+    if (frame.frameMicros <= budgetMicros) {
+        return false;
+    }
+    slowFrames++;
+
+    // Frames soon after a dump were in it; frames while the writer is busy
+    // go in the next one
+    if (framesSinceDump < HISTORY || busy.load(std::memory_order_acquire)) {
+        dumpsSkipped++;
+        return false;
+    }
+
+    // Hand a copy of the history, oldest first, to the writer
+    int oldest = (ringHead - ringCount + HISTORY) % HISTORY;
+    for (int i = 0; i < ringCount; i++) {
+        dumpFrames[i] = ring[(oldest + i) % HISTORY];
+    }
+    dumpCount = ringCount;
+
+    dumpWidth = 0;
+    dumpHeight = 0;
+    if (dumpPixels && screen) {
+        dumpWidth = ScreenBuffer::PHYSICAL_WIDTH();
+        dumpHeight = ScreenBuffer::PHYSICAL_HEIGHT();
+        size_t rowBytes = static_cast<size_t>(dumpWidth) * 4;
+        for (int y = 0; y < dumpHeight; y++) {
+            std::memcpy(dumpPixels.get() + y * rowBytes, screen->getData() + y * ScreenBuffer::getPitch(),
+                        rowBytes);
+        }
+    }
+
+    framesSinceDump = 0;
+    busy.store(true, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        dumpQueued = true;
+    }
+    wakeUp.notify_all();
+    return true;
+}
+
+void FlightRecorder::flush()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    wakeUp.wait(lock, [this] { return !busy.load() || !writer.joinable(); });
+}
+
+void FlightRecorder::writerLoop()
+{
+    if (threadStart) {
+        threadStart();
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        wakeUp.wait(lock, [this] { return dumpQueued || stopping; });
+        if (dumpQueued) {
+            dumpQueued = false;
+            lock.unlock();
+            writeDump();
+            lock.lock();
+            busy.store(false, std::memory_order_release);
+            wakeUp.notify_all();
+            continue;
+        }
+        if (stopping) {
+            return;
+        }
+    }
+}
+
+void FlightRecorder::writeDump()
+{
+    const FlightFrame& slow = dumpFrames[dumpCount - 1];
+    char path[sizeof(prefix) + 32];
+
+    std::snprintf(path, sizeof(path), "%s-%llu.csv", prefix, static_cast<unsigned long long>(slow.frame));
+    FILE* file = std::fopen(path, "w");
+    if (file) {
+        writeFrames(file, dumpFrames.get(), dumpCount, budgetMicros);
+        std::fclose(file);
+    }
+
+    if (dumpWidth > 0) {
+        std::snprintf(path, sizeof(path), "%s-%llu.png", prefix, static_cast<unsigned long long>(slow.frame));
+        stbi_write_png(path, dumpWidth, dumpHeight, 4, dumpPixels.get(), dumpWidth * 4);
+    }
+
+    dumpsWritten++;
+}
+
+void FlightRecorder::writeFrames(FILE* file, const FlightFrame* frames, int count, uint32_t budgetMicros)
+{
+    if (count == 0) {
+        return;
+    }
+
+    const FlightFrame& slow = frames[count - 1];
+    std::fprintf(file, "# frame %llu took %.2f ms (budget %.2f ms)\n",
+                 static_cast<unsigned long long>(slow.frame), slow.frameMicros / 1000.0,
+                 budgetMicros / 1000.0);
+
+    std::fprintf(file, "frame_us,update_us,scene_us,present_us,over_budget,"
+                       "camera_x,camera_y,camera_z,audio_voices,");
+    writeFrameStatsHeader(file);
+
+    for (int i = 0; i < count; i++) {
+        const FlightFrame& frame = frames[i];
+        std::fprintf(file, "%u,%u,%u,%u,%d,%.4f,%.4f,%.4f,%d,",
+                     frame.frameMicros,
+                     frame.stageMicros[static_cast<int>(TelemetryStage::Update)],
+                     frame.stageMicros[static_cast<int>(TelemetryStage::Scene)],
+                     frame.stageMicros[static_cast<int>(TelemetryStage::Present)],
+                     frame.frameMicros > budgetMicros ? 1 : 0,
+                     frame.camera.x.toDouble(), frame.camera.y.toDouble(), frame.camera.z.toDouble(),
+                     frame.audioVoices);
+        writeFrameStatsRow(file, frame.frame, frame.stats);
+    }
+}
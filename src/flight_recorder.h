@@ -0,0 +1,116 @@
+// flight_recorder.h
+// Recent frame history, written out when a frame runs over budget
+
+#ifndef LANDER_FLIGHT_RECORDER_H
+#define LANDER_FLIGHT_RECORDER_H
+
+#include "frame_stats.h"
+#include "telemetry.h"
+#include "math3d.h"
+#include "screen.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+// =============================================================================
+// Flight Recorder
+// =============================================================================
+//
+// Averages and percentiles hide the frames that actually stutter. The flight
+// recorder keeps the last HISTORY frames (stage timings, scene counters, the
+// camera position and the number of active voices) in a ring, and when a
+// frame takes longer than the budget it writes that history, ending with the
+// slow frame, to a CSV file:
+//
+//   ./lander --flight-recorder /tmp/lander-slow --slow-frame-ms 40
+//   -> /tmp/lander-slow-<frame>.csv (and -<frame>.png with screenshots on)
+//
+// Recording a frame is a copy into the ring, with no allocation or I/O, so
+// the recorder can stay on in release builds. Files are written by a writer
+// thread: a slow frame only copies the ring (and the pixels, if screenshots
+// are on) into buffers allocated by open() and wakes the writer. A slow frame
+// that comes while the writer is busy, or less than HISTORY frames after the
+// last dump, is counted but doesn't start a dump, so a run of stutters
+// doesn't write a file per frame.
+//
+// =============================================================================
+
+// One frame's record
+struct FlightFrame {
+    uint64_t frame = 0;
+    uint32_t frameMicros = 0;                      // Excluding the frame limiter
+    uint32_t stageMicros[TELEMETRY_STAGE_COUNT] = {};
+    Vec3 camera;                                   // Camera world position
+    int audioVoices = 0;
+    FrameStats stats;                              // Scene counters
+};
+
+class FlightRecorder {
+public:
+    static constexpr int HISTORY = 300;    // Frames kept and dumped
+
+    FlightRecorder();
+    ~FlightRecorder();
+
+    FlightRecorder(const FlightRecorder&) = delete;
+    FlightRecorder& operator=(const FlightRecorder&) = delete;
+
+    // Start recording; dumps are written to <prefix>-<frame>.csv, plus
+    // <prefix>-<frame>.png if screenshots is set. threadStart runs on the
+    // writer thread before anything else (e.g. to apply a ThreadConfig policy)
+    bool open(const char* prefix, uint32_t budgetMicros, bool screenshots,
+              std::function<void()> threadStart = nullptr);
+    void close();
+    bool isOpen() const { return writer.joinable(); }
+
+    // Record a frame; screen holds its pixels (for the screenshot, may be
+    // null). Returns true if it was over budget and a dump was started
+    bool record(const FlightFrame& frame, const ScreenBuffer* screen);
+
+    // Wait until the writer has finished the dump in progress, if any
+    void flush();
+
+    // Write frames oldest first as CSV, marking the last one (for tests)
+    static void writeFrames(FILE* file, const FlightFrame* frames, int count, uint32_t budgetMicros);
+
+    uint64_t getSlowFrames() const { return slowFrames; }
+    uint64_t getDumpsWritten() const { return dumpsWritten.load(); }
+    uint64_t getDumpsSkipped() const { return dumpsSkipped; }
+
+private:
+    void writerLoop();
+    void writeDump();
+
+    // Frame thread
+    std::unique_ptr<FlightFrame[]> ring;
+    int ringHead = 0;              // Next slot to write
+    int ringCount = 0;             // Frames in the ring (up to HISTORY)
+    uint64_t framesSinceDump = HISTORY;
+    uint64_t slowFrames = 0;
+    uint64_t dumpsSkipped = 0;
+    uint32_t budgetMicros = 0;
+
+    // Handed to the writer (owned by it while busy is set)
+    std::unique_ptr<FlightFrame[]> dumpFrames;
+    int dumpCount = 0;
+    std::unique_ptr<uint8_t[]> dumpPixels;     // Null without screenshots
+    int dumpWidth = 0;
+    int dumpHeight = 0;
+    char prefix[256];
+
+    std::thread writer;
+    std::function<void()> threadStart;
+    std::mutex mutex;
+    std::condition_variable wakeUp;
+    std::atomic<bool> busy{false};
+    bool dumpQueued = false;
+    bool stopping = false;
+    std::atomic<uint64_t> dumpsWritten{0};
+};
+
+#endif // LANDER_FLIGHT_RECORDER_H
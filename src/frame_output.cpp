@@ -0,0 +1,322 @@
+// frame_output.cpp
+// Shared-memory frame ring for external consumers (overlays, streaming)
+
+#include "frame_output.h"
+#include <cstdio>
+#include <cstring>
+#include <new>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+// =============================================================================
+// Helpers
+// =============================================================================
+
+static size_t roundUpToPage(size_t size)
+{
+    return (size + FrameOutputLayout::PAGE_SIZE - 1) & ~(FrameOutputLayout::PAGE_SIZE - 1);
+}
+
+// Shared-memory names must start with a slash
+static bool makeShmName(char* out, size_t size, const char* name)
+{
+    int written = std::snprintf(out, size, "%s%s", name[0] == '/' ? "" : "/", name);
+    return written > 1 && static_cast<size_t>(written) < size;
+}
+
+#ifndef _WIN32
+static uint64_t monotonicNanoseconds()
+{
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<uint64_t>(now.tv_sec) * 1000000000ull + static_cast<uint64_t>(now.tv_nsec);
+}
+#endif
+
+// Futex operations on a word shared between processes (not FUTEX_PRIVATE)
+static void futexWake(std::atomic<uint32_t>* word)
+{
+#ifdef __linux__
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAKE, INT32_MAX, nullptr, nullptr, 0);
+#else
+    (void)word;
+#endif
+}
+
+static void futexWait(std::atomic<uint32_t>* word, uint32_t expected, int timeoutMs)
+{
+#ifdef __linux__
+    timespec timeout;
+    timeout.tv_sec = timeoutMs / 1000;
+    timeout.tv_nsec = (timeoutMs % 1000) * 1000000L;
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAIT, expected, &timeout, nullptr, 0);
+#elif !defined(_WIN32)
+    // No futex: poll once a millisecond
+    (void)word;
+    (void)expected;
+    (void)timeoutMs;
+    usleep(1000);
+#else
+    (void)word;
+    (void)expected;
+    (void)timeoutMs;
+#endif
+}
+
+// =============================================================================
+// FrameOutput Implementation
+// =============================================================================
+
+FrameOutput::~FrameOutput()
+{
+    close();
+}
+
+#ifdef _WIN32
+
+bool FrameOutput::open(const char*, int, int) { return false; }
+void FrameOutput::close() {}
+
+#else
+
+bool FrameOutput::open(const char* name, int maxWidth, int maxHeight)
+{
+    close();
+
+    if (!makeShmName(shmName, sizeof(shmName), name) || maxWidth <= 0 || maxHeight <= 0) {
+        return false;
+    }
+
+    size_t pixelOffset = roundUpToPage(sizeof(FrameRingHeader));
+    size_t slotStride = roundUpToPage(static_cast<size_t>(maxWidth) * maxHeight * 4);
+    size_t size = pixelOffset + slotStride * FrameOutputLayout::SLOT_COUNT;
+
+    // Remove an object left behind by a previous run, so consumers never map
+    // a ring with a different layout
+    shm_unlink(shmName);
+
+    int fd = shm_open(shmName, O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) {
+        return false;
+    }
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        ::close(fd);
+        shm_unlink(shmName);
+        return false;
+    }
+    void* mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        shm_unlink(shmName);
+        return false;
+    }
+
+    // The new object is zero-filled: construct the header in place, and set
+    // the magic last so consumers only accept a complete header
+    ring = new (mapping) FrameRingHeader();
+    ring->version = FrameOutputLayout::VERSION;
+    ring->slotCount = FrameOutputLayout::SLOT_COUNT;
+    ring->maxWidth = static_cast<uint32_t>(maxWidth);
+    ring->maxHeight = static_cast<uint32_t>(maxHeight);
+    ring->pixelOffset = pixelOffset;
+    ring->slotStride = slotStride;
+    ring->latestSlot.store(FrameOutputLayout::SLOT_COUNT - 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    ring->magic = FrameOutputLayout::MAGIC;
+
+    mappedSize = size;
+    writeSlot = -1;
+    framesPublished = 0;
+    return true;
+}
+
+void FrameOutput::close()
+{
+    if (ring) {
+        munmap(ring, mappedSize);
+        shm_unlink(shmName);
+        ring = nullptr;
+        mappedSize = 0;
+    }
+}
+
+#endif // _WIN32
+
+uint8_t* FrameOutput::beginFrame()
+{
+    // Write to the slot after the latest one; consumers read the latest one
+    int slot = static_cast<int>((ring->latestSlot.load(std::memory_order_relaxed) + 1) %
+                                FrameOutputLayout::SLOT_COUNT);
+    FrameSlotHeader& header = ring->slots[slot];
+
+    // Odd sequence: the slot is being written
+    uint32_t sequence = header.sequence.load(std::memory_order_relaxed);
+    if ((sequence & 1) == 0) {
+        header.sequence.store(sequence + 1, std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+
+    writeSlot = slot;
+    return reinterpret_cast<uint8_t*>(ring) + ring->pixelOffset + ring->slotStride * slot;
+}
+
+void FrameOutput::publish(int width, int height)
+{
+    if (writeSlot < 0) {
+        return;
+    }
+
+    FrameSlotHeader& header = ring->slots[writeSlot];
+    header.width = static_cast<uint32_t>(width);
+    header.height = static_cast<uint32_t>(height);
+    header.pitch = ring->maxWidth * 4;
+    header.format = FrameOutputLayout::FORMAT_RGBA32;
+    header.frameNumber = ++framesPublished;
+#ifndef _WIN32
+    header.timestampNs = monotonicNanoseconds();
+#endif
+
+    // Even sequence: the pixels and header are complete
+    header.sequence.store(header.sequence.load(std::memory_order_relaxed) + 1,
+                          std::memory_order_release);
+    ring->latestSlot.store(static_cast<uint32_t>(writeSlot), std::memory_order_release);
+    writeSlot = -1;
+
+    // Sequentially consistent with the consumer's waiters increment, so
+    // either we see the waiter or its FUTEX_WAIT sees the new frame
+    ring->latestFrame.fetch_add(1, std::memory_order_seq_cst);
+    if (ring->waiters.load(std::memory_order_seq_cst) > 0) {
+        futexWake(&ring->latestFrame);
+    }
+}
+
+// =============================================================================
+// FrameReader Implementation
+// =============================================================================
+
+FrameReader::~FrameReader()
+{
+    close();
+}
+
+#ifdef _WIN32
+
+bool FrameReader::open(const char*) { return false; }
+void FrameReader::close() {}
+
+#else
+
+bool FrameReader::open(const char* name)
+{
+    close();
+
+    char shmName[64];
+    if (!makeShmName(shmName, sizeof(shmName), name)) {
+        return false;
+    }
+
+    int fd = shm_open(shmName, O_RDWR, 0);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(FrameRingHeader)) {
+        ::close(fd);
+        return false;
+    }
+
+    // Mapped writable so waiters can be counted
+    size_t size = static_cast<size_t>(info.st_size);
+    void* mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+
+    // The magic is set last: once it is seen the rest of the header is valid
+    FrameRingHeader* header = static_cast<FrameRingHeader*>(mapping);
+    bool ready = header->magic == FrameOutputLayout::MAGIC;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (!ready ||
+        header->version != FrameOutputLayout::VERSION ||
+        header->slotCount != FrameOutputLayout::SLOT_COUNT ||
+        header->pixelOffset + header->slotStride * header->slotCount > size) {
+        munmap(mapping, size);
+        return false;
+    }
+
+    ring = header;
+    mappedSize = size;
+    return true;
+}
+
+void FrameReader::close()
+{
+    if (ring) {
+        munmap(ring, mappedSize);
+        ring = nullptr;
+        mappedSize = 0;
+    }
+}
+
+#endif // _WIN32
+
+uint32_t FrameReader::getLatestFrame() const
+{
+    return ring->latestFrame.load(std::memory_order_acquire);
+}
+
+bool FrameReader::waitForFrame(uint32_t seen, int timeoutMs)
+{
+    if (getLatestFrame() != seen) {
+        return true;
+    }
+
+    ring->waiters.fetch_add(1, std::memory_order_seq_cst);
+    futexWait(&ring->latestFrame, seen, timeoutMs);
+    ring->waiters.fetch_sub(1, std::memory_order_seq_cst);
+
+    return getLatestFrame() != seen;
+}
+
+bool FrameReader::readLatest(FrameView& view) const
+{
+    int slot = static_cast<int>(ring->latestSlot.load(std::memory_order_acquire));
+    const FrameSlotHeader& header = ring->slots[slot];
+    uint32_t sequence = header.sequence.load(std::memory_order_acquire);
+    if (sequence == 0 || (sequence & 1) != 0) {
+        return false;  // Nothing published yet, or already being rewritten
+    }
+
+    view.pixels = reinterpret_cast<const uint8_t*>(ring) + ring->pixelOffset + ring->slotStride * slot;
+    view.width = static_cast<int>(header.width);
+    view.height = static_cast<int>(header.height);
+    view.pitch = static_cast<int>(header.pitch);
+    view.format = header.format;
+    view.frameNumber = header.frameNumber;
+    view.timestampNs = header.timestampNs;
+    view.slot = slot;
+    view.sequence = sequence;
+
+    // The header fields were read after the sequence: make sure they belong
+    // to the same frame
+    return isValid(view);
+}
+
+bool FrameReader::isValid(const FrameView& view) const
+{
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return view.slot >= 0 &&
+           ring->slots[view.slot].sequence.load(std::memory_order_relaxed) == view.sequence;
+}
@@ -0,0 +1,161 @@
+// frame_output.h
+// Shared-memory frame ring for external consumers (overlays, streaming)
+
+#ifndef LANDER_FRAME_OUTPUT_H
+#define LANDER_FRAME_OUTPUT_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// =============================================================================
+// Frame Output
+// =============================================================================
+//
+// Publishes every finished frame into a POSIX shared-memory object
+// (--frame-output <name>) so another process can read the game's output
+// without capturing the window. The object holds a FrameRingHeader followed
+// by SLOT_COUNT page-aligned pixel slots, each large enough for a frame at
+// the maximum resolution.
+//
+// The game renders straight into a slot (ScreenBuffer::setTarget), so
+// publishing costs no copy: it fills in the slot header, makes the slot the
+// latest one and wakes any consumer waiting on the latestFrame futex word.
+// Slots are reused round-robin and the game never waits for a consumer.
+//
+// Each slot is guarded by a sequence counter that is odd while the game is
+// writing to it. A consumer reads the latest slot's sequence, uses the
+// pixels, then checks the sequence again: if it changed the consumer fell
+// more than SLOT_COUNT - 1 frames behind and the frame must be discarded.
+// FrameReader implements this protocol.
+//
+// Consumers can block on latestFrame with FUTEX_WAIT (Linux) after
+// incrementing waiters, so the game only makes the wake syscall when someone
+// is waiting. On other Unix systems consumers poll. Not available on Windows,
+// where open() always fails.
+//
+// =============================================================================
+
+namespace FrameOutputLayout {
+    constexpr uint32_t MAGIC = 0x52444E4C;        // "LNDR"
+    constexpr uint32_t VERSION = 1;
+    constexpr int SLOT_COUNT = 3;
+    constexpr uint32_t FORMAT_RGBA32 = 0x41424752;  // "RGBA": bytes R, G, B, A
+    constexpr size_t PAGE_SIZE = 4096;
+}
+
+// Written by the game, read by consumers (plain layout, no pointers)
+struct FrameSlotHeader {
+    std::atomic<uint32_t> sequence;   // Odd while the slot is being written
+    uint32_t width;                   // Visible size in pixels
+    uint32_t height;
+    uint32_t pitch;                   // Bytes between rows
+    uint32_t format;                  // FrameOutputLayout::FORMAT_RGBA32
+    uint32_t reserved;
+    uint64_t frameNumber;             // Frames published before this one + 1
+    uint64_t timestampNs;             // CLOCK_MONOTONIC when published
+};
+
+struct FrameRingHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t slotCount;
+    uint32_t maxWidth;
+    uint32_t maxHeight;
+    uint32_t reserved;
+    uint64_t pixelOffset;             // Offset of slot 0's pixels
+    uint64_t slotStride;              // Bytes between slots' pixels
+    std::atomic<uint32_t> latestFrame;  // Futex word: frames published (wraps)
+    std::atomic<uint32_t> latestSlot;   // Slot of the latest frame
+    std::atomic<uint32_t> waiters;      // Consumers blocked on latestFrame
+    uint32_t reserved2;
+    FrameSlotHeader slots[FrameOutputLayout::SLOT_COUNT];
+};
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free,
+              "shared-memory counters must be lock-free");
+
+// =============================================================================
+// Frame Output (game side)
+// =============================================================================
+
+class FrameOutput {
+public:
+    FrameOutput() = default;
+    ~FrameOutput();
+
+    FrameOutput(const FrameOutput&) = delete;
+    FrameOutput& operator=(const FrameOutput&) = delete;
+
+    // Create the shared-memory ring (replaces a stale object of the same name)
+    // Frames can be up to maxWidth x maxHeight RGBA pixels
+    bool open(const char* name, int maxWidth, int maxHeight);
+    void close();
+    bool isOpen() const { return ring != nullptr; }
+
+    // Start a frame: returns the pixels of the next slot to render into
+    // (maxWidth * maxHeight * 4 bytes, pitch maxWidth * 4)
+    uint8_t* beginFrame();
+
+    // Publish the frame started by beginFrame() and wake waiting consumers
+    void publish(int width, int height);
+
+    uint64_t getFramesPublished() const { return framesPublished; }
+
+private:
+    FrameRingHeader* ring = nullptr;
+    size_t mappedSize = 0;
+    char shmName[64];
+    int writeSlot = -1;               // Slot being rendered, -1 if none
+    uint64_t framesPublished = 0;
+};
+
+// =============================================================================
+// Frame Reader (consumer side)
+// =============================================================================
+
+// A frame in the ring; only valid while FrameReader::isValid() says so
+struct FrameView {
+    const uint8_t* pixels = nullptr;
+    int width = 0;
+    int height = 0;
+    int pitch = 0;
+    uint32_t format = 0;
+    uint64_t frameNumber = 0;
+    uint64_t timestampNs = 0;
+    int slot = -1;
+    uint32_t sequence = 0;
+};
+
+class FrameReader {
+public:
+    FrameReader() = default;
+    ~FrameReader();
+
+    FrameReader(const FrameReader&) = delete;
+    FrameReader& operator=(const FrameReader&) = delete;
+
+    // Map a ring created by the game
+    bool open(const char* name);
+    void close();
+    bool isOpen() const { return ring != nullptr; }
+
+    // Frames published so far (wraps), for waitForFrame()
+    uint32_t getLatestFrame() const;
+
+    // Block until a frame after 'seen' is published or the timeout passes
+    // Returns true if there is a newer frame
+    bool waitForFrame(uint32_t seen, int timeoutMs);
+
+    // Get the latest complete frame, returns false if there is none yet
+    bool readLatest(FrameView& view) const;
+
+    // Check (after using the pixels) that the game hasn't reused the slot
+    bool isValid(const FrameView& view) const;
+
+private:
+    FrameRingHeader* ring = nullptr;
+    size_t mappedSize = 0;
+};
+
+#endif // LANDER_FRAME_OUTPUT_H
@@ -0,0 +1,107 @@
+// frame_stats.cpp
+// Per-frame scene complexity counters
+
+#include "frame_stats.h"
+#include <cstring>
+
+// =============================================================================
+// Global Instance
+// =============================================================================
+
+FrameStats frameStats;
+
+// =============================================================================
+// FrameStats Implementation
+// =============================================================================
+
+const char* getParticleKindName(ParticleKind kind)
+{
+    switch (kind) {
+        case ParticleKind::Exhaust: return "exhaust";
+        case ParticleKind::Bullet:  return "bullet";
+        case ParticleKind::Spark:   return "spark";
+        case ParticleKind::Splash:  return "splash";
+        case ParticleKind::Debris:  return "debris";
+        case ParticleKind::Smoke:   return "smoke";
+        case ParticleKind::Rock:    return "rock";
+        case ParticleKind::Star:    return "star";
+        default:                    return "other";
+    }
+}
+
+void FrameStats::reset()
+{
+    frameReused = 0;
+    tilesDrawn = 0;
+    tilesClipped = 0;
+    tilesCulled = 0;
+    std::memset(rowTriangles, 0, sizeof(rowTriangles));
+    trianglesBuffered = 0;
+    trianglesDropped = 0;
+    trianglesOffScreen = 0;
+    trianglesDrawn = 0;
+    pixelsFilled = 0;
+    objectsDrawn = 0;
+    shadowsDrawn = 0;
+    objectsCulled = 0;
+    shadowsCulled = 0;
+    std::memset(particles, 0, sizeof(particles));
+    particlesRejected = 0;
+}
+
+int FrameStats::getParticleTotal() const
+{
+    int total = 0;
+    for (int i = 0; i < PARTICLE_KIND_COUNT; i++) {
+        total += particles[i];
+    }
+    return total;
+}
+
+int FrameStats::getBusiestRow() const
+{
+    int busiest = 0;
+    for (int row = 1; row < GameConstants::MAX_TILES_Z; row++) {
+        if (rowTriangles[row] > rowTriangles[busiest]) {
+            busiest = row;
+        }
+    }
+    return busiest;
+}
+
+// =============================================================================
+// CSV Output
+// =============================================================================
+
+void writeFrameStatsHeader(FILE* file)
+{
+    std::fprintf(file, "frame,frame_reused,tiles_drawn,tiles_clipped,tiles_culled,"
+                       "triangles_buffered,triangles_dropped,triangles_offscreen,triangles_drawn,"
+                       "pixels_filled,objects_drawn,shadows_drawn,objects_culled,shadows_culled");
+    for (int i = 0; i < PARTICLE_KIND_COUNT; i++) {
+        std::fprintf(file, ",particles_%s", getParticleKindName(static_cast<ParticleKind>(i)));
+    }
+    std::fprintf(file, ",particles_rejected");
+    for (int row = 0; row < GameConstants::MAX_TILES_Z; row++) {
+        std::fprintf(file, ",row%d", row);
+    }
+    std::fprintf(file, "\n");
+}
+
+void writeFrameStatsRow(FILE* file, uint64_t frameNumber, const FrameStats& stats)
+{
+    std::fprintf(file, "%llu,%d,%d,%d,%d,%d,%d,%d,%d,%llu,%d,%d,%d,%d",
+                 static_cast<unsigned long long>(frameNumber), stats.frameReused,
+                 stats.tilesDrawn, stats.tilesClipped, stats.tilesCulled,
+                 stats.trianglesBuffered, stats.trianglesDropped, stats.trianglesOffScreen,
+                 stats.trianglesDrawn, static_cast<unsigned long long>(stats.pixelsFilled),
+                 stats.objectsDrawn, stats.shadowsDrawn, stats.objectsCulled, stats.shadowsCulled);
+    for (int i = 0; i < PARTICLE_KIND_COUNT; i++) {
+        std::fprintf(file, ",%d", stats.particles[i]);
+    }
+    std::fprintf(file, ",%d", stats.particlesRejected);
+    for (int row = 0; row < GameConstants::MAX_TILES_Z; row++) {
+        std::fprintf(file, ",%d", stats.rowTriangles[row]);
+    }
+    std::fprintf(file, "\n");
+}
@@ -0,0 +1,94 @@
+// frame_stats.h
+// Per-frame scene complexity counters
+
+#ifndef LANDER_FRAME_STATS_H
+#define LANDER_FRAME_STATS_H
+
+#include "fixed.h"
+#include <cstdint>
+#include <cstdio>
+
+// =============================================================================
+// Frame Statistics
+// =============================================================================
+//
+// Counters filled in by the landscape, object, particle and raster code while
+// a frame is built. They explain where a frame's time goes (how much terrain
+// was clipped, how many triangles and pixels were drawn, how busy the
+// particle system was) so frame times can be compared between locations and
+// settings instead of being inferred from the FPS counter.
+//
+// The game resets the counters at the start of each frame and takes a copy
+// once the scene has been drawn, before the HUD is added. The copy is what
+// the debug overlay shows and what is written to the stats CSV. A frame that
+// reuses the previous one draws nothing, so only frameReused and the
+// particle counts are set.
+//
+// =============================================================================
+
+// Particle kinds, classified from the flags each spawn function uses
+enum class ParticleKind {
+    Exhaust,    // Fading, splashing particles (exhaust and explosion flames)
+    Bullet,     // Bullets (destroy objects)
+    Spark,      // Fading sparks from bullet impacts
+    Splash,     // Water splash droplets
+    Debris,     // Explosion debris
+    Smoke,      // Rising smoke
+    Rock,       // Falling rocks
+    Star,       // Stars at high altitude
+    Count
+};
+
+constexpr int PARTICLE_KIND_COUNT = static_cast<int>(ParticleKind::Count);
+
+// Short labels for the overlay and CSV header
+const char* getParticleKindName(ParticleKind kind);
+
+struct FrameStats {
+    // Frame
+    int frameReused;     // 1 if the previous frame was shown again, unchanged
+
+    // Landscape tiles
+    int tilesDrawn;      // Tiles that reached the rasterizer
+    int tilesClipped;    // Tiles that went through 3D edge clipping
+    int tilesCulled;     // Tiles skipped (corner behind camera or clipped away)
+
+    // Object graphics buffers (objects, shadows, particles)
+    int rowTriangles[GameConstants::MAX_TILES_Z];  // Submitted per tile row
+    int trianglesBuffered;   // Accepted into a row buffer
+    int trianglesDropped;    // Rejected because a row buffer was full
+    int trianglesOffScreen;  // Rejected because they were entirely off screen
+
+    // Rasterizer
+    int trianglesDrawn;      // Triangles filled (terrain and buffered)
+    uint64_t pixelsFilled;   // Pixels written by spans and blocks
+
+    // Objects
+    int objectsDrawn;        // Objects with at least one visible face
+    int shadowsDrawn;        // Shadows with at least one triangle
+    int objectsCulled;       // Objects skipped by their bounding box
+    int shadowsCulled;       // Shadows skipped by their bounding box
+
+    // Particles
+    int particles[PARTICLE_KIND_COUNT];  // Live particles by kind
+    int particlesRejected;               // addParticle() calls with no room
+
+    FrameStats() { reset(); }
+
+    void reset();
+
+    // Sum of particles over all kinds
+    int getParticleTotal() const;
+
+    // Busiest tile row (the one closest to MAX_TRIANGLES)
+    int getBusiestRow() const;
+};
+
+// Counters for the frame currently being built
+extern FrameStats frameStats;
+
+// Write the CSV column names / one row of values (no trailing comma)
+void writeFrameStatsHeader(FILE* file);
+void writeFrameStatsRow(FILE* file, uint64_t frameNumber, const FrameStats& stats);
+
+#endif // LANDER_FRAME_STATS_H
@@ -2,6 +2,7 @@
 // Depth-sorted graphics buffer system for deferred triangle rendering
 
 #include "graphics_buffer.h"
+#include "frame_stats.h"
 
 // =============================================================================
 // Global Instance
@@ -16,14 +17,27 @@ GraphicsBufferSystem graphicsBuffers;
 RowBuffer::RowBuffer()
 {
     triangles.reserve(MAX_TRIANGLES);
+    runVertices.reserve(MAX_TRIANGLES * 6);
 }
 
 void RowBuffer::addTriangle(int x1, int y1, int x2, int y2, int x3, int y3, Color color)
 {
+    // Skip triangles entirely off one edge of the screen, before they take
+    // up room in the buffer (or wrap when narrowed to 16 bits)
+    int width = ScreenBuffer::PHYSICAL_WIDTH();
+    int height = ScreenBuffer::PHYSICAL_HEIGHT();
+    if ((x1 < 0 && x2 < 0 && x3 < 0) || (x1 >= width && x2 >= width && x3 >= width) ||
+        (y1 < 0 && y2 < 0 && y3 < 0) || (y1 >= height && y2 >= height && y3 >= height)) {
+        frameStats.trianglesOffScreen++;
+        return;
+    }
+
     // Don't exceed buffer capacity
     if (triangles.size() >= MAX_TRIANGLES) {
+        frameStats.trianglesDropped++;
         return;
     }
+    frameStats.trianglesBuffered++;
 
     BufferedTriangle tri;
     tri.x1 = static_cast<int16_t>(x1);
@@ -44,11 +58,42 @@ void RowBuffer::draw(ScreenBuffer& screen)
     }
 }
 
+void RowBuffer::drawMerged(ScreenBuffer& screen)
+{
+    size_t first = 0;
+    while (first < triangles.size()) {
+        Color color = triangles[first].color;
+        runVertices.clear();
+
+        size_t last = first;
+        for (; last < triangles.size(); last++) {
+            const BufferedTriangle& tri = triangles[last];
+            if (tri.color.r != color.r || tri.color.g != color.g ||
+                tri.color.b != color.b || tri.color.a != color.a) {
+                break;
+            }
+            runVertices.insert(runVertices.end(), { tri.x1, tri.y1, tri.x2, tri.y2, tri.x3, tri.y3 });
+        }
+
+        screen.drawTriangleUnion(runVertices.data(), static_cast<int>(last - first), color);
+        first = last;
+    }
+}
+
 void RowBuffer::clear()
 {
     triangles.clear();
 }
 
+void RowBuffer::prefault()
+{
+    // Sizing writes every element; clearing keeps the capacity
+    triangles.resize(MAX_TRIANGLES);
+    runVertices.resize(MAX_TRIANGLES * 6);
+    triangles.clear();
+    runVertices.clear();
+}
+
 // =============================================================================
 // GraphicsBufferSystem Implementation
 // =============================================================================
@@ -66,6 +111,7 @@ void GraphicsBufferSystem::addTriangle(int row, int x1, int y1, int x2, int y2,
         return;
     }
 
+    frameStats.rowTriangles[row]++;
     buffers[row].addTriangle(x1, y1, x2, y2, x3, y3, color);
 }
 
@@ -77,6 +123,7 @@ void GraphicsBufferSystem::addShadowTriangle(int row, int x1, int y1, int x2, in
         return;
     }
 
+    frameStats.rowTriangles[row]++;
     shadowBuffers[row].addTriangle(x1, y1, x2, y2, x3, y3, color);
 }
 
@@ -88,7 +135,7 @@ void GraphicsBufferSystem::drawAndClearRow(int row, ScreenBuffer& screen)
     }
 
     // Draw shadows first (they should appear under objects)
-    shadowBuffers[row].draw(screen);
+    shadowBuffers[row].drawMerged(screen);
     shadowBuffers[row].clear();
 
     // Then draw objects (on top of shadows)
@@ -104,6 +151,14 @@ void GraphicsBufferSystem::clearAll()
     }
 }
 
+void GraphicsBufferSystem::prefault()
+{
+    for (int i = 0; i < MAX_TILES_Z; i++) {
+        buffers[i].prefault();
+        shadowBuffers[i].prefault();
+    }
+}
+
 size_t GraphicsBufferSystem::getTriangleCount(int row) const
 {
     if (row < 0 || row >= TILES_Z) {
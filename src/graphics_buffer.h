@@ -53,9 +53,17 @@ public:
     // Draw all triangles in this buffer to the screen
     void draw(ScreenBuffer& screen);
 
+    // Draw the same pixels as draw(), but fill each run of triangles of
+    // one colour as a single union (for shadows, whose triangles overlap)
+    void drawMerged(ScreenBuffer& screen);
+
     // Clear this buffer
     void clear();
 
+    // Touch the buffer's storage at full capacity, so the first frames
+    // don't fault it in page by page
+    void prefault();
+
     // Check if buffer is empty
     bool isEmpty() const { return triangles.empty(); }
 
@@ -65,6 +73,9 @@ public:
 private:
     std::vector<BufferedTriangle> triangles;
 
+    // Vertices of the run being merged, for drawMerged()
+    std::vector<int> runVertices;
+
     // Maximum triangles per buffer
     // Original: 4308 / 28 ≈ 153 triangles, but we have more particles and need headroom
     // At 484 max particles * 4 triangles each = 1936 triangles if all in one row (worst case)
@@ -86,12 +97,15 @@ public:
     void addShadowTriangle(int row, int x1, int y1, int x2, int y2, int x3, int y3, Color color);
 
     // Draw all triangles in a specific row buffer and clear it
-    // Draws shadows first, then objects
+    // Draws shadows first (merged, see RowBuffer::drawMerged), then objects
     void drawAndClearRow(int row, ScreenBuffer& screen);
 
     // Clear all buffers (call at start of each frame)
     void clearAll();
 
+    // Prefault every buffer, including those beyond the current scale's rows
+    void prefault();
+
     // Get statistics
     size_t getTriangleCount(int row) const;
     size_t getTotalTriangleCount() const;
@@ -0,0 +1,87 @@
+// input_sampler.cpp
+// Timestamped mouse input, split across the physics ticks of a frame
+
+#include "input_sampler.h"
+#include <cstddef>
+
+// =============================================================================
+// InputSampler Implementation
+// =============================================================================
+
+void InputSampler::addMotion(uint32_t time, int dx, int dy)
+{
+    pending.push_back(Event{time, dx, dy, 0, 0});
+}
+
+void InputSampler::pressButtons(uint32_t time, uint32_t mask)
+{
+    pending.push_back(Event{time, 0, 0, mask, 0});
+}
+
+void InputSampler::releaseButtons(uint32_t time, uint32_t mask)
+{
+    pending.push_back(Event{time, 0, 0, 0, mask});
+}
+
+void InputSampler::splitTicks(uint32_t time, int tickCount)
+{
+    ticks.assign(tickCount > 0 ? tickCount : 0, TickInput());
+    if (tickCount <= 0) {
+        return;
+    }
+
+    // Times are compared as offsets from the slice start, so the millisecond
+    // counter may wrap; input stamped before the start goes in the first tick
+    uint32_t span = time - sliceStart;
+    if (static_cast<int32_t>(span) < 0) span = 0;
+
+    size_t next = 0;
+    for (int tick = 0; tick < tickCount; tick++) {
+        TickInput& input = ticks[tick];
+        input.buttons = heldButtons;
+
+        // The last tick also takes anything stamped after time
+        bool last = (tick == tickCount - 1);
+        uint64_t sliceEnd = static_cast<uint64_t>(span) * (tick + 1) / tickCount;
+        while (next < pending.size()) {
+            const Event& event = pending[next];
+            int32_t offset = static_cast<int32_t>(event.time - sliceStart);
+            if (!last && offset > 0 && static_cast<uint64_t>(offset) >= sliceEnd) {
+                break;
+            }
+            input.dx += event.dx;
+            input.dy += event.dy;
+            input.buttons |= event.press;
+            heldButtons = (heldButtons | event.press) & ~event.release;
+            next++;
+        }
+    }
+
+    pending.clear();
+    sliceStart = time;
+}
+
+void InputSampler::discard(uint32_t time)
+{
+    heldButtons = getButtons();
+    pending.clear();
+    ticks.clear();
+    sliceStart = time;
+}
+
+void InputSampler::reset(uint32_t time)
+{
+    pending.clear();
+    ticks.clear();
+    heldButtons = 0;
+    sliceStart = time;
+}
+
+uint32_t InputSampler::getButtons() const
+{
+    uint32_t buttons = heldButtons;
+    for (const Event& event : pending) {
+        buttons = (buttons | event.press) & ~event.release;
+    }
+    return buttons;
+}
@@ -0,0 +1,74 @@
+// input_sampler.h
+// Timestamped mouse input, split across the physics ticks of a frame
+
+#ifndef LANDER_INPUT_SAMPLER_H
+#define LANDER_INPUT_SAMPLER_H
+
+#include <cstdint>
+#include <vector>
+
+// =============================================================================
+// Input Sampler
+// =============================================================================
+//
+// Events are polled once per frame, but a frame runs several physics ticks
+// (8 at 15fps). Reading one relative mouse delta per frame and giving it all
+// to the first tick turns the ship in lumps at low frame rates, and a button
+// pressed late in a frame acts as if it had been pressed at its start.
+//
+// InputSampler records each mouse motion and button change with the time it
+// arrived (the SDL event timestamp, in milliseconds). splitTicks() then cuts
+// the time since the previous split into one equal slice per tick and gives
+// each tick the motion that arrived during its slice. A tick sees a button
+// held if it was held at any time during its slice, so a click shorter than
+// a slice still reaches at least one tick.
+//
+// Input that arrives while no ticks run (splitTicks() with a count of zero)
+// waits for the next split; discard() drops it, e.g. while paused.
+//
+// =============================================================================
+
+// Input for one physics tick
+struct TickInput {
+    int dx = 0;             // Relative mouse motion
+    int dy = 0;
+    uint32_t buttons = 0;   // SDL button mask (1 = left, 2 = middle, 4 = right)
+};
+
+class InputSampler {
+public:
+    // Record input that arrived at a time in milliseconds
+    void addMotion(uint32_t time, int dx, int dy);
+    void pressButtons(uint32_t time, uint32_t mask);
+    void releaseButtons(uint32_t time, uint32_t mask);
+
+    // Split the input recorded up to time across tickCount ticks
+    void splitTicks(uint32_t time, int tickCount);
+
+    // Input for a tick of the last split (0 <= tick < tickCount)
+    const TickInput& getTick(int tick) const { return ticks[tick]; }
+
+    // Drop recorded motion up to time, keeping the buttons held
+    void discard(uint32_t time);
+
+    // Drop everything and release every button (the mouse was released)
+    void reset(uint32_t time);
+
+    // Buttons held after the last recorded input
+    uint32_t getButtons() const;
+
+private:
+    struct Event {
+        uint32_t time;
+        int dx, dy;
+        uint32_t press;     // Buttons pressed
+        uint32_t release;   // Buttons released
+    };
+
+    std::vector<Event> pending;
+    std::vector<TickInput> ticks;
+    uint32_t sliceStart = 0;     // Time of the last split
+    uint32_t heldButtons = 0;    // Held at sliceStart
+};
+
+#endif // LANDER_INPUT_SAMPLER_H
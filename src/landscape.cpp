@@ -4,6 +4,7 @@
 
 #include "landscape.h"
 #include "lookup_tables.h"
+#include "cpu_dispatch.h"
 
 using namespace GameConstants;
 
@@ -173,3 +174,18 @@ Fixed getLandscapeAltitudeAtTile(int tileX, int tileZ) {
 
     return getLandscapeAltitude(x, z);
 }
+
+// =============================================================================
+// Row Synthesis
+// =============================================================================
+//
+// The renderer asks for a whole row of corners at a time. The row is done by
+// the landscape kernel of the CPU level picked at startup (cpu_kernels.h),
+// a pack of corners at a time.
+//
+// =============================================================================
+
+void getLandscapeAltitudeRow(Fixed x, Fixed z, int count, Fixed* altitudes) {
+    static_assert(sizeof(Fixed) == sizeof(int32_t), "Fixed is one raw value");
+    CpuDispatch::kernels->landscape.altitudeRow(x.raw, z.raw, count, &altitudes[0].raw);
+}
@@ -7,6 +7,12 @@
 
 #include "fixed.h"
 
+// Highest altitude the terrain can reach: the six terms' weights add up to
+// 10, so the sum is never more than 10 * 0x7FFFFFFF before the >> 8
+// (the lowest is SEA_LEVEL)
+constexpr Fixed LANDSCAPE_PEAK_ALTITUDE = Fixed::fromRaw(
+    GameConstants::LAND_MID_HEIGHT.raw - static_cast<int32_t>((10LL * 0x7FFFFFFF) >> 8));
+
 // Get the landscape altitude at world coordinates (x, z)
 // Uses Fourier synthesis with 6 sine wave terms to generate procedural terrain
 // Returns altitude in fixed-point format (lower y = higher physical altitude)
@@ -21,4 +27,9 @@ Fixed getLandscapeAltitude(Fixed x, Fixed z);
 // tileZ range: 0 to TILES_Z-1 (0 to 10)
 Fixed getLandscapeAltitudeAtTile(int tileX, int tileZ);
 
+// Get the altitudes of count points one tile apart along x, starting at
+// (x, z), with x wrapping as Fixed addition does
+// Gives the same altitudes as getLandscapeAltitude(), several at a time
+void getLandscapeAltitudeRow(Fixed x, Fixed z, int count, Fixed* altitudes);
+
 #endif // LANDSCAPE_H
@@ -5,6 +5,7 @@
 #include "graphics_buffer.h"
 #include "particles.h"
 #include "clipping.h"
+#include "frame_stats.h"
 
 using namespace GameConstants;
 
@@ -56,25 +57,6 @@ LandscapeRenderer::CornerData LandscapeRenderer::projectCorner(
     return corner;
 }
 
-LandscapeRenderer::CornerData LandscapeRenderer::projectCornerRelative(
-    Fixed relX, Fixed relY, Fixed relZ)
-{
-    CornerData corner;
-    corner.altitude = Fixed();  // Set by caller
-    corner.valid = false;
-
-    // Project to screen (coordinates are already camera-relative)
-    ProjectedVertex proj = projectVertex(relX, relY, relZ);
-
-    if (proj.visible) {
-        corner.screenX = proj.screenX;
-        corner.screenY = proj.screenY;
-        corner.valid = true;
-    }
-
-    return corner;
-}
-
 // =============================================================================
 // Tile Type Detection
 // =============================================================================
@@ -98,15 +80,11 @@ TileType LandscapeRenderer::getTileType(Fixed x, Fixed z, Fixed altitude) {
 // Tile Drawing
 // =============================================================================
 
-void LandscapeRenderer::drawTile(
-    ScreenBuffer& screen,
+Color LandscapeRenderer::getTileColor(
     const CornerData& topLeft, const CornerData& topRight,
     const CornerData& bottomLeft, const CornerData& bottomRight,
-    int tileRow, Fixed tileX, Fixed tileZ,
-    int clipFlags, Fixed clipLeftX, Fixed clipRightX,
-    Fixed clipNearZ, Fixed clipFarZ)
+    int tileRow, Fixed tileX, Fixed tileZ)
 {
-    // Calculate tile color (before clipping, using original corners)
     // Use average altitude for color determination
     Fixed avgAltitude = Fixed::fromRaw(
         (topLeft.altitude.raw + topRight.altitude.raw +
@@ -122,17 +100,30 @@ void LandscapeRenderer::drawTile(
     // Determine tile type
     TileType type = getTileType(tileX, tileZ, avgAltitude);
 
-    // Get color
-    Color color = getLandscapeTileColor(avgAltitude.raw, tileRow, slope, type);
+    return getLandscapeTileColor(avgAltitude.raw, tileRow, slope, type);
+}
 
+void LandscapeRenderer::drawTile(
+    ScreenBuffer& screen,
+    const CornerData& topLeft, const CornerData& topRight,
+    const CornerData& bottomLeft, const CornerData& bottomRight,
+    int tileRow, Fixed tileX, Fixed tileZ,
+    int clipFlags, Fixed clipLeftX, Fixed clipRightX,
+    Fixed clipNearZ, Fixed clipFarZ)
+{
+    // Calculate tile color (before clipping, using original corners)
+    Color color = getTileColor(topLeft, topRight, bottomLeft, bottomRight,
+                               tileRow, tileX, tileZ);
 
     // If no clipping needed, use the fast path
     if (clipFlags == CLIP_NONE) {
         // All corners must be valid to draw
         if (!topLeft.valid || !topRight.valid ||
             !bottomLeft.valid || !bottomRight.valid) {
+            frameStats.tilesCulled++;
             return;
         }
+        frameStats.tilesDrawn++;
 
         // Draw as two triangles
         // Triangle 1: topLeft, topRight, bottomLeft
@@ -152,6 +143,8 @@ void LandscapeRenderer::drawTile(
     }
 
     // Clipping path: build quad from 3D coordinates, clip, then project
+    frameStats.tilesClipped++;
+
     // Quad corners in order: topLeft, topRight, bottomRight, bottomLeft
     ClipVertex3D quad[4] = {
         {topLeft.relX, topLeft.relY, topLeft.relZ},
@@ -170,19 +163,31 @@ void LandscapeRenderer::drawTile(
     // Clip against each requested plane
     if (clipFlags & CLIP_LEFT) {
         poly = clipPolygonLeft(poly, clipLeftX);
-        if (poly.count < 3) return;
+        if (poly.count < 3) {
+            frameStats.tilesCulled++;
+            return;
+        }
     }
     if (clipFlags & CLIP_RIGHT) {
         poly = clipPolygonRight(poly, clipRightX);
-        if (poly.count < 3) return;
+        if (poly.count < 3) {
+            frameStats.tilesCulled++;
+            return;
+        }
     }
     if (clipFlags & CLIP_NEAR) {
         poly = clipPolygonNear(poly, clipNearZ);
-        if (poly.count < 3) return;
+        if (poly.count < 3) {
+            frameStats.tilesCulled++;
+            return;
+        }
     }
     if (clipFlags & CLIP_FAR) {
         poly = clipPolygonFar(poly, clipFarZ);
-        if (poly.count < 3) return;
+        if (poly.count < 3) {
+            frameStats.tilesCulled++;
+            return;
+        }
     }
 
     // Project clipped vertices to screen
@@ -192,12 +197,15 @@ void LandscapeRenderer::drawTile(
         ProjectedVertex proj = projectVertex(poly.vertices[i].x, poly.vertices[i].y, poly.vertices[i].z);
         if (!proj.visible) {
             // Vertex behind camera - skip this polygon
+            frameStats.tilesCulled++;
             return;
         }
         screenX[i] = proj.screenX;
         screenY[i] = proj.screenY;
     }
 
+    frameStats.tilesDrawn++;
+
     // Triangulate and draw using fan triangulation
     for (int i = 1; i < poly.count - 1; i++) {
         screen.drawTriangle(
@@ -208,6 +216,35 @@ void LandscapeRenderer::drawTile(
     }
 }
 
+// =============================================================================
+// Tile Strips
+// =============================================================================
+
+void LandscapeRenderer::addStripTile(
+    const CornerData& topLeft, const CornerData& topRight,
+    const CornerData& bottomLeft, const CornerData& bottomRight,
+    Color color)
+{
+    // The first tile of a run supplies the left-hand corners
+    if (stripCount == 0) {
+        stripTop[0] = {topLeft.screenX, topLeft.screenY};
+        stripBottom[0] = {bottomLeft.screenX, bottomLeft.screenY};
+    }
+
+    stripTop[stripCount + 1] = {topRight.screenX, topRight.screenY};
+    stripBottom[stripCount + 1] = {bottomRight.screenX, bottomRight.screenY};
+    stripColors[stripCount] = color;
+    stripCount++;
+}
+
+void LandscapeRenderer::flushStrip(ScreenBuffer& screen)
+{
+    if (stripCount > 0) {
+        screen.drawQuadStrip(stripTop, stripBottom, stripColors, stripCount);
+        stripCount = 0;
+    }
+}
+
 // =============================================================================
 // Main Render Function
 // =============================================================================
@@ -295,35 +332,40 @@ void LandscapeRenderer::render(ScreenBuffer& screen, const Camera& camera)
         // Array index (offset by extraTiles to handle negative row indices)
         int rowIdx = row + extraTiles;
 
-        // Process each corner in this row
+        // Altitudes and projections for the whole row of corners at once
+        int cornerCount = colEnd - colStart;
+        Fixed altitudes[MAX_CORNERS];
+        Vec3 relativeCorners[MAX_CORNERS];
+        ProjectedVertex projected[MAX_CORNERS];
+        getLandscapeAltitudeRow(Fixed::fromInt(camTileX - halfTilesX + colStart),
+                                Fixed::fromInt(worldZInt), cornerCount, altitudes);
+
         for (int col = colStart; col < colEnd; col++) {
             // Array index (offset by extraTiles to handle negative col indices)
             int colIdx = col + extraTiles;
 
             // Calculate screen-relative X for this corner
             int32_t relXRaw = adjustedStartX + (colIdx * TILE_SIZE.raw);
-            Fixed relX = Fixed::fromRaw(relXRaw);
-
-            // World X for this corner - centered on camera tile position
-            int worldXInt = camTileX - halfTilesX + col;
-
-            // Convert to Fixed for altitude lookup
-            Fixed worldX = Fixed::fromInt(worldXInt);
-            Fixed worldZ = Fixed::fromInt(worldZInt);
-
-            // Get altitude at this corner
-            Fixed altitude = getLandscapeAltitude(worldX, worldZ);
 
             // The relative Y is altitude minus camera Y
-            Fixed relY = Fixed::fromRaw(altitude.raw - camY.raw);
+            relativeCorners[colIdx] = Vec3(Fixed::fromRaw(relXRaw),
+                                           Fixed::fromRaw(altitudes[colIdx].raw - camY.raw),
+                                           relZ);
+        }
+
+        // Project corners to screen (coordinates are already camera-relative)
+        projectVertices(relativeCorners, cornerCount, projected);
 
-            // Project corner to screen (coordinates are already camera-relative)
-            currentRow[colIdx] = projectCornerRelative(relX, relY, relZ);
-            currentRow[colIdx].altitude = altitude;
+        for (int colIdx = 0; colIdx < cornerCount; colIdx++) {
+            CornerData& corner = currentRow[colIdx];
+            corner.screenX = projected[colIdx].screenX;
+            corner.screenY = projected[colIdx].screenY;
+            corner.valid = projected[colIdx].visible;
+            corner.altitude = altitudes[colIdx];
             // Store 3D coordinates for clipping
-            currentRow[colIdx].relX = relX;
-            currentRow[colIdx].relY = relY;
-            currentRow[colIdx].relZ = relZ;
+            corner.relX = relativeCorners[colIdx].x;
+            corner.relY = relativeCorners[colIdx].y;
+            corner.relZ = relativeCorners[colIdx].z;
         }
 
         // Draw tiles (need at least one previous row)
@@ -353,12 +395,34 @@ void LandscapeRenderer::render(ScreenBuffer& screen, const Camera& camera)
                     if (row >= TILES_Z - 1) clipFlags |= CLIP_NEAR;
                 }
 
-                drawTile(screen,
-                         previousRow[colIdx], previousRow[colIdx + 1],
-                         currentRow[colIdx], currentRow[colIdx + 1],
+                const CornerData& topLeft = previousRow[colIdx];
+                const CornerData& topRight = previousRow[colIdx + 1];
+                const CornerData& bottomLeft = currentRow[colIdx];
+                const CornerData& bottomRight = currentRow[colIdx + 1];
+
+                // Unclipped tiles are batched into a strip so shared edges are
+                // only set up once. Anything else ends the run first, which
+                // keeps the left-to-right painter's order within the row.
+                if (clipFlags == CLIP_NONE && RasterConfig::terrainStrips) {
+                    if (topLeft.valid && topRight.valid &&
+                        bottomLeft.valid && bottomRight.valid) {
+                        addStripTile(topLeft, topRight, bottomLeft, bottomRight,
+                                     getTileColor(topLeft, topRight, bottomLeft, bottomRight,
+                                                  row, tileX, tileZ));
+                        frameStats.tilesDrawn++;
+                    } else {
+                        flushStrip(screen);
+                        frameStats.tilesCulled++;
+                    }
+                    continue;
+                }
+
+                flushStrip(screen);
+                drawTile(screen, topLeft, topRight, bottomLeft, bottomRight,
                          row, tileX, tileZ,
                          clipFlags, clipLeftX, clipRightX, clipNearZ, clipFarZ);
             }
+            flushStrip(screen);
 
             // Draw objects for this row (buffered by renderObjects())
             // Row mapping: render row R draws tiles for object buffer row R-1
@@ -405,6 +469,10 @@ void LandscapeRenderer::renderObjects(ScreenBuffer& screen, const Camera& camera
     // We use every 96 frames (~1.25 smoke/sec) for a more subtle effect
     smokeFrameCounter++;
 
+    // Objects as of the last frame boundary, so the simulation can change
+    // the live map while this reads
+    const ObjectMapSnapshot& objects = objectMap.getPublished();
+
     // Get camera position for relative coordinate calculation
     Fixed camX = camera.getX();
     Fixed camY = camera.getY();
@@ -464,7 +532,7 @@ void LandscapeRenderer::renderObjects(ScreenBuffer& screen, const Camera& camera
             uint8_t tileX = static_cast<uint8_t>(worldXInt);
             uint8_t tileZ = static_cast<uint8_t>(worldZInt);
 
-            uint8_t objectType = objectMap.getObjectAt(tileX, tileZ);
+            uint8_t objectType = objects.getObjectAt(tileX, tileZ);
 
             // Skip if no object at this tile
             if (objectType == ObjectType::NONE) {
@@ -19,6 +19,8 @@
 //
 // Renders the procedural terrain as a grid of quadrilateral tiles using the
 // painter's algorithm (back-to-front). Each tile is drawn as two triangles.
+// Runs of unclipped tiles within a row are drawn as a quad strip so that
+// edges shared by neighbouring triangles are only set up once.
 //
 // The rendering process:
 // 1. Position camera at back of landscape, looking forward
@@ -66,9 +68,6 @@ private:
     CornerData projectCorner(Fixed worldX, Fixed worldY, Fixed worldZ,
                              Fixed cameraX, Fixed cameraY, Fixed cameraZ);
 
-    // Project a corner using camera-relative coordinates directly
-    CornerData projectCornerRelative(Fixed relX, Fixed relY, Fixed relZ);
-
     // Edge flags for clipping
     static constexpr int CLIP_NONE = 0;
     static constexpr int CLIP_LEFT = 1;
@@ -87,8 +86,28 @@ private:
                   Fixed clipLeft = Fixed(), Fixed clipRight = Fixed(),
                   Fixed clipNear = Fixed(), Fixed clipFar = Fixed());
 
+    // Calculate the color of a tile from its corner altitudes
+    Color getTileColor(const CornerData& topLeft, const CornerData& topRight,
+                       const CornerData& bottomLeft, const CornerData& bottomRight,
+                       int tileRow, Fixed tileX, Fixed tileZ);
+
     // Determine tile type based on position
     TileType getTileType(Fixed x, Fixed z, Fixed altitude);
+
+    // Pending run of unclipped tiles in the current row
+    // stripTop/stripBottom hold stripCount + 1 corners
+    StripCorner stripTop[MAX_CORNERS];
+    StripCorner stripBottom[MAX_CORNERS];
+    Color stripColors[MAX_CORNERS];
+    int stripCount = 0;
+
+    // Add an unclipped tile to the pending strip (must continue the run)
+    void addStripTile(const CornerData& topLeft, const CornerData& topRight,
+                      const CornerData& bottomLeft, const CornerData& bottomRight,
+                      Color color);
+
+    // Draw and empty the pending strip
+    void flushStrip(ScreenBuffer& screen);
 };
 
 #endif // LANDSCAPE_RENDERER_H
@@ -1,12 +1,18 @@
 #include <SDL.h>
+#include <chrono>
+#include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <cmath>
 #include <algorithm>
+#include <future>
+#include <memory>
+#include <thread>
 #include "constants.h"
 #include "screen.h"
 #include "palette.h"
 #include "landscape_renderer.h"
+#include "graphics_buffer.h"
 #include "landscape.h"
 #include "camera.h"
 #include "player.h"
@@ -18,6 +24,17 @@
 #include "sound.h"
 #include "clipping.h"
 #include "settings.h"
+#include "frame_stats.h"
+#include "telemetry.h"
+#include "task_pool.h"
+#include "frame_output.h"
+#include "thread_config.h"
+#include "minimap.h"
+#include "world_chunks.h"
+#include "input_sampler.h"
+#include "flight_recorder.h"
+#include "stress.h"
+#include "cpu_dispatch.h"
 
 // =============================================================================
 // Lander - C++/SDL Port
@@ -36,6 +53,30 @@ namespace GameConfig {
     constexpr int INITIAL_LIVES = 3;
     constexpr int EXPLOSION_DURATION = 60;  // Frames for explosion animation (~0.5 sec at 120fps)
     constexpr int GAME_OVER_DELAY = 180;    // Frames before game restarts (~1.5 sec at 120fps)
+    constexpr int STARTUP_THREADS = 2;      // Workers for object placement and sound loading
+    constexpr float MUSIC_VOLUME = 0.4f;    // Background music, below the sound effects
+    constexpr int MINIMAP_X = 252;          // Top-left of the overview map (logical pixels)
+    constexpr int MINIMAP_Y = 24;
+    constexpr int WARM_UP_FRAMES = 3;       // Off-screen frames drawn before the window is shown
+    constexpr int TIMED_FRAMES = 120;       // Drawn frames averaged for the steady-state frame time
+}
+
+// Process start, for reporting startup times (static initialization runs
+// before main)
+static const std::chrono::steady_clock::time_point processStart = std::chrono::steady_clock::now();
+
+static double millisecondsSinceStart() {
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - processStart;
+    return elapsed.count();
+}
+
+// Apply the configured affinity and scheduling policy to the calling thread
+static void applyThreadPolicyWithLog(ThreadRole role) {
+    char error[256];
+    if (!applyThreadPolicy(role, error, sizeof(error))) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "%s thread policy not fully applied (%s)",
+                    getThreadRoleName(role), error);
+    }
 }
 
 class Game {
@@ -53,11 +94,60 @@ public:
         screenshotFilename = filename;
     }
 
+    // Stats mode: write the scene counters of every frame to a CSV file
+    void setStatsFile(FILE* file) {
+        statsFile = file;
+    }
+
+    // Telemetry: stream frame summaries to local collectors on a Unix socket
+    bool openTelemetry(const char* socketPath) {
+        return telemetry.open(socketPath);
+    }
+
+    // Flight recorder: dump the recent frame history when a frame takes
+    // longer than budgetMs, with a screenshot of it if screenshots is set
+    bool openFlightRecorder(const char* prefix, int budgetMs, bool screenshots) {
+        return flightRecorder.open(prefix, static_cast<uint32_t>(budgetMs) * 1000, screenshots, [] {
+            applyThreadPolicyWithLog(ThreadRole::Worker);
+        });
+    }
+
+    // Background music: stream a WAV track from disk on a loop
+    bool playMusic(const char* path) {
+        return sound.playMusic(path, GameConfig::MUSIC_VOLUME);
+    }
+
+    // Headless mode: no window, renderer or mouse capture (set before init)
+    void setHeadless() {
+        headless = true;
+    }
+
+    // Stress run: play a worst-case scenario headless for the given number
+    // of frames, then print a report (set before init)
+    void setStress(StressScenario scenario, int frames) {
+        stress = std::make_unique<StressScript>(scenario);
+        stressFrames = frames;
+        headless = true;
+    }
+
+    // Unbounded world: objects streamed in chunks instead of repeating every
+    // 256 tiles (set before init)
+    void setUnboundedWorld() {
+        chunkedWorld = std::make_unique<ChunkedWorld>(objectMap);
+    }
+
+    // Frame output: publish every frame into a shared-memory ring
+    bool openFrameOutput(const char* name) {
+        return frameOutput.open(name, ScreenBuffer::MAX_PHYSICAL_WIDTH,
+                                ScreenBuffer::MAX_PHYSICAL_HEIGHT);
+    }
+
 private:
     void handleEvents();
     void update(int mouseRelX, int mouseRelY, uint32_t mouseButtons);
     void render();
     void drawTestPattern();
+    uint64_t sceneKey() const;
     void bufferShip();
 
     SDL_Window* window = nullptr;
@@ -74,11 +164,55 @@ private:
     bool screenshotMode = false;
     const char* screenshotFilename = nullptr;
 
+    // Headless mode and shared-memory frame output
+    bool headless = false;
+    FrameOutput frameOutput;
+
+    // Scene counters of the last drawn frame (overlay and CSV dump)
+    FrameStats lastFrameStats;
+
+    // Key of the scene in the texture, to show it again when nothing changed
+    uint64_t lastSceneKey = 0;
+    bool lastSceneValid = false;
+    FILE* statsFile = nullptr;
+    uint64_t statsFrameNumber = 0;
+
+    // Telemetry endpoint and the stage timings of the current frame
+    TelemetryServer telemetry;
+    uint32_t stageMicros[TELEMETRY_STAGE_COUNT] = {};
+    Uint32 telemetryLastTime = 0;
+    void recordTelemetry(Uint64 frameStartCounter);
+
+    // Slow-frame flight recorder
+    FlightRecorder flightRecorder;
+    uint64_t frameNumber = 0;
+    void recordFlight(Uint64 frameStartCounter);
+
+    // Stress scenario (null in normal play) and its measurements
+    std::unique_ptr<StressScript> stress;
+    int stressFrames = 0;
+    StressReport stressReport;
+    void recordStress(Uint64 frameStartCounter);
+
+    // Prefault the drawing buffers and draw a few frames off-screen
+    void warmUp();
+
+    // First drawn frame against the steady state, timed after startup and
+    // after each resolution change (null label once logged)
+    const char* frameTimingLabel = "Startup";
+    uint32_t firstFrameMicros = 0;
+    uint64_t steadyFrameMicros = 0;
+    int timedFrames = 0;
+    void timeFrame(Uint64 frameStartCounter);
+
     // FPS counter
     Uint32 fpsLastTime = 0;
     int fpsFrameCount = 0;
     int fpsDisplay = 0;
 
+    // Mouse input as it arrived, split across each frame's physics ticks
+    InputSampler inputSampler;
+
     // Accumulated mouse position (simulates absolute positioning from relative movement)
     // Decays toward center each frame for spring-like return behavior
     int accumulatedMouseX = 0;
@@ -105,6 +239,9 @@ private:
     bool showFPS = true;   // Debug build: on by default
 #endif
 
+    // Scene stats panel above the FPS overlay (second Tab press)
+    bool showStats = false;
+
     // Sound system
     SoundSystem sound;
     int thrustHeldFrames = 0;  // How long thrust has been held (for filter effect)
@@ -128,6 +265,27 @@ private:
     // Pause state
     bool paused = false;
 
+    // Background startup work (object placement, sound loading)
+    std::unique_ptr<TaskPool> startupTasks;
+    bool firstFramePresented = false;
+
+    // World overview map (toggled with M)
+    std::unique_ptr<Minimap> minimap;
+    bool showMinimap = false;
+
+    // Unbounded world (null when the world wraps as in the original)
+    std::unique_ptr<ChunkedWorld> chunkedWorld;
+    WidePosition playerWide;
+
+    // Presentation mode and frame pacing state
+    PresentMode presentMode = PresentMode::VSync;
+    int refreshRate = 60;              // Display refresh rate (Hz)
+    Uint64 presentCompleted = 0;       // When the last SDL_RenderPresent returned
+    uint32_t presentBlockMicros = 0;   // How long the last SDL_RenderPresent blocked
+    Uint64 nextFrameDeadline = 0;      // Immediate mode frame schedule
+    Uint64 physicsCounter = 0;         // Paced mode: time physics has caught up to
+    Uint64 physicsRemainder = 0;       // Paced mode: fraction of a step (counter ticks x rate)
+
     // Helper methods
     void maybeSpawnRock();  // Check if we should spawn a falling rock
     void triggerCrash();
@@ -135,8 +293,13 @@ private:
     void resetGame();
     void updateResolution();  // Recreate texture for new resolution
     void saveCurrentSettings();  // Save settings to file
+    void setPresentMode(PresentMode mode);  // Switch vsync and frame pacing
+    void updateRefreshRate();    // Query the refresh rate of the window's display
+    int takePhysicsSteps(Uint64 now);     // Physics steps to run this frame
+    void limitFrameRate(Uint32 frameStart);  // Sleep until the next frame is due
 
     void drawFPS();
+    void drawStats();
     void drawScoreBar();
     void drawGameOver();
     void drawDigit(int x, int y, int digit, Color color);
@@ -158,21 +321,82 @@ bool Game::init() {
     GameConstants::landscapeScale = settings.landscapeScale;
     starsEnabled = settings.starsEnabled;
     highScore = settings.highScore;
+    RasterConfig::backend = (settings.rasterBackend == 1) ? RasterBackend::EdgeBlocks
+                                                          : RasterBackend::Scanline;
+    presentMode = static_cast<PresentMode>(settings.presentMode);
+    for (int role = 0; role < THREAD_ROLE_COUNT; role++) {
+        ThreadConfig::policies[role] = settings.threadPolicies[role];
+    }
+    applyThreadPolicyWithLog(ThreadRole::Main);
+
+    // A stress run flies the scripted ship in debug mode, so it can't crash
+    // out of the scenario, with fixed physics steps for every frame
+    if (stress) {
+        GameConstants::landscapeScale = stress->getLandscapeScale(GameConstants::landscapeScale);
+        starsEnabled = stress->getStars(starsEnabled);
+        presentMode = PresentMode::Immediate;
+        debugMode = true;
+    }
+
+    // Object placement and the overview map need nothing from SDL, so they
+    // run on a worker while the window and renderer are created
+    startupTasks = std::make_unique<TaskPool>(GameConfig::STARTUP_THREADS, [] {
+        applyThreadPolicyWithLog(ThreadRole::Worker);
+    });
+    minimap = std::make_unique<Minimap>(objectMap);
+    std::future<void> objectsPlaced = startupTasks->submit([this] {
+        if (chunkedWorld) {
+            playerWide.set(player.getPosition());
+            chunkedWorld->reset(playerWide);
+        } else {
+            placeObjectsOnMap();
+        }
+        minimap->build();
+    });
 
-    // Initialize SDL
-    if (SDL_Init(SDL_INIT_VIDEO) < 0) {
+    // Initialize SDL (headless only needs timers and the quit event)
+    Uint32 subsystems = headless ? (SDL_INIT_TIMER | SDL_INIT_EVENTS) : SDL_INIT_VIDEO;
+    if (SDL_Init(subsystems) < 0) {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_Init failed: %s", SDL_GetError());
         return false;
     }
 
-    // Create window
+    // Open the audio device here, then load the sounds on a worker. The game
+    // starts while they load, and each sound can play as soon as it is ready
+    if (sound.openDevice()) {
+        startupTasks->submit([this] {
+            sound.loadSounds();
+            SDL_Log("Sounds loaded %.1f ms after start", millisecondsSinceStart());
+        });
+    } else {
+        SDL_LogWarn(SDL_LOG_CATEGORY_AUDIO, "Sound system failed to initialize - continuing without audio");
+    }
+    sound.setEnabled(soundEnabled);
+
+    if (headless) {
+        running = true;
+        lastFrameTime = SDL_GetTicks();
+        camera.followTarget(player.getPosition(), false);
+        objectsPlaced.wait();
+        objectMap.setChangeCallback(Minimap::objectChanged, minimap.get());
+        warmUp();
+        if (stress) {
+            stress->start(objectMap);
+        }
+        SDL_Log("Lander initialized headless: %dx%d render @ %d FPS",
+                DisplayConfig::getPhysicalWidth(), DisplayConfig::getPhysicalHeight(),
+                FPS_OPTIONS[fpsIndex]);
+        return true;
+    }
+
+    // Create window (hidden until the warm-up frames are drawn)
     window = SDL_CreateWindow(
         WINDOW_TITLE,
         SDL_WINDOWPOS_CENTERED,
         SDL_WINDOWPOS_CENTERED,
         SCREEN_WIDTH,
         SCREEN_HEIGHT,
-        SDL_WINDOW_SHOWN | SDL_WINDOW_ALLOW_HIGHDPI | SDL_WINDOW_RESIZABLE
+        SDL_WINDOW_HIDDEN | SDL_WINDOW_ALLOW_HIGHDPI | SDL_WINDOW_RESIZABLE
     );
 
     if (!window) {
@@ -180,12 +404,12 @@ bool Game::init() {
         return false;
     }
 
-    // Create renderer
-    renderer = SDL_CreateRenderer(
-        window,
-        -1,
-        SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC
-    );
+    // Create renderer (immediate mode presents without waiting for vsync)
+    Uint32 rendererFlags = SDL_RENDERER_ACCELERATED;
+    if (presentMode != PresentMode::Immediate) {
+        rendererFlags |= SDL_RENDERER_PRESENTVSYNC;
+    }
+    renderer = SDL_CreateRenderer(window, -1, rendererFlags);
 
     if (!renderer) {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "SDL_CreateRenderer failed: %s", SDL_GetError());
@@ -221,14 +445,13 @@ bool Game::init() {
     // Enable relative mouse mode to capture the cursor
     SDL_SetRelativeMouseMode(SDL_TRUE);
 
-    // Initialize the object map with random objects
-    placeObjectsOnMap();
+    // Wait for the object map (placed on a worker), the first update needs it
+    // From here on the overview map follows every object that changes
+    objectsPlaced.wait();
+    objectMap.setChangeCallback(Minimap::objectChanged, minimap.get());
 
-    // Initialize sound system (uses loaded settings)
-    if (!sound.init()) {
-        SDL_LogWarn(SDL_LOG_CATEGORY_AUDIO, "Sound system failed to initialize - continuing without audio");
-    }
-    sound.setEnabled(soundEnabled);
+    warmUp();
+    SDL_ShowWindow(window);
 
     // Apply fullscreen if loaded from settings
     if (fullscreen) {
@@ -238,15 +461,30 @@ bool Game::init() {
     // Report status
     int drawW, drawH;
     SDL_GL_GetDrawableSize(window, &drawW, &drawH);
-    SDL_Log("Lander initialized: %dx%d render, %dx%d drawable @ %d FPS",
-            initWidth, initHeight, drawW, drawH, FPS_OPTIONS[fpsIndex]);
+    updateRefreshRate();
+    SDL_Log("Lander initialized: %dx%d render, %dx%d drawable @ %d FPS (%s, %d Hz)",
+            initWidth, initHeight, drawW, drawH, FPS_OPTIONS[fpsIndex],
+            PRESENT_MODE_NAMES[static_cast<int>(presentMode)], refreshRate);
 
 
     return true;
 }
 
 void Game::shutdown() {
+    // Let sound loading finish before the sound system goes away
+    startupTasks.reset();
     sound.shutdown();
+
+    // Finish any dump in progress
+    if (flightRecorder.isOpen()) {
+        flightRecorder.close();
+        SDL_Log("Flight recorder: %llu slow frames, %llu dumps written",
+                static_cast<unsigned long long>(flightRecorder.getSlowFrames()),
+                static_cast<unsigned long long>(flightRecorder.getDumpsWritten()));
+    }
+
+    // The object map outlives the game
+    objectMap.setChangeCallback(nullptr, nullptr);
     if (texture) {
         SDL_DestroyTexture(texture);
         texture = nullptr;
@@ -279,17 +517,37 @@ void Game::handleEvents() {
                     if (fullscreen != wasFullscreen) {
                         saveCurrentSettings();
                     }
+                    // The window may have moved to another display
+                    updateRefreshRate();
                 } else if (event.window.event == SDL_WINDOWEVENT_FOCUS_LOST) {
                     // Release mouse when window loses focus
                     SDL_SetRelativeMouseMode(SDL_FALSE);
                 }
                 break;
 
+            case SDL_RENDER_TARGETS_RESET:
+            case SDL_RENDER_DEVICE_RESET:
+                // The texture may have lost the last frame
+                lastSceneValid = false;
+                break;
+
+            case SDL_MOUSEMOTION:
+                // Only used while the mouse is captured
+                if (SDL_GetRelativeMouseMode() == SDL_TRUE) {
+                    inputSampler.addMotion(event.motion.timestamp, event.motion.xrel, event.motion.yrel);
+                }
+                break;
+
             case SDL_MOUSEBUTTONDOWN:
                 // Recapture mouse when clicking on window (after Cmd+Tab etc.)
                 if (SDL_GetRelativeMouseMode() == SDL_FALSE) {
                     SDL_SetRelativeMouseMode(SDL_TRUE);
                 }
+                inputSampler.pressButtons(event.button.timestamp, SDL_BUTTON(event.button.button));
+                break;
+
+            case SDL_MOUSEBUTTONUP:
+                inputSampler.releaseButtons(event.button.timestamp, SDL_BUTTON(event.button.button));
                 break;
 
             case SDL_KEYDOWN:
@@ -317,6 +575,7 @@ void Game::handleEvents() {
                     } else {
                         SDL_SetWindowFullscreen(window, 0);
                     }
+                    updateRefreshRate();
                     saveCurrentSettings();
                 } else if (event.key.keysym.sym == SDLK_d) {
                     debugMode = !debugMode;
@@ -325,7 +584,15 @@ void Game::handleEvents() {
                         player.setVelocity(Fixed(0), Fixed(0), Fixed(0));
                     }
                 } else if (event.key.keysym.sym == SDLK_TAB) {
-                    showFPS = !showFPS;
+                    // Cycle overlays: off -> settings bar -> settings bar + stats -> off
+                    if (!showFPS) {
+                        showFPS = true;
+                    } else if (!showStats) {
+                        showStats = true;
+                    } else {
+                        showFPS = false;
+                        showStats = false;
+                    }
                 } else if (event.key.keysym.sym == SDLK_1) {
                     // Cycle through landscape scales: 1 -> 2 -> 4 -> 8 -> 1
                     int scale = GameConstants::landscapeScale;
@@ -359,9 +626,27 @@ void Game::handleEvents() {
                     // Toggle stars on/off
                     starsEnabled = !starsEnabled;
                     saveCurrentSettings();
+                } else if (event.key.keysym.sym == SDLK_7) {
+                    // Toggle triangle rasterizer (scanline / edge blocks)
+                    if (RasterConfig::backend == RasterBackend::Scanline) {
+                        RasterConfig::backend = RasterBackend::EdgeBlocks;
+                    } else {
+                        RasterConfig::backend = RasterBackend::Scanline;
+                    }
+                    SDL_Log("Rasterizer: %s", RasterConfig::backend == RasterBackend::EdgeBlocks
+                                                  ? "edge blocks" : "scanline");
+                    saveCurrentSettings();
+                } else if (event.key.keysym.sym == SDLK_8) {
+                    // Cycle through presentation modes: vsync -> immediate -> paced -> vsync
+                    int mode = (static_cast<int>(presentMode) + 1) % PRESENT_MODE_COUNT;
+                    setPresentMode(static_cast<PresentMode>(mode));
+                    saveCurrentSettings();
                 } else if (event.key.keysym.sym == SDLK_p) {
                     // Toggle pause
                     paused = !paused;
+                } else if (event.key.keysym.sym == SDLK_m) {
+                    // Toggle the world overview map
+                    showMinimap = !showMinimap;
                 }
                 break;
         }
@@ -393,6 +678,10 @@ void Game::triggerCrash() {
 void Game::respawnPlayer() {
     // Reset player to launchpad
     player.reset();
+    playerWide.set(player.getPosition());
+    if (chunkedWorld) {
+        chunkedWorld->update(playerWide);
+    }
 
     // Reset landing state (start as LANDED on launchpad)
     landingState = LandingState::LANDED;
@@ -419,7 +708,13 @@ void Game::resetGame() {
     stateTimer = 0;
 
     // Restore all destroyed objects (in place, without re-rolling RNG)
-    objectMap.restoreDestroyedObjects();
+    // An unbounded world forgets its changes and streams the launchpad back in
+    playerWide.set(player.getPosition());
+    if (chunkedWorld) {
+        chunkedWorld->reset(playerWide);
+    } else {
+        objectMap.restoreDestroyedObjects();
+    }
 }
 
 void Game::updateResolution() {
@@ -442,6 +737,15 @@ void Game::updateResolution() {
     // Update logical size for proper scaling
     SDL_RenderSetLogicalSize(renderer, width, height);
 
+    // The new texture is empty, so the next frame is drawn in full
+    lastSceneValid = false;
+
+    // Time the first frames at the new resolution
+    frameTimingLabel = "Resolution change";
+    firstFrameMicros = 0;
+    steadyFrameMicros = 0;
+    timedFrames = 0;
+
     SDL_Log("Resolution changed to %dx%d (scale %d)", width, height, DisplayConfig::scale);
 }
 
@@ -454,9 +758,41 @@ void Game::saveCurrentSettings() {
     settings.soundEnabled = soundEnabled;
     settings.landscapeScale = GameConstants::landscapeScale;
     settings.starsEnabled = starsEnabled;
+    settings.highScore = highScore;
+    settings.rasterBackend = (RasterConfig::backend == RasterBackend::EdgeBlocks) ? 1 : 0;
+    settings.presentMode = static_cast<int>(presentMode);
+    for (int role = 0; role < THREAD_ROLE_COUNT; role++) {
+        settings.threadPolicies[role] = ThreadConfig::policies[role];
+    }
     saveSettings(settings);
 }
 
+void Game::setPresentMode(PresentMode mode) {
+    presentMode = mode;
+
+    // Restart the frame schedule and physics clock for the new mode
+    nextFrameDeadline = 0;
+    physicsCounter = 0;
+    physicsRemainder = 0;
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    SDL_RenderSetVSync(renderer, mode == PresentMode::Immediate ? 0 : 1);
+    SDL_Log("Presentation mode: %s", PRESENT_MODE_NAMES[static_cast<int>(mode)]);
+#else
+    SDL_Log("Presentation mode: %s (vsync change applies after restart)",
+            PRESENT_MODE_NAMES[static_cast<int>(mode)]);
+#endif
+}
+
+void Game::updateRefreshRate() {
+    SDL_DisplayMode mode;
+    if (window && SDL_GetWindowDisplayMode(window, &mode) == 0 && mode.refresh_rate > 0) {
+        refreshRate = mode.refresh_rate;
+    } else {
+        refreshRate = 60;  // Unknown: assume the most common rate
+    }
+}
+
 // =============================================================================
 // Rock Spawning
 // =============================================================================
@@ -519,6 +855,12 @@ void Game::maybeSpawnRock() {
 }
 
 void Game::update(int mouseRelX, int mouseRelY, uint32_t mouseButtons) {
+    // Keep the object map filled with the chunks around the player
+    if (chunkedWorld) {
+        playerWide.follow(player.getPosition());
+        chunkedWorld->update(playerWide);
+    }
+
     // Update particles every frame (including during explosions)
     particleSystem.update();
 
@@ -894,15 +1236,6 @@ int Game::drawNumber(int x, int y, int value, Color color) {
 }
 
 void Game::drawFPS() {
-    // Update FPS counter
-    fpsFrameCount++;
-    Uint32 currentTime = SDL_GetTicks();
-    if (currentTime - fpsLastTime >= 1000) {
-        fpsDisplay = fpsFrameCount;
-        fpsFrameCount = 0;
-        fpsLastTime = currentTime;
-    }
-
     Color white = Color::white();
     Color black = Color::black();
     int scale = DisplayConfig::scale;
@@ -948,6 +1281,95 @@ void Game::drawFPS() {
     screen.drawText(288, y, starsEnabled ? "STAR" : "star", white);
 }
 
+void Game::drawStats() {
+    // Scene counters of the last frame, in a panel above the settings bar
+    const FrameStats& stats = lastFrameStats;
+
+    Color white = Color::white();
+    Color black = Color::black();
+    int scale = DisplayConfig::scale;
+    constexpr int LINES = 7;
+    int top = 248 - LINES * 8;
+
+    // Draw black background behind the panel
+    int physWidth = DisplayConfig::getPhysicalWidth();
+    for (int row = 0; row < LINES * 8 * scale; row++) {
+        screen.drawHorizontalLine(0, physWidth - 1, top * scale + row, black);
+    }
+
+    int y = top;
+    int x;
+
+    // Landscape tiles: drawn / clipped / culled
+    x = screen.drawText(0, y, "TILE ", white);
+    x = screen.drawInt(x, y, stats.tilesDrawn, white);
+    x = screen.drawText(x, y, " CLIP ", white);
+    x = screen.drawInt(x, y, stats.tilesClipped, white);
+    x = screen.drawText(x, y, " CULL ", white);
+    screen.drawInt(x, y, stats.tilesCulled, white);
+    y += 8;
+
+    // Triangles: filled / buffered / dropped from full row buffers / off screen
+    x = screen.drawText(0, y, "TRI ", white);
+    x = screen.drawInt(x, y, stats.trianglesDrawn, white);
+    x = screen.drawText(x, y, " BUF ", white);
+    x = screen.drawInt(x, y, stats.trianglesBuffered, white);
+    x = screen.drawText(x, y, " DROP ", white);
+    x = screen.drawInt(x, y, stats.trianglesDropped, white);
+    x = screen.drawText(x, y, " OFF ", white);
+    screen.drawInt(x, y, stats.trianglesOffScreen, white);
+    y += 8;
+
+    // Pixels filled (in thousands, to fit 4x resolution)
+    x = screen.drawText(0, y, "PIX ", white);
+    x = screen.drawInt(x, y, static_cast<int>(stats.pixelsFilled / 1000), white);
+    screen.drawText(x, y, "K", white);
+    y += 8;
+
+    // Objects and shadows: drawn and culled, plus the busiest row buffer
+    int busiestRow = stats.getBusiestRow();
+    x = screen.drawText(0, y, "OBJ ", white);
+    x = screen.drawInt(x, y, stats.objectsDrawn, white);
+    x = screen.drawText(x, y, " SHAD ", white);
+    x = screen.drawInt(x, y, stats.shadowsDrawn, white);
+    x = screen.drawText(x, y, " CULL ", white);
+    x = screen.drawInt(x, y, stats.objectsCulled + stats.shadowsCulled, white);
+    x = screen.drawText(x, y, " ROW ", white);
+    x = screen.drawInt(x, y, busiestRow, white);
+    x = screen.drawText(x, y, ":", white);
+    screen.drawInt(x, y, stats.rowTriangles[busiestRow], white);
+    y += 8;
+
+    // Particles: total and rejected
+    x = screen.drawText(0, y, "PART ", white);
+    x = screen.drawInt(x, y, stats.getParticleTotal(), white);
+    x = screen.drawText(x, y, " REJ ", white);
+    screen.drawInt(x, y, stats.particlesRejected, white);
+    y += 8;
+
+    // Live particles by kind, labels cut to four characters to fit the line
+    x = 0;
+    for (int i = 0; i < PARTICLE_KIND_COUNT; i++) {
+        if (stats.particles[i] == 0) continue;
+        char label[5];
+        std::strncpy(label, getParticleKindName(static_cast<ParticleKind>(i)), 4);
+        label[4] = '\0';
+        x = screen.drawText(x, y, label, white);
+        x = screen.drawInt(x, y, stats.particles[i], white);
+        x += 8;
+    }
+    y += 8;
+
+    // Presentation mode, time blocked in the last present and refresh rate
+    x = screen.drawText(0, y, "PRES ", white);
+    x = screen.drawText(x, y, PRESENT_MODE_NAMES[static_cast<int>(presentMode)], white);
+    x = screen.drawText(x, y, " ", white);
+    x = screen.drawInt(x, y, static_cast<int>(presentBlockMicros), white);
+    x = screen.drawText(x, y, "us ", white);
+    x = screen.drawInt(x, y, refreshRate, white);
+    screen.drawText(x, y, "Hz", white);
+}
+
 
 void Game::drawScoreBar() {
     // Score bar at top of screen, matching original Lander layout:
@@ -964,16 +1386,7 @@ void Game::drawScoreBar() {
     if (score > highScore) {
         highScore = score;
         // Save high score immediately
-        GameSettings settings;
-        settings.scale = DisplayConfig::scale;
-        settings.fpsIndex = fpsIndex;
-        settings.fullscreen = fullscreen;
-        settings.smoothClipping = ClippingConfig::enabled;
-        settings.soundEnabled = soundEnabled;
-        settings.landscapeScale = GameConstants::landscapeScale;
-        settings.starsEnabled = starsEnabled;
-        settings.highScore = highScore;
-        saveSettings(settings);
+        saveCurrentSettings();
     }
 
     constexpr int CHAR_WIDTH = 8;  // 8 pixels per character at scale 1
@@ -1134,9 +1547,20 @@ void Game::drawTestPattern() {
     // This draws landscape tiles, buffered objects (including ship), and particles in depth order
     landscapeRenderer.render(screen, camera);
 
+    // Snapshot the scene counters before the HUD adds its own spans
+    collectParticleStats(frameStats);
+    lastFrameStats = frameStats;
+
     // Draw score bar at top of screen
     drawScoreBar();
 
+    // Overview map: a copy of the cached image, patched as objects change
+    if (showMinimap && minimap) {
+        const Vec3& position = player.getPosition();
+        minimap->draw(screen, GameConfig::MINIMAP_X, GameConfig::MINIMAP_Y,
+                      position.x.raw >> 24, position.z.raw >> 24);
+    }
+
     // Draw game over message if waiting for keypress
     if (gameState == GameState::GAME_OVER && waitingForKeypress) {
         drawGameOver();
@@ -1145,26 +1569,372 @@ void Game::drawTestPattern() {
     // Draw FPS overlay (toggled with Tab key)
     if (showFPS) {
         drawFPS();
+        if (showStats) {
+            drawStats();
+        }
     }
 }
 
+// Microseconds between two performance counter readings
+static uint32_t elapsedMicros(Uint64 start, Uint64 end) {
+    return static_cast<uint32_t>((end - start) * 1000000 / SDL_GetPerformanceFrequency());
+}
+
+// =============================================================================
+// Frame Reuse
+// =============================================================================
+//
+// With the ship landed and the engine off, or at game over, nothing on screen
+// moves and frame after frame comes out pixel-identical. Rather than redraw
+// them, render() keys each frame on everything the scene and HUD are drawn
+// from: the settings that change the picture, the camera, the ship, every
+// live particle, the object map's version and the HUD values. When the key
+// matches the frame already in the texture, rasterizing and the texture
+// upload are skipped and the texture is just presented again.
+//
+// The key is a hash, so a collision could in principle show a stale frame
+// until the next change; with 64 bits that is not a practical concern. The
+// stats panel (timings that change every frame) and the frame output (every
+// slot must be drawn) turn reuse off.
+//
+// =============================================================================
+
+// FNV-1a over 32-bit words
+struct SceneHash {
+    uint64_t value = 0xCBF29CE484222325ULL;
+
+    void add(uint32_t word) { value = (value ^ word) * 0x100000001B3ULL; }
+    void add(int32_t word) { add(static_cast<uint32_t>(word)); }
+    void add(Fixed f) { add(f.raw); }
+    void add(const Vec3& v) { add(v.x); add(v.y); add(v.z); }
+};
+
+uint64_t Game::sceneKey() const {
+    SceneHash hash;
+
+    // Settings that change what is drawn
+    hash.add(DisplayConfig::scale);
+    hash.add(GameConstants::landscapeScale);
+    hash.add(static_cast<uint32_t>(ClippingConfig::enabled));
+    hash.add(static_cast<uint32_t>(RasterConfig::backend));
+    hash.add(static_cast<uint32_t>(starsEnabled));
+
+    // Camera and ship
+    hash.add(camera.getPosition());
+    hash.add(player.getPosition());
+    for (const Vec3& axis : player.getRotationMatrix().col) {
+        hash.add(axis);
+    }
+
+    // Particles (stars fade with their lifespan)
+    int count = particleSystem.getParticleCount();
+    hash.add(count);
+    for (int i = 0; i < count; i++) {
+        const Particle& particle = particleSystem.getParticle(i);
+        hash.add(particle.position);
+        hash.add(particle.lifespan);
+        hash.add(particle.flags);
+        hash.add(particle.initialLifespan);
+        hash.add(static_cast<uint32_t>(particle.starSize << 8 | particle.starBrightness));
+    }
+
+    // Objects
+    hash.add(objectMap.getPublished().getVersion());
+
+    // HUD
+    hash.add(score);
+    hash.add(highScore);
+    hash.add(lives);
+    hash.add(player.getFuelLevel());
+    hash.add(static_cast<uint32_t>(paused));
+    hash.add(static_cast<uint32_t>(gameState));
+    hash.add(static_cast<uint32_t>(waitingForKeypress));
+    hash.add(static_cast<uint32_t>(showMinimap));
+    hash.add(static_cast<uint32_t>(showFPS));
+    if (showFPS) {
+        hash.add(fpsIndex);
+        hash.add(fpsDisplay);
+        hash.add(static_cast<uint32_t>(soundEnabled));
+    }
+
+    return hash.value;
+}
+
 void Game::render() {
-    // Draw test pattern (will be replaced with actual game rendering)
-    drawTestPattern();
+    Uint64 sceneStart = SDL_GetPerformanceCounter();
+
+    // Count presented frames for the FPS overlay, drawn or reused
+    fpsFrameCount++;
+    Uint32 currentTime = SDL_GetTicks();
+    if (currentTime - fpsLastTime >= 1000) {
+        fpsDisplay = fpsFrameCount;
+        fpsFrameCount = 0;
+        fpsLastTime = currentTime;
+    }
+
+    // Show the last frame again if nothing in it has changed
+    uint64_t key = sceneKey();
+    bool reuse = lastSceneValid && key == lastSceneKey && !showStats && !frameOutput.isOpen() && !stress;
+    lastSceneKey = key;
+    lastSceneValid = !showStats && !frameOutput.isOpen() && !stress;
+
+    if (reuse) {
+        collectParticleStats(frameStats);
+        frameStats.frameReused = 1;
+        lastFrameStats = frameStats;
+    } else {
+        // When publishing frames, draw straight into the next shared-memory slot
+        if (frameOutput.isOpen()) {
+            screen.setTarget(frameOutput.beginFrame());
+        }
+
+        // Draw test pattern (will be replaced with actual game rendering)
+        drawTestPattern();
+    }
+
+    Uint64 presentStart = SDL_GetPerformanceCounter();
+    stageMicros[static_cast<int>(TelemetryStage::Scene)] = elapsedMicros(sceneStart, presentStart);
+
+    if (frameOutput.isOpen()) {
+        frameOutput.publish(DisplayConfig::getPhysicalWidth(), DisplayConfig::getPhysicalHeight());
+    }
+
+    if (headless) {
+        presentCompleted = SDL_GetPerformanceCounter();
+        presentBlockMicros = 0;
+        stageMicros[static_cast<int>(TelemetryStage::Present)] =
+            elapsedMicros(presentStart, presentCompleted);
+        return;
+    }
 
     // Update texture with screen buffer contents
     // Use max pitch since buffer stride is always max width
-    SDL_UpdateTexture(texture, nullptr, screen.getData(), ScreenBuffer::getPitch());
+    if (!reuse) {
+        SDL_UpdateTexture(texture, nullptr, screen.getData(), ScreenBuffer::getPitch());
+    }
 
     // Clear and draw texture (SDL scales to fill window via logical size)
     SDL_RenderClear(renderer);
     SDL_RenderCopy(renderer, texture, nullptr, nullptr);
+
+    // Measure how long present blocks (waiting for vsync in vsync/paced modes)
+    Uint64 presentCall = SDL_GetPerformanceCounter();
     SDL_RenderPresent(renderer);
+    presentCompleted = SDL_GetPerformanceCounter();
+    presentBlockMicros = elapsedMicros(presentCall, presentCompleted);
+
+    if (!firstFramePresented) {
+        firstFramePresented = true;
+        SDL_Log("First frame presented %.1f ms after start", millisecondsSinceStart());
+    }
+
+    stageMicros[static_cast<int>(TelemetryStage::Present)] =
+        elapsedMicros(presentStart, presentCompleted);
+}
+
+int Game::takePhysicsSteps(Uint64 now) {
+    // Fixed steps per frame, unless the display paces the frames
+    if (presentMode != PresentMode::Paced) {
+        return PHYSICS_SCALE[fpsIndex];
+    }
+
+    // Paced: run as many 120fps steps as real time has passed
+    Uint64 frequency = SDL_GetPerformanceFrequency();
+    if (physicsCounter == 0) {
+        physicsCounter = now;
+        return PHYSICS_SCALE[fpsIndex];
+    }
+    physicsRemainder += (now - physicsCounter) * PHYSICS_RATE;
+    physicsCounter = now;
+
+    Uint64 steps = physicsRemainder / frequency;
+    physicsRemainder -= steps * frequency;
+    if (steps > MAX_PHYSICS_STEPS) {
+        steps = MAX_PHYSICS_STEPS;
+        physicsRemainder = 0;
+    }
+    return static_cast<int>(steps);
+}
+
+void Game::limitFrameRate(Uint32 frameStart) {
+    int targetFPS = FPS_OPTIONS[fpsIndex];
+    Uint64 frequency = SDL_GetPerformanceFrequency();
+    Uint64 now = SDL_GetPerformanceCounter();
+
+    // Headless frames are never held back by a present, so they always
+    // follow the fixed schedule
+    if (presentMode == PresentMode::Immediate || headless) {
+        // Fixed schedule: each frame is due one period after the previous
+        // one was due, so sleep rounding doesn't accumulate
+        Uint64 period = frequency / targetFPS;
+        nextFrameDeadline = (nextFrameDeadline == 0) ? now + period : nextFrameDeadline + period;
+        if (now >= nextFrameDeadline) {
+            // Fell behind: start a new schedule instead of rushing to catch up
+            nextFrameDeadline = now;
+            return;
+        }
+
+        // Headless frames aren't shown against a display deadline, so a
+        // fraction of a millisecond early is fine (the schedule doesn't drift)
+        Uint32 remainingMs = static_cast<Uint32>((nextFrameDeadline - now) * 1000 / frequency);
+        if (headless) {
+            SDL_Delay(remainingMs);
+            return;
+        }
+
+        // Sleep most of the way, then to the deadline in short sleeps; each
+        // may overshoot by the timer slack, which is accepted as jitter
+        if (remainingMs > 1) {
+            SDL_Delay(remainingMs - 1);
+        }
+        for (now = SDL_GetPerformanceCounter(); now < nextFrameDeadline; now = SDL_GetPerformanceCounter()) {
+            Uint64 remainingMicros = (nextFrameDeadline - now) * 1000000 / frequency;
+            Uint64 sleepMicros = std::min<Uint64>(std::max<Uint64>(remainingMicros, 1), FRAME_SLEEP_MICROS);
+            std::this_thread::sleep_for(std::chrono::microseconds(sleepMicros));
+        }
+        return;
+    }
+
+    if (presentMode == PresentMode::Paced) {
+        // The next present returns on the first vertical blank after it is
+        // issued. To show a frame every N refresh intervals, wait until N-1
+        // intervals after the last present completed before starting it
+        Uint64 refreshPeriod = frequency / refreshRate;
+        Uint64 targetPeriod = frequency / targetFPS;
+        Uint64 intervals = (targetPeriod + refreshPeriod / 2) / refreshPeriod;
+        if (intervals < 1) intervals = 1;
+        Uint64 wake = presentCompleted + (intervals - 1) * refreshPeriod;
+        if (wake > now) {
+            SDL_Delay(static_cast<Uint32>((wake - now) * 1000 / frequency));
+        }
+        return;
+    }
+
+    // VSync: sleep for whatever is left of the target frame time
+    Uint32 frameTime = SDL_GetTicks() - frameStart;
+    Uint32 targetFrameTime = FRAME_TIME_MS_LOOKUP[fpsIndex];
+    if (frameTime < targetFrameTime) {
+        SDL_Delay(targetFrameTime - frameTime);
+    }
+}
+
+void Game::recordTelemetry(Uint64 frameStartCounter) {
+    Uint64 now = SDL_GetPerformanceCounter();
+    telemetry.recordFrame(elapsedMicros(frameStartCounter, now), stageMicros, lastFrameStats);
+
+    // Publish a summary once a second
+    Uint32 currentTime = SDL_GetTicks();
+    if (currentTime - telemetryLastTime >= 1000) {
+        TelemetryStatus status;
+        status.displayScale = DisplayConfig::scale;
+        status.landscapeScale = GameConstants::landscapeScale;
+        status.targetFPS = FPS_OPTIONS[fpsIndex];
+        status.stars = starsEnabled;
+        status.clipping = ClippingConfig::enabled;
+        status.sound = soundEnabled;
+        status.presentMode = PRESENT_MODE_NAMES[static_cast<int>(presentMode)];
+        status.audioVoices = sound.getActiveVoiceCount();
+        status.audioLateCallbacks = sound.getLateCallbackCount();
+        telemetry.publish(status);
+        telemetryLastTime = currentTime;
+    }
+}
+
+void Game::recordFlight(Uint64 frameStartCounter) {
+    FlightFrame frame;
+    frame.frame = frameNumber;
+    frame.frameMicros = elapsedMicros(frameStartCounter, SDL_GetPerformanceCounter());
+    for (int i = 0; i < TELEMETRY_STAGE_COUNT; i++) {
+        frame.stageMicros[i] = stageMicros[i];
+    }
+    frame.camera = camera.getPosition();
+    frame.audioVoices = sound.getActiveVoiceCount();
+    frame.stats = lastFrameStats;
+    flightRecorder.record(frame, &screen);
+}
+
+void Game::recordStress(Uint64 frameStartCounter) {
+    stressReport.addFrame(elapsedMicros(frameStartCounter, SDL_GetPerformanceCounter()), lastFrameStats);
+    if (stressReport.getFrameCount() < stressFrames) {
+        return;
+    }
+
+    running = false;
+    stressReport.print(stdout, getStressScenarioName(stress->getScenario()),
+                       DisplayConfig::getPhysicalWidth(), DisplayConfig::getPhysicalHeight(),
+                       TILES_X, TILES_Z);
+}
+
+// =============================================================================
+// Warm-Up
+// =============================================================================
+//
+// Left alone, the first frames after startup are several times slower than
+// the rest: the scratch buffers of the rasterizer and the row buffers fault
+// in page by page as they first fill, and the rendering code and its tables
+// are cold. So before the window is shown, warmUp() touches those buffers at
+// full capacity and draws a few frames off-screen (into the screen buffer,
+// which the first real frame overwrites). Drawing spins the falling rocks, so
+// their angle is put back afterwards; the smoke cadence of destroyed objects
+// moves on a few frames, but none are destroyed yet.
+//
+// The log reports how long the first drawn frame took against the mean of
+// the drawn frames after it (not counting the wait in present), at startup
+// and after each resolution change, so the effect can be measured.
+//
+// =============================================================================
+
+void Game::warmUp() {
+    Uint64 start = SDL_GetPerformanceCounter();
+
+    screen.prefault();
+    graphicsBuffers.prefault();
+    int32_t rockAngle = getRockRotationAngle();
+    for (int i = 0; i < GameConfig::WARM_UP_FRAMES; i++) {
+        drawTestPattern();
+    }
+    setRockRotationAngle(rockAngle);
+
+    // Upload once too, so the texture's storage is allocated now
+    if (texture) {
+        SDL_UpdateTexture(texture, nullptr, screen.getData(), ScreenBuffer::getPitch());
+    }
+
+    // The warm-up frames don't count in any stats
+    frameStats.reset();
+    lastFrameStats = frameStats;
+
+    SDL_Log("Warm-up: %d frames in %.1f ms", GameConfig::WARM_UP_FRAMES,
+            elapsedMicros(start, SDL_GetPerformanceCounter()) / 1000.0);
+}
+
+void Game::timeFrame(Uint64 frameStartCounter) {
+    // Only drawn frames compare (a reused frame does almost nothing)
+    if (lastFrameStats.frameReused) {
+        return;
+    }
+    uint32_t micros = elapsedMicros(frameStartCounter, SDL_GetPerformanceCounter());
+    micros -= std::min(micros, presentBlockMicros);
+
+    if (timedFrames == 0) {
+        firstFrameMicros = micros;
+    } else {
+        steadyFrameMicros += micros;
+    }
+    if (++timedFrames <= GameConfig::TIMED_FRAMES) {
+        return;
+    }
+
+    SDL_Log("%s: first frame %.2f ms, steady state %.2f ms (mean of the next %d)",
+            frameTimingLabel, firstFrameMicros / 1000.0,
+            steadyFrameMicros / 1000.0 / GameConfig::TIMED_FRAMES, GameConfig::TIMED_FRAMES);
+    frameTimingLabel = nullptr;
 }
 
 void Game::run() {
     // Screenshot mode: render one frame and exit
     if (screenshotMode) {
+        frameStats.reset();
         drawTestPattern();
         if (screen.savePNG(screenshotFilename)) {
             SDL_Log("Screenshot saved to: %s", screenshotFilename);
@@ -1177,39 +1947,77 @@ void Game::run() {
     // Normal game loop
     while (running) {
         Uint32 frameStart = SDL_GetTicks();
+        Uint64 frameStartCounter = SDL_GetPerformanceCounter();
+
+        // Counters cover the whole frame, including particles rejected during update
+        frameStats.reset();
 
         // Handle events once per frame (not per physics step)
         handleEvents();
 
-        // Get mouse input once per frame (before physics loop)
-        // SDL_GetRelativeMouseState returns accumulated movement since last call
-        // Only use mouse input when mouse is captured
-        int relX = 0, relY = 0;
-        uint32_t mouseButtons = SDL_GetRelativeMouseState(&relX, &relY);
+        // Mouse input is only used when the mouse is captured
+        Uint32 inputTime = SDL_GetTicks();
         if (SDL_GetRelativeMouseMode() == SDL_FALSE) {
-            relX = 0;
-            relY = 0;
-            mouseButtons = 0;
+            inputSampler.reset(inputTime);
+        }
+
+        // A stress scenario places the ship and holds its buttons instead
+        if (stress) {
+            StressFrame scripted = stress->step(static_cast<int>(frameNumber), objectMap);
+            player.setPosition(scripted.shipPosition);
+            player.setFuelLevel(PlayerConstants::MAX_FUEL);
+            inputSampler.pressButtons(inputTime, scripted.buttons);
         }
 
         // Run physics multiple times per frame at lower FPS
         // This keeps physics consistent regardless of frame rate
         // Skip update when paused
+        Uint64 updateStart = SDL_GetPerformanceCounter();
+        int physicsSteps = takePhysicsSteps(frameStartCounter);
         if (!paused) {
-            int physicsScale = PHYSICS_SCALE[fpsIndex];
-            for (int i = 0; i < physicsScale; i++) {
-                // On first iteration, pass the mouse delta; on subsequent ones, pass 0
-                // This ensures mouse movement is only applied once per frame
-                update(i == 0 ? relX : 0, i == 0 ? relY : 0, mouseButtons);
+            // Each tick gets the mouse input that arrived during its share
+            // of the time since the last frame's ticks
+            inputSampler.splitTicks(inputTime, physicsSteps);
+
+            // Sounds made during a tick start at that tick's time
+            sound.beginTicks();
+            for (int i = 0; i < physicsSteps; i++) {
+                sound.setTick(i);
+                const TickInput& input = inputSampler.getTick(i);
+                update(input.dx, input.dy, input.buttons);
             }
+            sound.endTicks();
+        } else {
+            inputSampler.discard(inputTime);
         }
+        stageMicros[static_cast<int>(TelemetryStage::Update)] =
+            elapsedMicros(updateStart, SDL_GetPerformanceCounter());
+
+        // The frame is drawn from the objects as they are now
+        objectMap.publish();
         render();
+        if (frameTimingLabel) {
+            timeFrame(frameStartCounter);
+        }
 
-        // Frame rate limiting based on target FPS
-        Uint32 frameTime = SDL_GetTicks() - frameStart;
-        Uint32 targetFrameTime = FRAME_TIME_MS_LOOKUP[fpsIndex];
-        if (frameTime < targetFrameTime) {
-            SDL_Delay(targetFrameTime - frameTime);
+        if (statsFile) {
+            writeFrameStatsRow(statsFile, statsFrameNumber++, lastFrameStats);
+        }
+        if (telemetry.isOpen()) {
+            recordTelemetry(frameStartCounter);
+        }
+        if (flightRecorder.isOpen()) {
+            recordFlight(frameStartCounter);
+        }
+        if (stress) {
+            recordStress(frameStartCounter);
+        }
+        frameNumber++;
+
+        // Frame rate limiting based on target FPS and presentation mode
+        // (a stress run goes as fast as it can)
+        if (!stress) {
+            limitFrameRate(frameStart);
         }
     }
 }
@@ -1219,12 +2027,70 @@ int main(int argc, char* argv[]) {
 
     // Parse command line arguments
     const char* screenshotFile = nullptr;
+    const char* statsFileName = nullptr;
+    const char* telemetryPath = nullptr;
+    const char* frameOutputName = nullptr;
+    const char* musicFile = nullptr;
+    const char* flightPrefix = nullptr;
+    int slowFrameMs = 50;
+    bool slowFrameScreenshots = false;
+    bool stressRun = false;
+    StressScenario stressScenario = StressScenario::Rocks;
+    int stressFrames = 900;
+    CpuLevel cpuLevel = CpuLevel::AVX512;
+    bool cpuLevelForced = false;
     for (int i = 1; i < argc; i++) {
         if (std::strcmp(argv[i], "--screenshot") == 0 && i + 1 < argc) {
             screenshotFile = argv[++i];
+        } else if (std::strcmp(argv[i], "--stats-csv") == 0 && i + 1 < argc) {
+            statsFileName = argv[++i];
+        } else if (std::strcmp(argv[i], "--telemetry") == 0 && i + 1 < argc) {
+            telemetryPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--frame-output") == 0 && i + 1 < argc) {
+            frameOutputName = argv[++i];
+        } else if (std::strcmp(argv[i], "--music") == 0 && i + 1 < argc) {
+            musicFile = argv[++i];
+        } else if (std::strcmp(argv[i], "--flight-recorder") == 0 && i + 1 < argc) {
+            flightPrefix = argv[++i];
+        } else if (std::strcmp(argv[i], "--slow-frame-ms") == 0 && i + 1 < argc) {
+            slowFrameMs = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--slow-frame-screenshots") == 0) {
+            slowFrameScreenshots = true;
+        } else if (std::strcmp(argv[i], "--headless") == 0) {
+            game.setHeadless();
+        } else if (std::strcmp(argv[i], "--unbounded") == 0) {
+            game.setUnboundedWorld();
+        } else if (std::strcmp(argv[i], "--stress") == 0 && i + 1 < argc) {
+            if (!findStressScenario(argv[++i], stressScenario)) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unknown stress scenario: %s", argv[i]);
+                return EXIT_FAILURE;
+            }
+            stressRun = true;
+        } else if (std::strcmp(argv[i], "--stress-frames") == 0 && i + 1 < argc) {
+            stressFrames = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--cpu-level") == 0 && i + 1 < argc) {
+            if (!CpuDispatch::findLevel(argv[++i], cpuLevel)) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unknown CPU level: %s", argv[i]);
+                return EXIT_FAILURE;
+            }
+            cpuLevelForced = true;
         }
     }
 
+    // Bind the kernels of the best CPU level (or of the one asked for)
+    // before anything runs them
+    CpuLevel boundLevel = CpuDispatch::select(cpuLevel);
+    if (cpuLevelForced && boundLevel != cpuLevel) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION, "CPU level %s not available, using %s",
+                    CpuDispatch::getLevelName(cpuLevel), CpuDispatch::getLevelName(boundLevel));
+    }
+    SDL_Log("CPU kernels: %s (detected %s)", CpuDispatch::getLevelName(boundLevel),
+            CpuDispatch::getLevelName(CpuDispatch::detect()));
+
+    if (stressRun) {
+        game.setStress(stressScenario, stressFrames);
+    }
+
     if (!game.init()) {
         return EXIT_FAILURE;
     }
@@ -1233,7 +2099,50 @@ int main(int argc, char* argv[]) {
         game.setScreenshotMode(screenshotFile);
     }
 
+    if (musicFile && !screenshotFile) {
+        game.playMusic(musicFile);
+    }
+
+    FILE* statsFile = nullptr;
+    if (statsFileName) {
+        statsFile = std::fopen(statsFileName, "w");
+        if (statsFile) {
+            writeFrameStatsHeader(statsFile);
+            game.setStatsFile(statsFile);
+        } else {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to open stats file: %s", statsFileName);
+        }
+    }
+
+    if (telemetryPath) {
+        if (game.openTelemetry(telemetryPath)) {
+            SDL_Log("Telemetry listening on: %s", telemetryPath);
+        } else {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to open telemetry socket: %s", telemetryPath);
+        }
+    }
+
+    if (frameOutputName) {
+        if (game.openFrameOutput(frameOutputName)) {
+            SDL_Log("Publishing frames to shared memory: %s", frameOutputName);
+        } else {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to open frame output: %s", frameOutputName);
+        }
+    }
+
+    if (flightPrefix && !screenshotFile) {
+        if (game.openFlightRecorder(flightPrefix, slowFrameMs, slowFrameScreenshots)) {
+            SDL_Log("Recording frames over %d ms to: %s-<frame>.csv", slowFrameMs, flightPrefix);
+        } else {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to start flight recorder: %s", flightPrefix);
+        }
+    }
+
     game.run();
 
+    if (statsFile) {
+        std::fclose(statsFile);
+    }
+
     return EXIT_SUCCESS;
 }
@@ -1,4 +1,5 @@
 #include "math3d.h"
+#include "fixed_simd.h"
 
 // =============================================================================
 // Rotation Matrix Calculation
@@ -83,6 +84,54 @@ Mat3x3 calculateRotationMatrix(int32_t angleA, int32_t angleB) {
     );
 }
 
+// =============================================================================
+// Batch Transform
+// =============================================================================
+//
+// Points are gathered a pack at a time into one array per coordinate, so
+// each matrix element multiplies a whole pack of coordinates. A short last
+// pack is padded with zeros and only its real points are written back.
+//
+// =============================================================================
+
+void transformPoints(const Mat3x3& m, const Vec3* in, Vec3* out, int count) {
+    constexpr int LANES = FixedPack::LANES;
+
+    const FixedPack m00 = FixedPack::splat(m.col[0].x.raw);
+    const FixedPack m01 = FixedPack::splat(m.col[1].x.raw);
+    const FixedPack m02 = FixedPack::splat(m.col[2].x.raw);
+    const FixedPack m10 = FixedPack::splat(m.col[0].y.raw);
+    const FixedPack m11 = FixedPack::splat(m.col[1].y.raw);
+    const FixedPack m12 = FixedPack::splat(m.col[2].y.raw);
+    const FixedPack m20 = FixedPack::splat(m.col[0].z.raw);
+    const FixedPack m21 = FixedPack::splat(m.col[1].z.raw);
+    const FixedPack m22 = FixedPack::splat(m.col[2].z.raw);
+
+    for (int first = 0; first < count; first += LANES) {
+        int lanes = (count - first < LANES) ? count - first : LANES;
+
+        int32_t xs[LANES] = {};
+        int32_t ys[LANES] = {};
+        int32_t zs[LANES] = {};
+        for (int i = 0; i < lanes; i++) {
+            xs[i] = in[first + i].x.raw;
+            ys[i] = in[first + i].y.raw;
+            zs[i] = in[first + i].z.raw;
+        }
+
+        FixedPack x = FixedPack::load(xs);
+        FixedPack y = FixedPack::load(ys);
+        FixedPack z = FixedPack::load(zs);
+        (m00 * x + m01 * y + m02 * z).store(xs);
+        (m10 * x + m11 * y + m12 * z).store(ys);
+        (m20 * x + m21 * y + m22 * z).store(zs);
+
+        for (int i = 0; i < lanes; i++) {
+            out[first + i] = Vec3(Fixed::fromRaw(xs[i]), Fixed::fromRaw(ys[i]), Fixed::fromRaw(zs[i]));
+        }
+    }
+}
+
 // =============================================================================
 // Fixed-point multiplication utility
 // =============================================================================
@@ -164,6 +164,18 @@ struct Mat3x3 {
 
 Mat3x3 calculateRotationMatrix(int32_t angleA, int32_t angleB);
 
+// =============================================================================
+// Batch Transform
+// =============================================================================
+//
+// Rotate count points by a matrix: out[i] = m * in[i], several points at a
+// time with the packed fixed-point kernels (fixed_simd.h). The results are
+// identical to Mat3x3::operator*. in and out may be the same array.
+//
+// =============================================================================
+
+void transformPoints(const Mat3x3& m, const Vec3* in, Vec3* out, int count);
+
 // =============================================================================
 // Utility Functions
 // =============================================================================
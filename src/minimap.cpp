@@ -0,0 +1,193 @@
+// minimap.cpp
+// Overview map of the whole world for the HUD
+
+#include "minimap.h"
+#include "landscape.h"
+#include <cstring>
+
+// =============================================================================
+// Palette
+// =============================================================================
+
+namespace MinimapPalette {
+
+Color getColor(uint8_t index)
+{
+    switch (index) {
+        case SEA:       return Color(16, 48, 160);
+        case LAUNCHPAD: return Color(136, 136, 136);
+        case TREE:      return Color(0, 64, 0);
+        case BUILDING:  return Color(240, 240, 240);
+        case ROCKET:    return Color(255, 200, 0);
+        case DESTROYED: return Color(255, 32, 0);
+        default:
+            break;
+    }
+
+    // Land runs from green at the shore to light brown on the peaks
+    int shade = index - LAND;
+    if (shade < 0 || shade >= LAND_SHADES) {
+        return Color::black();
+    }
+    return Color(static_cast<uint8_t>(32 + shade * 5),
+                 static_cast<uint8_t>(112 + shade * 2),
+                 static_cast<uint8_t>(16 + shade * 2));
+}
+
+uint8_t getObjectIndex(uint8_t objectType)
+{
+    if (objectType == ObjectType::NONE) {
+        return 0;
+    }
+    if (ObjectMap::isDestroyedType(objectType)) {
+        return DESTROYED;
+    }
+    switch (objectType) {
+        case ObjectType::PYRAMID:
+        case ObjectType::GAZEBO:
+        case ObjectType::BUILDING:
+            return BUILDING;
+        case ObjectType::ROCKET:
+        case ObjectType::ROCKET_2:
+        case ObjectType::ROCKET_3:
+            return ROCKET;
+        default:
+            return TREE;
+    }
+}
+
+} // namespace MinimapPalette
+
+// =============================================================================
+// Minimap Implementation
+// =============================================================================
+
+// Land shades step every 1/8 tile of height above the sea
+static constexpr int LAND_SHADE_SHIFT = 21;
+
+void Minimap::build()
+{
+    using namespace GameConstants;
+
+    for (int z = 0; z < TILES; z++) {
+        for (int x = 0; x < TILES; x++) {
+            // Altitudes grow downwards; sea and launchpad are exact levels
+            Fixed altitude = getLandscapeAltitudeAtTile(x, z);
+            uint8_t index;
+            if (altitude == SEA_LEVEL) {
+                index = MinimapPalette::SEA;
+            } else if (altitude == LAUNCHPAD_ALTITUDE) {
+                index = MinimapPalette::LAUNCHPAD;
+            } else {
+                int shade = (SEA_LEVEL - altitude).raw >> LAND_SHADE_SHIFT;
+                if (shade < 0) shade = 0;
+                if (shade >= MinimapPalette::LAND_SHADES) shade = MinimapPalette::LAND_SHADES - 1;
+                index = static_cast<uint8_t>(MinimapPalette::LAND + shade);
+            }
+            terrain[z][x] = index;
+
+            uint8_t object = MinimapPalette::getObjectIndex(
+                objects.getObjectAt(static_cast<uint8_t>(x), static_cast<uint8_t>(z)));
+            texels[z][x] = object ? object : index;
+        }
+    }
+
+    built = true;
+    buildCount++;
+
+    // The image is resolved again on the next draw
+    imageScale = 0;
+}
+
+void Minimap::onTileChanged(uint8_t tileX, uint8_t tileZ)
+{
+    if (!built) {
+        return;
+    }
+
+    uint8_t object = MinimapPalette::getObjectIndex(objects.getObjectAt(tileX, tileZ));
+    uint8_t texel = object ? object : terrain[tileZ][tileX];
+    if (texel == texels[tileZ][tileX]) {
+        return;
+    }
+    texels[tileZ][tileX] = texel;
+
+    if (imageScale != 0) {
+        updatePixel(tileX, tileZ);
+    }
+}
+
+void Minimap::objectChanged(void* context, uint8_t tileX, uint8_t tileZ)
+{
+    static_cast<Minimap*>(context)->onTileChanged(tileX, tileZ);
+}
+
+void Minimap::updatePixel(int tileX, int tileZ)
+{
+    int size = getImageSize();
+    int tiles = getTilesPerPixel();
+    int px = tileX / tiles;
+    int py = (TILES - 1 - tileZ) / tiles;
+
+    // The pixel shows the most important texel in its block of tiles
+    int x0 = px * tiles;
+    int z0 = TILES - (py + 1) * tiles;
+    uint8_t best = 0;
+    for (int z = z0; z < z0 + tiles; z++) {
+        for (int x = x0; x < x0 + tiles; x++) {
+            if (texels[z][x] > best) best = texels[z][x];
+        }
+    }
+    pixels[py * size + px] = MinimapPalette::getColor(best);
+}
+
+void Minimap::buildImage()
+{
+    imageScale = DisplayConfig::scale;
+    int tiles = getTilesPerPixel();
+    for (int z = 0; z < TILES; z += tiles) {
+        for (int x = 0; x < TILES; x += tiles) {
+            updatePixel(x, z);
+        }
+    }
+    imageBuildCount++;
+}
+
+void Minimap::draw(ScreenBuffer& screen, int x, int y, int playerTileX, int playerTileZ)
+{
+    if (!built) {
+        return;
+    }
+    if (imageScale != DisplayConfig::scale) {
+        buildImage();
+    }
+
+    int size = getImageSize();
+    int px = ScreenBuffer::toPhysicalX(x);
+    int py = ScreenBuffer::toPhysicalY(y);
+    if (px < 0 || py < 0 ||
+        px + size > ScreenBuffer::PHYSICAL_WIDTH() || py + size > ScreenBuffer::PHYSICAL_HEIGHT()) {
+        return;
+    }
+
+    // Color is laid out as RGBA bytes, the same as the screen buffer
+    static_assert(sizeof(Color) == 4, "minimap rows are copied as RGBA");
+    uint8_t* data = screen.getData();
+    for (int row = 0; row < size; row++) {
+        std::memcpy(data + (py + row) * ScreenBuffer::getPitch() + px * 4,
+                    &pixels[row * size], size * sizeof(Color));
+    }
+
+    // Player marker: a white square one logical pixel across
+    int tiles = getTilesPerPixel();
+    int markerX = (playerTileX & (TILES - 1)) / tiles;
+    int markerY = (TILES - 1 - (playerTileZ & (TILES - 1))) / tiles;
+    int scale = ScreenBuffer::PIXEL_SCALE();
+    markerX = markerX / scale * scale;
+    markerY = markerY / scale * scale;
+    for (int dy = 0; dy < scale; dy++) {
+        for (int dx = 0; dx < scale; dx++) {
+            screen.plotPhysicalPixel(px + markerX + dx, py + markerY + dy, Color::white());
+        }
+    }
+}
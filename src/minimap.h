@@ -0,0 +1,111 @@
+// minimap.h
+// Overview map of the whole world for the HUD
+
+#ifndef LANDER_MINIMAP_H
+#define LANDER_MINIMAP_H
+
+#include "screen.h"
+#include "object_map.h"
+#include <cstdint>
+
+// =============================================================================
+// Minimap
+// =============================================================================
+//
+// Shows all 256x256 tiles of the world (sea, land shaded by height, the
+// launchpad, objects and destroyed objects) as a 64x64 logical pixel overview,
+// so each display pixel covers 4x4 tiles at 320x256, 2x2 at 640x512 and a
+// single tile at 1280x1024.
+//
+// The map is kept at two levels, both built once and then patched:
+//
+// - texels: one 8-bit palette index per tile. Terrain never changes, so the
+//   terrain layer is computed once in build() and an object change only has
+//   to recompute the texel of its tile. ObjectMap reports every change
+//   through its change callback, which calls onTileChanged()
+// - pixels: the RGBA image blitted into the HUD at the current display
+//   scale. A changed texel re-resolves just the display pixel it falls in;
+//   the image is only rebuilt from the texels when the display scale changes
+//
+// Drawing the map is a row-by-row copy of the cached image plus the player
+// marker, so a frame in which nothing changed costs no map work at all.
+//
+// =============================================================================
+
+namespace MinimapPalette {
+    // Palette indices, ordered by how much they matter on the map: when a
+    // display pixel covers several tiles it shows the highest index among
+    // them, so objects win over terrain and destroyed objects over the rest
+    constexpr uint8_t SEA = 0;
+    constexpr uint8_t LAUNCHPAD = 1;
+    constexpr uint8_t LAND = 2;             // First of LAND_SHADES (low to high)
+    constexpr int LAND_SHADES = 32;
+    constexpr uint8_t TREE = LAND + LAND_SHADES;
+    constexpr uint8_t BUILDING = TREE + 1;
+    constexpr uint8_t ROCKET = TREE + 2;
+    constexpr uint8_t DESTROYED = TREE + 3;
+    constexpr int COUNT = DESTROYED + 1;
+
+    // RGBA color of a palette index
+    Color getColor(uint8_t index);
+
+    // Palette index for an object type (NONE gives 0, meaning no object)
+    uint8_t getObjectIndex(uint8_t objectType);
+}
+
+class Minimap {
+public:
+    static constexpr int TILES = ObjectMapConstants::MAP_SIZE;
+    static constexpr int SIZE = 64;             // Logical pixels per side
+
+    explicit Minimap(const ObjectMap& objects) : objects(objects) {}
+
+    // Full rebuild of the terrain layer and every texel from the landscape
+    // and the object map (when the world is first created)
+    void build();
+
+    // Recompute one tile after its object changed
+    void onTileChanged(uint8_t tileX, uint8_t tileZ);
+
+    // ObjectMap change callback; the context is the Minimap
+    static void objectChanged(void* context, uint8_t tileX, uint8_t tileZ);
+
+    // Blit the map with its top-left corner at logical (x, y) and mark the
+    // player's tile
+    void draw(ScreenBuffer& screen, int x, int y, int playerTileX, int playerTileZ);
+
+    // Palette index shown for a tile
+    uint8_t getTexel(int tileX, int tileZ) const { return texels[tileZ][tileX]; }
+
+    // Number of full rebuilds so far (of the texels and of the image)
+    int getBuildCount() const { return buildCount; }
+    int getImageBuildCount() const { return imageBuildCount; }
+
+private:
+    // Resolve the display pixel that covers a tile from its texels
+    void updatePixel(int tileX, int tileZ);
+
+    // Rebuild the whole image at the current display scale
+    void buildImage();
+
+    // Display pixels per side at the current scale, and tiles per display pixel
+    int getImageSize() const { return imageScale * SIZE; }
+    int getTilesPerPixel() const { return TILES / getImageSize(); }
+
+    const ObjectMap& objects;
+
+    // Terrain palette index per tile, and what is shown (terrain or object)
+    uint8_t terrain[TILES][TILES] = {};
+    uint8_t texels[TILES][TILES] = {};
+    bool built = false;
+
+    // RGBA image at imageScale (0 = not built yet); north is at the top, so
+    // tile z maps to row (TILES - 1 - z) / tilesPerPixel
+    Color pixels[TILES * TILES];
+    int imageScale = 0;
+
+    int buildCount = 0;
+    int imageBuildCount = 0;
+};
+
+#endif // LANDER_MINIMAP_H
@@ -0,0 +1,245 @@
+// music_stream.cpp
+// Streams a long WAV track from disk for the music voice
+
+#include "music_stream.h"
+#include "thread_config.h"
+#include <chrono>
+#include <cstring>
+
+#ifdef __linux__
+#include <fcntl.h>
+#endif
+
+// =============================================================================
+// Helpers
+// =============================================================================
+
+static uint32_t readLE32(const uint8_t* p)
+{
+    return p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+static uint16_t readLE16(const uint8_t* p)
+{
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+// =============================================================================
+// MusicStream Implementation
+// =============================================================================
+
+MusicStream::~MusicStream()
+{
+    close();
+}
+
+bool MusicStream::open(const char* path, int outputRate, bool loop)
+{
+    close();
+
+    file = std::fopen(path, "rb");
+    if (!file) {
+        return false;
+    }
+    if (!readHeader() || outputRate <= 0) {
+        close();
+        return false;
+    }
+
+#ifdef __linux__
+    // The file is read front to back: let the kernel read ahead further
+    posix_fadvise(fileno(file), 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
+    looping = loop;
+    dataRead = 0;
+    step = static_cast<double>(sourceRate) / outputRate;
+
+    // One chunk's output (frames / step, plus up to two for the resampler's
+    // phase) has to fit in the ring, or the decoder would wait for room
+    // forever; a rate too low for even one frame is rejected
+    double fitFrames = (RING_SAMPLES - 2) * step;
+    if (fitFrames < 1.0) {
+        close();
+        return false;
+    }
+    chunkFrames = (fitFrames < CHUNK_FRAMES) ? static_cast<int>(fitFrames) : CHUNK_FRAMES;
+    phase = 0.0;
+    previous = 0.0f;
+    readIndex.store(0, std::memory_order_relaxed);
+    writeIndex.store(0, std::memory_order_relaxed);
+    endOfTrack.store(false, std::memory_order_relaxed);
+    underruns.store(0, std::memory_order_relaxed);
+    started = false;
+    stopping.store(false, std::memory_order_relaxed);
+
+    worker = std::thread(&MusicStream::decodeLoop, this);
+    return true;
+}
+
+void MusicStream::close()
+{
+    if (worker.joinable()) {
+        stopping.store(true, std::memory_order_relaxed);
+        worker.join();
+    }
+    if (file) {
+        std::fclose(file);
+        file = nullptr;
+    }
+}
+
+bool MusicStream::readHeader()
+{
+    uint8_t riff[12];
+    if (std::fread(riff, 1, sizeof(riff), file) != sizeof(riff) ||
+        std::memcmp(riff, "RIFF", 4) != 0 || std::memcmp(riff + 8, "WAVE", 4) != 0) {
+        return false;
+    }
+
+    // Walk the chunks until the data chunk, which must follow "fmt "
+    bool haveFormat = false;
+    for (;;) {
+        uint8_t chunk[8];
+        if (std::fread(chunk, 1, sizeof(chunk), file) != sizeof(chunk)) {
+            return false;
+        }
+        uint32_t size = readLE32(chunk + 4);
+
+        if (std::memcmp(chunk, "fmt ", 4) == 0) {
+            uint8_t format[16];
+            if (size < sizeof(format) || std::fread(format, 1, sizeof(format), file) != sizeof(format)) {
+                return false;
+            }
+            int encoding = readLE16(format);
+            sourceChannels = readLE16(format + 2);
+            sourceRate = static_cast<int>(readLE32(format + 4));
+            int bits = readLE16(format + 14);
+            bytesPerSample = bits / 8;
+
+            // Uncompressed PCM only
+            if (encoding != 1 || sourceChannels < 1 || sourceChannels > 2 || sourceRate <= 0 ||
+                (bits != 8 && bits != 16)) {
+                return false;
+            }
+            haveFormat = true;
+            size -= sizeof(format);
+        } else if (std::memcmp(chunk, "data", 4) == 0) {
+            if (!haveFormat) return false;
+            dataOffset = std::ftell(file);
+            dataSize = size - size % static_cast<uint32_t>(sourceChannels * bytesPerSample);
+            return dataSize > 0;
+        }
+
+        // Skip the rest of the chunk (chunks are padded to even sizes)
+        if (std::fseek(file, static_cast<long>(size + (size & 1)), SEEK_CUR) != 0) {
+            return false;
+        }
+    }
+}
+
+void MusicStream::pushSourceSample(float sample, uint32_t& write)
+{
+    // Emit every output sample that falls between the previous source sample
+    // and this one
+    while (phase < 1.0) {
+        float value = previous + (sample - previous) * static_cast<float>(phase);
+        ring[write & (RING_SAMPLES - 1)] = static_cast<int16_t>(value);
+        write++;
+        phase += step;
+    }
+    phase -= 1.0;
+    previous = sample;
+}
+
+bool MusicStream::decodeChunk(uint32_t& write)
+{
+    uint8_t buffer[CHUNK_FRAMES * 2 * 2];
+    int frameBytes = sourceChannels * bytesPerSample;
+
+    if (dataRead >= dataSize) {
+        if (!looping || std::fseek(file, dataOffset, SEEK_SET) != 0) {
+            return false;
+        }
+        dataRead = 0;
+    }
+
+    uint32_t wanted = static_cast<uint32_t>(chunkFrames) * static_cast<uint32_t>(frameBytes);
+    if (wanted > dataSize - dataRead) {
+        wanted = dataSize - dataRead;
+    }
+    size_t got = std::fread(buffer, 1, wanted, file);
+    int frames = static_cast<int>(got) / frameBytes;
+    if (frames == 0) {
+        return false;  // Truncated file
+    }
+    dataRead += static_cast<uint32_t>(got);
+
+    for (int i = 0; i < frames; i++) {
+        const uint8_t* frame = buffer + i * frameBytes;
+        float sum = 0.0f;
+        for (int ch = 0; ch < sourceChannels; ch++) {
+            if (bytesPerSample == 2) {
+                sum += static_cast<int16_t>(readLE16(frame + ch * 2));
+            } else {
+                sum += (frame[ch] - 128) * 256.0f;  // 8-bit WAV is unsigned
+            }
+        }
+        pushSourceSample(sum / sourceChannels, write);
+    }
+    return true;
+}
+
+void MusicStream::decodeLoop()
+{
+    // Decoding runs with the same policy as the other worker threads
+    char error[256];
+    applyThreadPolicy(ThreadRole::Worker, error, sizeof(error));
+
+    // Most output samples one chunk can produce
+    const uint32_t chunkOutput = static_cast<uint32_t>(chunkFrames / step) + 2;
+
+    uint32_t write = writeIndex.load(std::memory_order_relaxed);
+    while (!stopping.load(std::memory_order_relaxed)) {
+        uint32_t used = write - readIndex.load(std::memory_order_acquire);
+        if (used + chunkOutput > RING_SAMPLES) {
+            // Ring full: the audio thread drains about a buffer every few ms
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            continue;
+        }
+
+        bool more = decodeChunk(write);
+        writeIndex.store(write, std::memory_order_release);
+        if (!more) {
+            endOfTrack.store(true, std::memory_order_release);
+            return;
+        }
+    }
+}
+
+int MusicStream::read(int16_t* out, int count)
+{
+    uint32_t read = readIndex.load(std::memory_order_relaxed);
+    uint32_t available = writeIndex.load(std::memory_order_acquire) - read;
+    int n = (available < static_cast<uint32_t>(count)) ? static_cast<int>(available) : count;
+
+    for (int i = 0; i < n; i++) {
+        out[i] = ring[(read + i) & (RING_SAMPLES - 1)];
+    }
+    readIndex.store(read + static_cast<uint32_t>(n), std::memory_order_release);
+
+    // Running short before the first samples arrive is just the start-up delay
+    if (n < count && started && !endOfTrack.load(std::memory_order_acquire)) {
+        underruns.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (n > 0) {
+        started = true;
+    }
+    return n;
+}
+
+bool MusicStream::isFinished() const
+{
+    return endOfTrack.load(std::memory_order_acquire) &&
+           readIndex.load(std::memory_order_relaxed) == writeIndex.load(std::memory_order_acquire);
+}
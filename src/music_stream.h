@@ -0,0 +1,101 @@
+// music_stream.h
+// Streams a long WAV track from disk for the music voice
+
+#ifndef LANDER_MUSIC_STREAM_H
+#define LANDER_MUSIC_STREAM_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+
+// =============================================================================
+// Music Stream
+// =============================================================================
+//
+// Plays a PCM WAV file (8 or 16 bit, mono or stereo, any sample rate) without
+// loading it into memory. A worker thread reads the file a chunk at a time,
+// mixes it down to mono, resamples it to the output rate and writes the
+// result into a single-producer / single-consumer ring. The audio callback
+// takes samples out of the ring with read(), which never blocks or locks:
+// if the worker falls behind, the missing samples are silent and counted
+// as underruns.
+//
+// Memory use is the ring plus one read chunk, whatever the track length.
+//
+// =============================================================================
+
+class MusicStream {
+public:
+    static constexpr int RING_SAMPLES = 16384;      // Decoded samples buffered ahead (power of two)
+    static constexpr int CHUNK_FRAMES = 1024;       // Source frames read from disk at a time
+
+    MusicStream() = default;
+    ~MusicStream();
+
+    MusicStream(const MusicStream&) = delete;
+    MusicStream& operator=(const MusicStream&) = delete;
+
+    // Open a track and start decoding it at outputRate Hz
+    // With loop set the track restarts at its end
+    bool open(const char* path, int outputRate, bool loop);
+    void close();
+    bool isOpen() const { return file != nullptr; }
+
+    // Audio thread: copy up to count samples into out, returns how many were
+    // available (fewer on an underrun or at the end of the track)
+    int read(int16_t* out, int count);
+
+    // True once a non-looping track has been played to the end
+    bool isFinished() const;
+
+    // Times read() came up short while the track was still playing
+    uint32_t getUnderruns() const { return underruns.load(std::memory_order_relaxed); }
+
+    // Source format of the open track
+    int getSourceRate() const { return sourceRate; }
+    int getSourceChannels() const { return sourceChannels; }
+
+private:
+    bool readHeader();
+    void decodeLoop();
+
+    // Read and convert one chunk into the ring, returns false at the end
+    bool decodeChunk(uint32_t& write);
+
+    // Resample one mono source sample into the ring
+    void pushSourceSample(float sample, uint32_t& write);
+
+    std::FILE* file = nullptr;
+    bool looping = false;
+
+    // Source format and the data chunk
+    int sourceRate = 0;
+    int sourceChannels = 0;
+    int bytesPerSample = 0;
+    long dataOffset = 0;
+    uint32_t dataSize = 0;
+    uint32_t dataRead = 0;
+
+    // Source frames decoded at a time: CHUNK_FRAMES, or fewer when the source
+    // rate is so low that a full chunk would resample to more than the ring
+    int chunkFrames = CHUNK_FRAMES;
+
+    // Linear resampler state (source samples per output sample)
+    double step = 1.0;
+    double phase = 0.0;
+    float previous = 0.0f;
+
+    // Ring written by the worker, read by the audio thread
+    int16_t ring[RING_SAMPLES];
+    std::atomic<uint32_t> readIndex{0};
+    std::atomic<uint32_t> writeIndex{0};
+    std::atomic<bool> endOfTrack{false};
+    std::atomic<uint32_t> underruns{0};
+    bool started = false;               // Audio thread: first samples delivered
+
+    std::thread worker;
+    std::atomic<bool> stopping{false};
+};
+
+#endif // LANDER_MUSIC_STREAM_H
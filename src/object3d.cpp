@@ -1,5 +1,49 @@
 #include "object3d.h"
 #include "object_map.h"  // For ObjectType constants
+#include <cstddef>
+
+// Bounding radius of a model's vertices (see ObjectBlueprint::boundingRadius)
+template <size_t N>
+static int32_t boundingRadius(const ObjectVertex (&vertices)[N]) {
+    uint64_t furthest = 0;
+    for (const ObjectVertex& v : vertices) {
+        uint64_t squared = static_cast<uint64_t>(static_cast<int64_t>(v.x) * v.x) +
+                           static_cast<uint64_t>(static_cast<int64_t>(v.y) * v.y) +
+                           static_cast<uint64_t>(static_cast<int64_t>(v.z) * v.z);
+        if (squared > furthest) furthest = squared;
+    }
+
+    // Integer square root, rounded up
+    uint64_t root = 0;
+    for (uint64_t bit = uint64_t(1) << 31; bit != 0; bit >>= 1) {
+        if ((root + bit) * (root + bit) <= furthest) root += bit;
+    }
+    if (root * root < furthest) root++;
+    return static_cast<int32_t>(root);
+}
+
+// Faces with an upward (negative y) normal (see ObjectBlueprint::upwardFaces)
+template <size_t N>
+static uint32_t upwardFaces(const ObjectFace (&faces)[N]) {
+    static_assert(N <= 32, "one mask bit per face");
+    uint32_t mask = 0;
+    for (size_t i = 0; i < N; i++) {
+        if (faces[i].normalY < 0) mask |= 1u << i;
+    }
+    return mask;
+}
+
+// Vertices used by those faces
+template <size_t N>
+static uint32_t upwardFaceVertices(const ObjectFace (&faces)[N]) {
+    uint32_t mask = 0;
+    for (size_t i = 0; i < N; i++) {
+        if (faces[i].normalY < 0) {
+            mask |= (1u << faces[i].vertex0) | (1u << faces[i].vertex1) | (1u << faces[i].vertex2);
+        }
+    }
+    return mask;
+}
 
 // =============================================================================
 // Ship Model Data
@@ -88,6 +132,9 @@ const ObjectBlueprint shipBlueprint = {
     ObjectFlags::ROTATES,   // flags: rotates, has shadow
     shipVertices,
     shipFaces,
+    boundingRadius(shipVertices),
+    upwardFaces(shipFaces),
+    upwardFaceVertices(shipFaces),
 };
 
 // =============================================================================
@@ -117,6 +164,9 @@ const ObjectBlueprint pyramidBlueprint = {
     ObjectFlags::ROTATES,  // Rotates, no shadow
     pyramidVertices,
     pyramidFaces,
+    boundingRadius(pyramidVertices),
+    upwardFaces(pyramidFaces),
+    upwardFaceVertices(pyramidFaces),
 };
 
 // =============================================================================
@@ -151,6 +201,9 @@ const ObjectBlueprint smallLeafyTreeBlueprint = {
     ObjectFlags::HAS_SHADOW,  // Static, has shadow (flags = 2 = bit 1 set? No, bit 1 = no shadow)
     smallLeafyTreeVertices,
     smallLeafyTreeFaces,
+    boundingRadius(smallLeafyTreeVertices),
+    upwardFaces(smallLeafyTreeFaces),
+    upwardFaceVertices(smallLeafyTreeFaces),
 };
 
 // =============================================================================
@@ -189,6 +242,9 @@ const ObjectBlueprint tallLeafyTreeBlueprint = {
     ObjectFlags::HAS_SHADOW,  // Static, has shadow
     tallLeafyTreeVertices,
     tallLeafyTreeFaces,
+    boundingRadius(tallLeafyTreeVertices),
+    upwardFaces(tallLeafyTreeFaces),
+    upwardFaceVertices(tallLeafyTreeFaces),
 };
 
 // =============================================================================
@@ -214,6 +270,9 @@ const ObjectBlueprint firTreeBlueprint = {
     ObjectFlags::HAS_SHADOW,  // Static, has shadow
     firTreeVertices,
     firTreeFaces,
+    boundingRadius(firTreeVertices),
+    upwardFaces(firTreeFaces),
+    upwardFaceVertices(firTreeFaces),
 };
 
 // =============================================================================
@@ -253,6 +312,9 @@ const ObjectBlueprint gazeboBlueprint = {
     ObjectFlags::HAS_SHADOW,  // Static, has shadow
     gazeboVertices,
     gazeboFaces,
+    boundingRadius(gazeboVertices),
+    upwardFaces(gazeboFaces),
+    upwardFaceVertices(gazeboFaces),
 };
 
 // =============================================================================
@@ -299,6 +361,9 @@ const ObjectBlueprint buildingBlueprint = {
     ObjectFlags::HAS_SHADOW,  // Static, no shadow (original has no shadow)
     buildingVertices,
     buildingFaces,
+    boundingRadius(buildingVertices),
+    upwardFaces(buildingFaces),
+    upwardFaceVertices(buildingFaces),
 };
 
 // =============================================================================
@@ -338,6 +403,9 @@ const ObjectBlueprint rocketBlueprint = {
     ObjectFlags::HAS_SHADOW,  // Static, has shadow
     rocketVertices,
     rocketFaces,
+    boundingRadius(rocketVertices),
+    upwardFaces(rocketFaces),
+    upwardFaceVertices(rocketFaces),
 };
 
 // =============================================================================
@@ -363,6 +431,9 @@ const ObjectBlueprint smokingRemainsLeftBlueprint = {
     0,  // No shadow, static
     smokingRemainsLeftVertices,
     smokingRemainsLeftFaces,
+    boundingRadius(smokingRemainsLeftVertices),
+    upwardFaces(smokingRemainsLeftFaces),
+    upwardFaceVertices(smokingRemainsLeftFaces),
 };
 
 // =============================================================================
@@ -388,6 +459,9 @@ const ObjectBlueprint smokingRemainsRightBlueprint = {
     0,  // No shadow, static
     smokingRemainsRightVertices,
     smokingRemainsRightFaces,
+    boundingRadius(smokingRemainsRightVertices),
+    upwardFaces(smokingRemainsRightFaces),
+    upwardFaceVertices(smokingRemainsRightFaces),
 };
 
 // =============================================================================
@@ -416,6 +490,9 @@ const ObjectBlueprint smokingGazeboBlueprint = {
     ObjectFlags::HAS_SHADOW,  // Static, has shadow
     smokingGazeboVertices,
     smokingGazeboFaces,
+    boundingRadius(smokingGazeboVertices),
+    upwardFaces(smokingGazeboFaces),
+    upwardFaceVertices(smokingGazeboFaces),
 };
 
 // =============================================================================
@@ -446,6 +523,9 @@ const ObjectBlueprint smokingBuildingBlueprint = {
     0,  // No shadow, static
     smokingBuildingVertices,
     smokingBuildingFaces,
+    boundingRadius(smokingBuildingVertices),
+    upwardFaces(smokingBuildingFaces),
+    upwardFaceVertices(smokingBuildingFaces),
 };
 
 // =============================================================================
@@ -482,6 +562,9 @@ const ObjectBlueprint rockBlueprint = {
     ObjectFlags::ROTATES,  // Rocks rotate
     rockVertices,
     rockFaces,
+    boundingRadius(rockVertices),
+    upwardFaces(rockFaces),
+    upwardFaceVertices(rockFaces),
 };
 
 // =============================================================================
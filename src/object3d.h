@@ -60,6 +60,16 @@ struct ObjectBlueprint {
     uint32_t flags;
     const ObjectVertex* vertices;
     const ObjectFace* faces;
+
+    // Distance from the origin to the furthest vertex (8.24, rounded up),
+    // so the object fits in this sphere however it is rotated
+    int32_t boundingRadius;
+
+    // Faces (bit i for face i) whose normal points up, and the vertices
+    // they use. These are what a static object's shadow is made of: as
+    // neither the object nor the camera ever turns, they never change
+    uint32_t upwardFaces;
+    uint32_t upwardFaceVertices;
 };
 
 // =============================================================================
@@ -6,13 +6,20 @@
 ObjectMap objectMap;
 RandomNumberGenerator gameRng;
 
+ObjectMapSnapshot::ObjectMapSnapshot() {
+    memset(map, ObjectType::NONE, sizeof(map));
+}
+
 ObjectMap::ObjectMap() {
+    changedTiles.reserve(MAX_LOGGED_CHANGES);
     clear();
 }
 
 void ObjectMap::clear() {
     // Original initializes to 0xFF (no object)
     memset(map, ObjectType::NONE, sizeof(map));
+    version++;
+    publishAll = true;
 }
 
 uint8_t ObjectMap::getObjectAt(uint8_t tileX, uint8_t tileZ) const {
@@ -20,7 +27,11 @@ uint8_t ObjectMap::getObjectAt(uint8_t tileX, uint8_t tileZ) const {
 }
 
 void ObjectMap::setObjectAt(uint8_t tileX, uint8_t tileZ, uint8_t objectType) {
+    if (map[tileZ][tileX] == objectType) {
+        return;
+    }
     map[tileZ][tileX] = objectType;
+    notifyChange(tileX, tileZ);
 }
 
 uint8_t ObjectMap::getObjectAtWorld(int32_t worldX, int32_t worldZ) const {
@@ -118,11 +129,32 @@ void ObjectMap::restoreDestroyedObjects() {
             uint8_t objectType = map[z][x];
             if (isDestroyedType(objectType)) {
                 map[z][x] = getOriginalType(objectType);
+                notifyChange(static_cast<uint8_t>(x), static_cast<uint8_t>(z));
             }
         }
     }
 }
 
+void ObjectMap::publish() {
+    if (publishAll) {
+        memcpy(published.map, map, sizeof(map));
+    } else {
+        // A tile changed more than once is copied more than once, but always
+        // with its latest object
+        for (uint16_t tile : changedTiles) {
+            published.map[tile >> 8][tile & 0xFF] = map[tile >> 8][tile & 0xFF];
+        }
+    }
+    published.version = version;
+    changedTiles.clear();
+    publishAll = false;
+}
+
+void ObjectMap::setChangeCallback(ObjectChangeCallback callback, void* context) {
+    changeCallback = callback;
+    changeContext = context;
+}
+
 // =============================================================================
 // Random Number Generator Implementation
 // =============================================================================
@@ -252,4 +284,8 @@ void placeObjectsOnMap() {
     objectMap.setObjectAt(7, 1, ObjectType::LAUNCHPAD_OBJECT);
     objectMap.setObjectAt(7, 3, ObjectType::LAUNCHPAD_OBJECT);
     objectMap.setObjectAt(7, 5, ObjectType::LAUNCHPAD_OBJECT);
+
+    // Placement happens before anything is drawn, so publish the new map
+    // straight away rather than at the next frame boundary
+    objectMap.publish();
 }
@@ -2,6 +2,7 @@
 #define LANDER_OBJECT_MAP_H
 
 #include <cstdint>
+#include <vector>
 
 // =============================================================================
 // Object Map System
@@ -74,6 +75,44 @@ namespace ObjectMapConstants {
     constexpr int OBJECT_COUNT = 2048;  // Number of random objects to place
 }
 
+// Called after a tile's object changes (set by whoever caches the map)
+using ObjectChangeCallback = void (*)(void* context, uint8_t tileX, uint8_t tileZ);
+
+// =============================================================================
+// Published Snapshots
+// =============================================================================
+//
+// The simulation changes the map (objects are destroyed by particles, restored
+// on a new game, streamed in by the chunked world) while the renderer reads
+// it. So that the two can run on different threads, the map is double-
+// buffered: the simulation writes the live map, which logs the tiles it
+// changes, and at each frame boundary publish() applies that sparse log to
+// the published snapshot the renderer reads. Between publishes the snapshot
+// doesn't change, so a frame is always drawn from one consistent map.
+//
+// When more tiles change than the log holds (clear(), or restoring every
+// destroyed object) the whole map is copied instead.
+//
+// =============================================================================
+
+// A read-only copy of the map as it was at the last publish
+class ObjectMapSnapshot {
+public:
+    ObjectMapSnapshot();
+
+    uint8_t getObjectAt(uint8_t tileX, uint8_t tileZ) const { return map[tileZ][tileX]; }
+
+    // The live map's version when this was published, so caches of what the
+    // renderer saw can tell when to invalidate
+    uint32_t getVersion() const { return version; }
+
+private:
+    friend class ObjectMap;
+
+    uint8_t map[ObjectMapConstants::MAP_SIZE][ObjectMapConstants::MAP_SIZE];
+    uint32_t version = 0;
+};
+
 // Object map class
 class ObjectMap {
 public:
@@ -106,8 +145,47 @@ public:
     // Restore all destroyed objects to their original types
     void restoreDestroyedObjects();
 
+    // Report every tile whose object changes through setObjectAt() or
+    // restoreDestroyedObjects() (nullptr to stop); clear() is not reported
+    void setChangeCallback(ObjectChangeCallback callback, void* context);
+
+    // Count of changes so far, including clear(): the map is unchanged for
+    // as long as this is, so callers can tell whether anything moved on
+    uint32_t getVersion() const { return version; }
+
+    // Make the changes since the last publish visible to readers of the
+    // published snapshot; it must not overlap their reads (the game calls it
+    // between simulating and rendering a frame)
+    void publish();
+
+    // The map as of the last publish, for the renderer
+    const ObjectMapSnapshot& getPublished() const { return published; }
+
+    // Changed tiles the log holds before publish() falls back to a full copy
+    static constexpr int MAX_LOGGED_CHANGES = 1024;
+
 private:
+    void notifyChange(uint8_t tileX, uint8_t tileZ) {
+        version++;
+        logChange(tileX, tileZ);
+        if (changeCallback) changeCallback(changeContext, tileX, tileZ);
+    }
+
+    void logChange(uint8_t tileX, uint8_t tileZ) {
+        if (static_cast<int>(changedTiles.size()) < MAX_LOGGED_CHANGES) {
+            changedTiles.push_back(static_cast<uint16_t>(tileZ << 8 | tileX));
+        } else {
+            publishAll = true;
+        }
+    }
+
     uint8_t map[ObjectMapConstants::MAP_SIZE][ObjectMapConstants::MAP_SIZE];
+    ObjectMapSnapshot published;
+    std::vector<uint16_t> changedTiles;  // z << 8 | x, since the last publish
+    bool publishAll = true;              // Too many changes to log
+    ObjectChangeCallback changeCallback = nullptr;
+    void* changeContext = nullptr;
+    uint32_t version = 0;
 };
 
 // Global object map instance
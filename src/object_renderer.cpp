@@ -2,6 +2,7 @@
 #include "palette.h"
 #include "landscape.h"
 #include "graphics_buffer.h"
+#include "frame_stats.h"
 
 // =============================================================================
 // 3D Object Renderer Implementation
@@ -70,6 +71,31 @@ Color calculateLitColor(uint16_t baseColor, const Vec3& rotatedNormal) {
     );
 }
 
+// Copy a blueprint's vertices, rotated all at once if the object rotates
+static int rotateVertices(const ObjectBlueprint& blueprint, const Mat3x3& rotation, Vec3* rotated) {
+    int count = static_cast<int>(blueprint.vertexCount < MAX_VERTICES ? blueprint.vertexCount : MAX_VERTICES);
+    for (int i = 0; i < count; i++) {
+        const ObjectVertex& vertex = blueprint.vertices[i];
+        rotated[i] = Vec3(Fixed::fromRaw(vertex.x), Fixed::fromRaw(vertex.y), Fixed::fromRaw(vertex.z));
+    }
+
+    if ((blueprint.flags & ObjectFlags::ROTATES) != 0) {
+        transformPoints(rotation, rotated, rotated, count);
+    }
+    return count;
+}
+
+// Project camera-relative vertices, keeping their screen position and visibility
+static void projectVertices2D(const Vec3* points, int count, ProjectedVertex2D* vertices) {
+    ProjectedVertex projected[MAX_VERTICES];
+    projectVertices(points, count, projected);
+    for (int i = 0; i < count; i++) {
+        vertices[i].x = projected[i].screenX;
+        vertices[i].y = projected[i].screenY;
+        vertices[i].visible = projected[i].visible;
+    }
+}
+
 void drawObject(
     const ObjectBlueprint& blueprint,
     const Vec3& position,
@@ -86,42 +112,26 @@ void drawObject(
     // ==========================================================================
     // Based on Lander.arm lines 5138-5268
 
-    for (uint32_t i = 0; i < blueprint.vertexCount && i < MAX_VERTICES; i++) {
-        const ObjectVertex& vertex = blueprint.vertices[i];
-
-        // Get vertex coordinates as Fixed values
-        Vec3 v;
-        v.x = Fixed::fromRaw(vertex.x);
-        v.y = Fixed::fromRaw(vertex.y);
-        v.z = Fixed::fromRaw(vertex.z);
-
-        // Transform vertex by rotation matrix if object rotates
-        Vec3 rotated;
-        if (isRotating) {
-            rotated = rotation * v;
-        } else {
-            rotated = v;
-        }
+    Vec3 points[MAX_VERTICES];
+    int vertexCount = rotateVertices(blueprint, rotation, points);
 
+    for (int i = 0; i < vertexCount; i++) {
         // Add object position to get world coordinates
-        Vec3 worldPos;
-        worldPos.x = Fixed::fromRaw(position.x.raw + rotated.x.raw);
-        worldPos.y = Fixed::fromRaw(position.y.raw + rotated.y.raw);
-        worldPos.z = Fixed::fromRaw(position.z.raw + rotated.z.raw);
-
-        // Project to screen
-        ProjectedVertex projected = projectVertex(worldPos);
-
-        projectedVertices[i].x = projected.screenX;
-        projectedVertices[i].y = projected.screenY;
-        projectedVertices[i].visible = projected.visible;
+        points[i].x = Fixed::fromRaw(position.x.raw + points[i].x.raw);
+        points[i].y = Fixed::fromRaw(position.y.raw + points[i].y.raw);
+        points[i].z = Fixed::fromRaw(position.z.raw + points[i].z.raw);
     }
 
+    // Project to screen
+    projectVertices2D(points, vertexCount, projectedVertices);
+
     // ==========================================================================
     // Part 2: Process and draw each face
     // ==========================================================================
     // Based on Lander.arm lines 5284-5640
 
+    int trianglesDrawn = 0;
+
     for (uint32_t i = 0; i < blueprint.faceCount; i++) {
         const ObjectFace& face = blueprint.faces[i];
 
@@ -162,7 +172,10 @@ void drawObject(
 
             faceVisible = (dotProduct < 0);
         }
-        // Static objects: all faces are visible (original sets R3 = -1)
+        // Static objects: all faces are visible (original sets R3 = -1).
+        // This can't be narrowed by where the object is relative to the
+        // fixed camera: the models are open (no floors or back walls, and
+        // leaves are single sheets), so faces are seen from both sides
 
         if (!faceVisible) {
             continue;
@@ -190,6 +203,11 @@ void drawObject(
             projectedVertices[v2].x, projectedVertices[v2].y,
             litColor
         );
+        trianglesDrawn++;
+    }
+
+    if (trianglesDrawn > 0) {
+        frameStats.objectsDrawn++;
     }
 }
 
@@ -231,23 +249,18 @@ void drawObjectShadow(
     // Part 1: Calculate shadow vertices (project each vertex onto terrain)
     // ==========================================================================
 
-    for (uint32_t i = 0; i < blueprint.vertexCount && i < MAX_VERTICES; i++) {
-        const ObjectVertex& vertex = blueprint.vertices[i];
-
-        // Get vertex coordinates as Fixed values
-        Vec3 v;
-        v.x = Fixed::fromRaw(vertex.x);
-        v.y = Fixed::fromRaw(vertex.y);
-        v.z = Fixed::fromRaw(vertex.z);
+    Vec3 points[MAX_VERTICES];
+    int vertexCount = rotateVertices(blueprint, rotation, points);
 
-        // Transform vertex by rotation matrix if object rotates
-        Vec3 rotated;
-        if (isRotating) {
-            rotated = rotation * v;
-        } else {
-            rotated = v;
+    for (int i = 0; i < vertexCount; i++) {
+        // A static object's shadow only uses the vertices of its upward
+        // faces, so the terrain under the others isn't needed
+        if (!isRotating && ((blueprint.upwardFaceVertices >> i) & 1) == 0) {
+            continue;
         }
 
+        const Vec3& rotated = points[i];
+
         // Calculate world position of this vertex
         Fixed worldX = Fixed::fromRaw(worldPos.x.raw + rotated.x.raw);
         Fixed worldZ = Fixed::fromRaw(worldPos.z.raw + rotated.z.raw);
@@ -261,15 +274,12 @@ void drawObjectShadow(
         shadowPos.x = Fixed::fromRaw(cameraRelPos.x.raw + rotated.x.raw);
         shadowPos.y = Fixed::fromRaw(terrainY.raw - cameraWorldPos.y.raw);
         shadowPos.z = Fixed::fromRaw(cameraRelPos.z.raw + rotated.z.raw);
-
-        // Project shadow vertex to screen
-        ProjectedVertex projected = projectVertex(shadowPos);
-
-        shadowVertices[i].x = projected.screenX;
-        shadowVertices[i].y = projected.screenY;
-        shadowVertices[i].visible = projected.visible;
+        points[i] = shadowPos;
     }
 
+    // Project shadow vertices to screen
+    projectVertices2D(points, vertexCount, shadowVertices);
+
     // ==========================================================================
     // Part 2: Draw shadows for upward-facing faces
     // ==========================================================================
@@ -277,9 +287,16 @@ void drawObjectShadow(
 
     Color black = Color::black();
 
+    int trianglesDrawn = 0;
+
     for (uint32_t i = 0; i < blueprint.faceCount; i++) {
         const ObjectFace& face = blueprint.faces[i];
 
+        // A static object's upward faces are known in advance
+        if (!isRotating && ((blueprint.upwardFaces >> i) & 1) == 0) {
+            continue;
+        }
+
         // Get face normal as Vec3
         Vec3 normal;
         normal.x = Fixed::fromRaw(face.normalX);
@@ -319,6 +336,11 @@ void drawObjectShadow(
             shadowVertices[v2].x, shadowVertices[v2].y,
             black
         );
+        trianglesDrawn++;
+    }
+
+    if (trianglesDrawn > 0) {
+        frameStats.shadowsDrawn++;
     }
 }
 
@@ -337,6 +359,12 @@ void bufferObject(
     const Mat3x3& rotation,
     int row
 ) {
+    // Skip the whole object if none of it can reach the screen
+    if (isObjectOffScreen(blueprint, position)) {
+        frameStats.objectsCulled++;
+        return;
+    }
+
     // Arrays to store projected vertices
     ProjectedVertex2D projectedVertices[MAX_VERTICES];
 
@@ -346,41 +374,25 @@ void bufferObject(
     // Part 1: Transform and project all vertices
     // ==========================================================================
 
-    for (uint32_t i = 0; i < blueprint.vertexCount && i < MAX_VERTICES; i++) {
-        const ObjectVertex& vertex = blueprint.vertices[i];
-
-        // Get vertex coordinates as Fixed values
-        Vec3 v;
-        v.x = Fixed::fromRaw(vertex.x);
-        v.y = Fixed::fromRaw(vertex.y);
-        v.z = Fixed::fromRaw(vertex.z);
-
-        // Transform vertex by rotation matrix if object rotates
-        Vec3 rotated;
-        if (isRotating) {
-            rotated = rotation * v;
-        } else {
-            rotated = v;
-        }
+    Vec3 points[MAX_VERTICES];
+    int vertexCount = rotateVertices(blueprint, rotation, points);
 
+    for (int i = 0; i < vertexCount; i++) {
         // Add object position to get world coordinates
-        Vec3 worldPos;
-        worldPos.x = Fixed::fromRaw(position.x.raw + rotated.x.raw);
-        worldPos.y = Fixed::fromRaw(position.y.raw + rotated.y.raw);
-        worldPos.z = Fixed::fromRaw(position.z.raw + rotated.z.raw);
-
-        // Project to screen
-        ProjectedVertex projected = projectVertex(worldPos);
-
-        projectedVertices[i].x = projected.screenX;
-        projectedVertices[i].y = projected.screenY;
-        projectedVertices[i].visible = projected.visible;
+        points[i].x = Fixed::fromRaw(position.x.raw + points[i].x.raw);
+        points[i].y = Fixed::fromRaw(position.y.raw + points[i].y.raw);
+        points[i].z = Fixed::fromRaw(position.z.raw + points[i].z.raw);
     }
 
+    // Project to screen
+    projectVertices2D(points, vertexCount, projectedVertices);
+
     // ==========================================================================
     // Part 2: Process and buffer each face
     // ==========================================================================
 
+    int trianglesDrawn = 0;
+
     for (uint32_t i = 0; i < blueprint.faceCount; i++) {
         const ObjectFace& face = blueprint.faces[i];
 
@@ -436,6 +448,11 @@ void bufferObject(
             projectedVertices[v2].x, projectedVertices[v2].y,
             litColor
         );
+        trianglesDrawn++;
+    }
+
+    if (trianglesDrawn > 0) {
+        frameStats.objectsDrawn++;
     }
 }
 
@@ -452,6 +469,13 @@ void bufferObjectShadow(
         return;
     }
 
+    // Skip the whole shadow (and its terrain lookups) if none of it can
+    // reach the screen
+    if (isShadowOffScreen(blueprint, cameraRelPos, cameraWorldPos.y)) {
+        frameStats.shadowsCulled++;
+        return;
+    }
+
     // Arrays to store shadow projected vertices
     ProjectedVertex2D shadowVertices[MAX_VERTICES];
 
@@ -461,23 +485,18 @@ void bufferObjectShadow(
     // Part 1: Calculate shadow vertices (project each vertex onto terrain)
     // ==========================================================================
 
-    for (uint32_t i = 0; i < blueprint.vertexCount && i < MAX_VERTICES; i++) {
-        const ObjectVertex& vertex = blueprint.vertices[i];
-
-        // Get vertex coordinates as Fixed values
-        Vec3 v;
-        v.x = Fixed::fromRaw(vertex.x);
-        v.y = Fixed::fromRaw(vertex.y);
-        v.z = Fixed::fromRaw(vertex.z);
+    Vec3 points[MAX_VERTICES];
+    int vertexCount = rotateVertices(blueprint, rotation, points);
 
-        // Transform vertex by rotation matrix if object rotates
-        Vec3 rotated;
-        if (isRotating) {
-            rotated = rotation * v;
-        } else {
-            rotated = v;
+    for (int i = 0; i < vertexCount; i++) {
+        // A static object's shadow only uses the vertices of its upward
+        // faces, so the terrain under the others isn't needed
+        if (!isRotating && ((blueprint.upwardFaceVertices >> i) & 1) == 0) {
+            continue;
         }
 
+        const Vec3& rotated = points[i];
+
         // Calculate world position of this vertex
         Fixed worldX = Fixed::fromRaw(worldPos.x.raw + rotated.x.raw);
         Fixed worldZ = Fixed::fromRaw(worldPos.z.raw + rotated.z.raw);
@@ -486,28 +505,33 @@ void bufferObjectShadow(
         Fixed terrainY = getLandscapeAltitude(worldX, worldZ);
 
         // Calculate camera-relative position of shadow vertex
+        // X and Z are same as object vertex, Y is terrain altitude relative to camera
         Vec3 shadowPos;
         shadowPos.x = Fixed::fromRaw(cameraRelPos.x.raw + rotated.x.raw);
         shadowPos.y = Fixed::fromRaw(terrainY.raw - cameraWorldPos.y.raw);
         shadowPos.z = Fixed::fromRaw(cameraRelPos.z.raw + rotated.z.raw);
-
-        // Project shadow vertex to screen
-        ProjectedVertex projected = projectVertex(shadowPos);
-
-        shadowVertices[i].x = projected.screenX;
-        shadowVertices[i].y = projected.screenY;
-        shadowVertices[i].visible = projected.visible;
+        points[i] = shadowPos;
     }
 
+    // Project shadow vertices to screen
+    projectVertices2D(points, vertexCount, shadowVertices);
+
     // ==========================================================================
     // Part 2: Buffer shadows for upward-facing faces
     // ==========================================================================
 
     Color black = Color::black();
 
+    int trianglesDrawn = 0;
+
     for (uint32_t i = 0; i < blueprint.faceCount; i++) {
         const ObjectFace& face = blueprint.faces[i];
 
+        // A static object's upward faces are known in advance
+        if (!isRotating && ((blueprint.upwardFaces >> i) & 1) == 0) {
+            continue;
+        }
+
         // Get face normal as Vec3
         Vec3 normal;
         normal.x = Fixed::fromRaw(face.normalX);
@@ -546,5 +570,49 @@ void bufferObjectShadow(
             shadowVertices[v2].x, shadowVertices[v2].y,
             black
         );
+        trianglesDrawn++;
+    }
+
+    if (trianglesDrawn > 0) {
+        frameStats.shadowsDrawn++;
+    }
+}
+
+// =============================================================================
+// Object Culling
+// =============================================================================
+//
+// Every vertex of a rotated object is within boundingRadius of its origin,
+// so the object is inside a cube of that half-width around cameraRelPos
+// (plus 1/256, for the rounding in a fixed-point rotation matrix). Its
+// shadow has the same x and z, with y anywhere the terrain can be.
+//
+// =============================================================================
+
+bool isObjectOffScreen(const ObjectBlueprint& blueprint, const Vec3& cameraRelPos) {
+    int64_t r = blueprint.boundingRadius + (blueprint.boundingRadius >> 8);
+    ViewBox box;
+    box.minX = static_cast<int64_t>(cameraRelPos.x.raw) - r;
+    box.maxX = static_cast<int64_t>(cameraRelPos.x.raw) + r;
+    box.minY = static_cast<int64_t>(cameraRelPos.y.raw) - r;
+    box.maxY = static_cast<int64_t>(cameraRelPos.y.raw) + r;
+    box.minZ = static_cast<int64_t>(cameraRelPos.z.raw) - r;
+    box.maxZ = static_cast<int64_t>(cameraRelPos.z.raw) + r;
+    return isBoxOffScreen(box);
+}
+
+bool isShadowOffScreen(const ObjectBlueprint& blueprint, const Vec3& cameraRelPos, Fixed cameraY) {
+    if ((blueprint.flags & ObjectFlags::NO_SHADOW) != 0) {
+        return true;
     }
+
+    int64_t r = blueprint.boundingRadius + (blueprint.boundingRadius >> 8);
+    ViewBox box;
+    box.minX = static_cast<int64_t>(cameraRelPos.x.raw) - r;
+    box.maxX = static_cast<int64_t>(cameraRelPos.x.raw) + r;
+    box.minY = static_cast<int64_t>(LANDSCAPE_PEAK_ALTITUDE.raw) - cameraY.raw;
+    box.maxY = static_cast<int64_t>(GameConstants::SEA_LEVEL.raw) - cameraY.raw;
+    box.minZ = static_cast<int64_t>(cameraRelPos.z.raw) - r;
+    box.maxZ = static_cast<int64_t>(cameraRelPos.z.raw) + r;
+    return isBoxOffScreen(box);
 }
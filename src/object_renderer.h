@@ -105,4 +105,12 @@ void bufferObjectShadow(
     int row
 );
 
+// Whether an object, or its shadow, at a camera-relative position is
+// certainly off screen whatever its rotation (see isBoxOffScreen), so the
+// bufferObject() or bufferObjectShadow() call can be skipped. The shadow
+// lies on the terrain below the object, anywhere between the highest peak
+// and the sea (cameraY is the camera's world altitude)
+bool isObjectOffScreen(const ObjectBlueprint& blueprint, const Vec3& cameraRelPos);
+bool isShadowOffScreen(const ObjectBlueprint& blueprint, const Vec3& cameraRelPos, Fixed cameraY);
+
 #endif // LANDER_OBJECT_RENDERER_H
@@ -8,6 +8,7 @@
 #include "object_map.h"
 #include "object3d.h"
 #include "object_renderer.h"
+#include "frame_stats.h"
 #include <cstdio>
 
 // =============================================================================
@@ -59,6 +60,7 @@ bool ParticleSystem::addParticle(const Vec3 &pos, const Vec3 &vel, int32_t lifes
     // Check if room for more particles
     if (particleCount >= ParticleConstants::MAX_PARTICLES)
     {
+        frameStats.particlesRejected++;
         return false;
     }
 
@@ -1198,6 +1200,16 @@ void updateRockRotation()
     rockRotationAngle += 0x02000000;  // ~45 degrees per second at 120fps
 }
 
+int32_t getRockRotationAngle()
+{
+    return rockRotationAngle;
+}
+
+void setRockRotationAngle(int32_t angle)
+{
+    rockRotationAngle = angle;
+}
+
 void bufferRocks(const Camera& camera)
 {
     // Update rock rotation
@@ -1553,3 +1565,38 @@ void bufferStars(const Camera& camera)
                    width, height, color, false);
     }
 }
+
+// =============================================================================
+// Particle Statistics
+// =============================================================================
+
+ParticleKind classifyParticle(uint32_t flags)
+{
+    using namespace ParticleFlags;
+
+    if (flags & IS_STAR) return ParticleKind::Star;
+    if (flags & IS_ROCK) return ParticleKind::Rock;
+    if (flags & DESTROYS_OBJECTS) return ParticleKind::Bullet;
+    if (flags & FADING)
+    {
+        // Exhaust and explosion flames splash, bullet impact sparks don't
+        return (flags & SPLASH) ? ParticleKind::Exhaust : ParticleKind::Spark;
+    }
+    if (!(flags & GRAVITY)) return ParticleKind::Smoke;
+    if (flags & BOUNCES) return ParticleKind::Debris;
+    return ParticleKind::Splash;
+}
+
+void collectParticleStats(FrameStats& stats)
+{
+    for (int i = 0; i < PARTICLE_KIND_COUNT; i++)
+    {
+        stats.particles[i] = 0;
+    }
+
+    for (int i = 0; i < particleSystem.getParticleCount(); i++)
+    {
+        int kind = static_cast<int>(classifyParticle(particleSystem.getParticle(i).flags));
+        stats.particles[kind]++;
+    }
+}
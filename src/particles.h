@@ -350,8 +350,13 @@ class ScreenBuffer;
 void renderRocks(const Camera& camera, ScreenBuffer& screen);
 
 // Buffer rocks into graphics buffer system for depth-sorted rendering
+// Advances the shared rock rotation, so call once per frame
 void bufferRocks(const Camera& camera);
 
+// Shared rotation angle of all rocks (set to draw a frame again exactly)
+int32_t getRockRotationAngle();
+void setRockRotationAngle(int32_t angle);
+
 // Check for rock-player collision
 // playerPos: player's world position
 // cameraPos: camera's world position (rocks are relative to camera)
@@ -381,4 +386,16 @@ int getStarCount();
 // Stars are rendered as filled squares with fade effect
 void bufferStars(const Camera& camera);
 
+// =============================================================================
+// Particle Statistics
+// =============================================================================
+
+// Classify a particle by the flags its spawn function gave it
+enum class ParticleKind;
+ParticleKind classifyParticle(uint32_t flags);
+
+// Count live particles by kind into the frame statistics
+struct FrameStats;
+void collectParticleStats(FrameStats& stats);
+
 #endif // LANDER_PARTICLES_H
@@ -1,4 +1,5 @@
 #include "projection.h"
+#include "fixed_simd.h"
 
 // =============================================================================
 // 3D Projection Implementation
@@ -66,7 +67,7 @@ ProjectedVertex projectVertex(Fixed x, Fixed y, Fixed z) {
     // Focal length: how many pixels per unit distance at z=1
     // A value of 256 means at z=1 tile, x=1 tile maps to 256 pixels
     // This gives a reasonable field of view
-    constexpr int FOCAL_LENGTH = 256;
+    constexpr int FOCAL_LENGTH = ProjectionConstants::FOCAL_LENGTH;
 
     // Scale x and y by focal length before projection
     // Use 64-bit to avoid overflow
@@ -94,3 +95,102 @@ ProjectedVertex projectVertex(Fixed x, Fixed y, Fixed z) {
 ProjectedVertex projectVertex(const Vec3& v) {
     return projectVertex(v.x, v.y, v.z);
 }
+
+// =============================================================================
+// Batch Projection
+// =============================================================================
+//
+// The same arithmetic as projectVertex() a pack of points at a time: the
+// multiply by the focal length is the shift in divShifted(), and points
+// behind the camera divide by 1 instead of z and are then reported as not
+// visible. A short last pack is padded and only its real points are written.
+//
+// =============================================================================
+
+void projectVertices(const Vec3* points, int count, ProjectedVertex* results) {
+    constexpr int LANES = FixedPack::LANES;
+    constexpr int FOCAL_SHIFT = 8;
+    static_assert((1 << FOCAL_SHIFT) == ProjectionConstants::FOCAL_LENGTH,
+                  "the focal length is applied as a shift");
+
+    const FixedPack centerX = FixedPack::splat(ProjectionConstants::CENTER_X());
+    const FixedPack centerY = FixedPack::splat(ProjectionConstants::CENTER_Y());
+    const FixedPack scale = FixedPack::splat(ProjectionConstants::SCALE());
+    const FixedPack zero = FixedPack::splat(0);
+    const FixedPack one = FixedPack::splat(1);
+    const int right = ProjectionConstants::SCREEN_RIGHT();
+    const int bottom = ProjectionConstants::SCREEN_BOTTOM();
+
+    for (int first = 0; first < count; first += LANES) {
+        int lanes = (count - first < LANES) ? count - first : LANES;
+
+        int32_t xs[LANES] = {};
+        int32_t ys[LANES] = {};
+        int32_t zs[LANES] = {};
+        for (int i = 0; i < lanes; i++) {
+            xs[i] = points[first + i].x.raw;
+            ys[i] = points[first + i].y.raw;
+            zs[i] = points[first + i].z.raw;
+        }
+
+        FixedPack z = FixedPack::load(zs);
+        FixedPack visible = FixedPack::cmpGt(z, zero);
+        FixedPack divisor = FixedPack::select(visible, z, one);
+
+        FixedPack offsetX = FixedPack::divShifted(FixedPack::load(xs), divisor, FOCAL_SHIFT);
+        FixedPack offsetY = FixedPack::divShifted(FixedPack::load(ys), divisor, FOCAL_SHIFT);
+        (centerX + FixedPack::mulInt(offsetX, scale)).store(xs);
+        (centerY + FixedPack::mulInt(offsetY, scale)).store(ys);
+
+        for (int i = 0; i < lanes; i++) {
+            ProjectedVertex& result = results[first + i];
+            if (zs[i] <= 0) {
+                result = {0, 0, false, false};
+                continue;
+            }
+            result.screenX = xs[i];
+            result.screenY = ys[i];
+            result.visible = true;
+            result.onScreen = (xs[i] >= ProjectionConstants::SCREEN_LEFT && xs[i] <= right &&
+                               ys[i] >= ProjectionConstants::SCREEN_TOP && ys[i] <= bottom);
+        }
+    }
+}
+
+// =============================================================================
+// View Culling
+// =============================================================================
+//
+// A point projects left of the screen if x * 256 / z < -160 (in original
+// pixels), so all of a box does if the largest x * 256 + (160 + margin) * z
+// in it is negative, and likewise for the other three edges. Each of these
+// is linear in x, y and z, so the largest or smallest value over the box is
+// at a corner and can be picked out one axis at a time.
+//
+// =============================================================================
+
+bool isBoxOffScreen(const ViewBox& box) {
+    using namespace ProjectionConstants;
+
+    if (box.minX < INT32_MIN || box.maxX > INT32_MAX ||
+        box.minY < INT32_MIN || box.maxY > INT32_MAX ||
+        box.minZ < INT32_MIN || box.maxZ > INT32_MAX) {
+        return false;
+    }
+
+    // Behind the camera
+    if (box.maxZ <= 0) {
+        return true;
+    }
+
+    constexpr int64_t MARGIN = 32;
+    constexpr int64_t LEFT = ORIGINAL_CENTER_X + MARGIN;
+    constexpr int64_t RIGHT = ScreenBuffer::LOGICAL_WIDTH - ORIGINAL_CENTER_X + MARGIN;
+    constexpr int64_t TOP = ORIGINAL_CENTER_Y + MARGIN;
+    constexpr int64_t BOTTOM = ScreenBuffer::LOGICAL_HEIGHT - ORIGINAL_CENTER_Y + MARGIN;
+
+    return box.maxX * FOCAL_LENGTH + LEFT * box.maxZ < 0 ||
+           box.minX * FOCAL_LENGTH - RIGHT * box.maxZ > 0 ||
+           box.maxY * FOCAL_LENGTH + TOP * box.maxZ < 0 ||
+           box.minY * FOCAL_LENGTH - BOTTOM * box.maxZ > 0;
+}
@@ -46,6 +46,9 @@ namespace ProjectionConstants {
     inline int CENTER_X() { return ORIGINAL_CENTER_X * ScreenBuffer::PIXEL_SCALE(); }
     inline int CENTER_Y() { return ORIGINAL_CENTER_Y * ScreenBuffer::PIXEL_SCALE(); }
 
+    // Pixels per tile of offset at a depth of one tile (before SCALE)
+    constexpr int FOCAL_LENGTH = 256;
+
     // Scale factor for projection (matches original's effective focal length)
     inline int SCALE() { return ScreenBuffer::PIXEL_SCALE(); }
 
@@ -71,4 +74,34 @@ ProjectedVertex projectVertex(Fixed x, Fixed y, Fixed z);
 // Project a Vec3 onto the screen (convenience wrapper)
 ProjectedVertex projectVertex(const Vec3& v);
 
+// Project count camera-relative points at once, several at a time with the
+// packed fixed-point kernels (fixed_simd.h)
+// Each result is identical to projectVertex() for the same point
+void projectVertices(const Vec3* points, int count, ProjectedVertex* results);
+
+// =============================================================================
+// View Culling
+// =============================================================================
+//
+// A whole object can be skipped before any of its vertices are transformed
+// if a box around it is certainly off screen: behind the camera, or past
+// one edge of the screen. The edges are tested with a margin of 32 original
+// pixels, more than the truncation in projectVertex() can move a point, so
+// whatever is culled would not have drawn a single pixel.
+//
+// =============================================================================
+
+// Camera-relative box in raw 8.24 units, kept in 64 bits so that a position
+// plus a radius can't overflow
+struct ViewBox {
+    int64_t minX, maxX;
+    int64_t minY, maxY;
+    int64_t minZ, maxZ;
+};
+
+// True if no point in the box can project onto the screen
+// (A box reaching outside the 8.24 range is never culled, as the points in
+// it would wrap)
+bool isBoxOffScreen(const ViewBox& box);
+
 #endif // LANDER_PROJECTION_H
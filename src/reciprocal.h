@@ -0,0 +1,171 @@
+#ifndef LANDER_RECIPROCAL_H
+#define LANDER_RECIPROCAL_H
+
+#include <cstdint>
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+// =============================================================================
+// Division by Reciprocal
+// =============================================================================
+//
+// A 64-bit integer divide is one of the slowest integer instructions, and
+// the rasterizer does up to three per triangle to set up its edge slopes.
+// Where the same divisor comes up again and again (edge heights are a few
+// hundred pixels at most), Reciprocal turns the divide into two multiplies:
+//
+//   const Reciprocal& height = Reciprocal::forSmall(dy);
+//   int64_t slope = height.divide(dx << 16);   // == (dx << 16) / dy, exactly
+//
+// The reciprocal is a 0.64 fixed-point fraction m close to 2^64 / |d|, found
+// without dividing: the divisor is normalized to [0.5, 1), a 256-entry table
+// gives its reciprocal to 8 bits, and three Newton-Raphson steps
+// (y' = y * (2 - d * y), each doubling the bits) take it to 64 bits. The
+// result is never above 2^64 / |d| and at most 3 below.
+//
+// divide() multiplies by m for a quotient at most two below the true one
+// for any |n| < 2^63, then corrects it against the remainder. So the
+// quotient always equals the C++ division n / d (truncated towards zero),
+// and replacing a divide with a Reciprocal never changes a pixel.
+//
+// Constructing a Reciprocal costs three or four hardware divides on a
+// recent x86 (test_reciprocal times both), so one is only worth making for
+// a divisor that is used many times. forSmall() keeps ready-made ones for
+// every divisor below SMALL_DIVISORS.
+//
+// =============================================================================
+
+namespace ReciprocalDetail {
+    // High 64 bits of a 64 x 64-bit unsigned product
+    inline uint64_t mulHigh(uint64_t a, uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+        return static_cast<uint64_t>((static_cast<unsigned __int128>(a) * b) >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+        return __umulh(a, b);
+#else
+        uint64_t aLow = a & 0xFFFFFFFFu, aHigh = a >> 32;
+        uint64_t bLow = b & 0xFFFFFFFFu, bHigh = b >> 32;
+        uint64_t low = aLow * bLow;
+        uint64_t middle1 = aHigh * bLow + (low >> 32);
+        uint64_t middle2 = aLow * bHigh + (middle1 & 0xFFFFFFFFu);
+        return aHigh * bHigh + (middle1 >> 32) + (middle2 >> 32);
+#endif
+    }
+
+    // Shift that moves the top set bit of a non-zero value to bit 31
+    inline int normalizeShift(uint32_t value) {
+        int shift = 0;
+        if ((value & 0xFFFF0000u) == 0) { shift += 16; value <<= 16; }
+        if ((value & 0xFF000000u) == 0) { shift += 8; value <<= 8; }
+        if ((value & 0xF0000000u) == 0) { shift += 4; value <<= 4; }
+        if ((value & 0xC0000000u) == 0) { shift += 2; value <<= 2; }
+        if ((value & 0x80000000u) == 0) { shift += 1; }
+        return shift;
+    }
+
+    // 1 / d in 1.15 fixed point for d in [0.5, 1), indexed by the 8 bits
+    // after the leading one. Each entry is for the top of its interval, so
+    // it is never too big and is within 1/256 of the reciprocal
+    struct SeedTable {
+        uint16_t seeds[256];
+
+        constexpr SeedTable() : seeds() {
+            for (int i = 0; i < 256; i++) {
+                seeds[i] = static_cast<uint16_t>((1u << 24) / static_cast<uint32_t>(257 + i));
+            }
+        }
+    };
+
+    inline constexpr SeedTable seedTable{};
+}
+
+class Reciprocal {
+public:
+    // Divisors below this have a ready-made reciprocal in forSmall()
+    static constexpr int SMALL_DIVISORS = 1024;
+
+    // Reciprocal of 1
+    Reciprocal() : magic(UINT64_MAX), absDivisor(1), negative(false) {}
+
+    // The divisor must not be zero
+    explicit Reciprocal(int32_t divisor) {
+        using namespace ReciprocalDetail;
+
+        negative = divisor < 0;
+        absDivisor = negative ? 0u - static_cast<uint32_t>(divisor) : static_cast<uint32_t>(divisor);
+
+        // Normalize: d = normalized / 2^32 is in [0.5, 1), and 1 / d is in
+        // (1, 2] as 1.63 fixed point in y
+        int shift = normalizeShift(absDivisor);
+        uint32_t normalized = absDivisor << shift;
+        uint64_t y;
+        if (normalized == 0x80000000u) {
+            // Powers of two: 1 / d is exactly 2, just out of range
+            y = UINT64_MAX;
+        } else {
+            y = static_cast<uint64_t>(seedTable.seeds[(normalized >> 23) & 0xFF]) << 48;
+            uint64_t d = static_cast<uint64_t>(normalized) << 32;
+            for (int step = 0; step < 3; step++) {
+                // error = 1 - d * y, then y += y * error
+                uint64_t product = mulHigh(d, y);
+                int64_t error = static_cast<int64_t>((uint64_t(1) << 63) - product);
+                if (error >= 0) {
+                    y += mulHigh(y, static_cast<uint64_t>(error) << 1);
+                } else {
+                    y -= mulHigh(y, static_cast<uint64_t>(-error) << 1);
+                }
+            }
+
+            // Truncation in the steps can leave y an ulp or two high
+            y -= 2;
+        }
+
+        // 2^64 / |divisor| = (2^63 / d) >> (31 - shift); 1 is just out of range
+        magic = (shift == 31) ? UINT64_MAX : y >> (31 - shift);
+    }
+
+    // numerator / divisor, truncated towards zero (|numerator| < 2^63)
+    int64_t divide(int64_t numerator) const {
+        uint64_t absNumerator = numerator < 0 ? 0u - static_cast<uint64_t>(numerator)
+                                              : static_cast<uint64_t>(numerator);
+
+        // Estimate, then correct against the remainder (without branches,
+        // as whether a step is needed is close to random)
+        uint64_t quotient = ReciprocalDetail::mulHigh(absNumerator, magic);
+        uint64_t remainder = absNumerator - quotient * absDivisor;
+        for (int step = 0; step < 2; step++) {
+            uint64_t carry = remainder >= absDivisor ? 1 : 0;
+            quotient += carry;
+            remainder -= carry * absDivisor;
+        }
+
+        bool negativeResult = (numerator < 0) != negative;
+        return negativeResult ? -static_cast<int64_t>(quotient) : static_cast<int64_t>(quotient);
+    }
+
+    int32_t getDivisor() const {
+        return negative ? static_cast<int32_t>(0u - absDivisor) : static_cast<int32_t>(absDivisor);
+    }
+
+    // Ready-made reciprocal of 1 <= divisor < SMALL_DIVISORS
+    static const Reciprocal& forSmall(int divisor) {
+        struct SmallTable {
+            Reciprocal entries[SMALL_DIVISORS];
+            SmallTable() {
+                for (int i = 1; i < SMALL_DIVISORS; i++) {
+                    entries[i] = Reciprocal(i);
+                }
+            }
+        };
+        static const SmallTable table;
+        return table.entries[divisor];
+    }
+
+private:
+    uint64_t magic;         // About 2^64 / absDivisor
+    uint32_t absDivisor;
+    bool negative;
+};
+
+#endif // LANDER_RECIPROCAL_H
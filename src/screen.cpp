@@ -1,4 +1,7 @@
 #include "screen.h"
+#include "frame_stats.h"
+#include "reciprocal.h"
+#include "cpu_dispatch.h"
 #include <algorithm>
 
 // Include stb_image_write implementation in this compilation unit
@@ -10,13 +13,76 @@ namespace DisplayConfig {
     int scale = 4;  // Initialize to 4x (1280x1024)
 }
 
+namespace RasterConfig {
+    RasterBackend backend = RasterBackend::Scanline;
+    bool terrainStrips = true;
+}
+
+// Pack a color into the buffer's 32-bit RGBA layout
+static uint32_t packColor(Color color) {
+    return (static_cast<uint32_t>(color.r)) |
+           (static_cast<uint32_t>(color.g) << 8) |
+           (static_cast<uint32_t>(color.b) << 16) |
+           (static_cast<uint32_t>(color.a) << 24);
+}
+
+// 16.16 slope dx/dy of a triangle edge (dy > 0). Edge heights are mostly
+// small, so they nearly always have a ready-made reciprocal
+static int64_t edgeSlope(int dx, int dy) {
+    int64_t numerator = (int64_t)dx << 16;
+    if (dy < Reciprocal::SMALL_DIVISORS) {
+        return Reciprocal::forSmall(dy).divide(numerator);
+    }
+    return numerator / dy;
+}
+
+// Reject triangles that are entirely far off screen, clamp the rest to a
+// sane coordinate range and sort the vertices so that y0 <= y1 <= y2.
+// Both rasterizer backends start from the same prepared triangle.
+static bool prepareTriangle(int& x0, int& y0, int& x1, int& y1, int& x2, int& y2) {
+    // Early rejection: if all vertices are way off screen, skip
+    // This prevents massive iteration counts when projection produces huge coordinates
+    constexpr int MAX_COORD = 10000;  // Reasonable maximum for clipping
+    if ((x0 < -MAX_COORD && x1 < -MAX_COORD && x2 < -MAX_COORD) ||
+        (x0 > MAX_COORD && x1 > MAX_COORD && x2 > MAX_COORD) ||
+        (y0 < -MAX_COORD && y1 < -MAX_COORD && y2 < -MAX_COORD) ||
+        (y0 > MAX_COORD && y1 > MAX_COORD && y2 > MAX_COORD)) {
+        return false;
+    }
+
+    // Clamp extreme coordinates to prevent huge loops
+    auto clampCoord = [MAX_COORD](int c) {
+        return std::max(-MAX_COORD, std::min(MAX_COORD, c));
+    };
+    x0 = clampCoord(x0); y0 = clampCoord(y0);
+    x1 = clampCoord(x1); y1 = clampCoord(y1);
+    x2 = clampCoord(x2); y2 = clampCoord(y2);
+
+    // Sort vertices by y-coordinate (y0 <= y1 <= y2)
+    // This matches the original Lander algorithm which processes from bottom to top
+    if (y0 > y1) {
+        std::swap(x0, x1);
+        std::swap(y0, y1);
+    }
+    if (y1 > y2) {
+        std::swap(x1, x2);
+        std::swap(y1, y2);
+    }
+    if (y0 > y1) {
+        std::swap(x0, x1);
+        std::swap(y0, y1);
+    }
+    return true;
+}
+
 ScreenBuffer::ScreenBuffer() {
-    buffer = new uint8_t[getBufferSize()];
+    ownBuffer = new uint8_t[getBufferSize()];
+    buffer = ownBuffer;
     clear();
 }
 
 ScreenBuffer::~ScreenBuffer() {
-    delete[] buffer;
+    delete[] ownBuffer;
 }
 
 void ScreenBuffer::clear(Color color) {
@@ -39,6 +105,16 @@ void ScreenBuffer::clear(Color color) {
     }
 }
 
+void ScreenBuffer::prefault() {
+    // Sizing writes every element; clearing keeps the capacity
+    unionSpans.resize(UNION_SPAN_RESERVE);
+    unionSorted.resize(UNION_SPAN_RESERVE);
+    unionRowStart.assign(MAX_PHYSICAL_HEIGHT + 2, 0);
+    unionSpans.clear();
+    unionSorted.clear();
+    unionRowStart.clear();
+}
+
 void ScreenBuffer::plotPixel(int x, int y, Color color) {
     // Convert logical to physical and plot single pixel
     plotPhysicalPixel(toPhysicalX(x), toPhysicalY(y), color);
@@ -58,47 +134,26 @@ void ScreenBuffer::plotPhysicalPixel(int px, int py, Color color) {
 }
 
 void ScreenBuffer::drawTriangle(int x0, int y0, int x1, int y1, int x2, int y2, Color color) {
-    // Early rejection: if all vertices are way off screen, skip
-    // This prevents massive iteration counts when projection produces huge coordinates
-    constexpr int MAX_COORD = 10000;  // Reasonable maximum for clipping
-    if ((x0 < -MAX_COORD && x1 < -MAX_COORD && x2 < -MAX_COORD) ||
-        (x0 > MAX_COORD && x1 > MAX_COORD && x2 > MAX_COORD) ||
-        (y0 < -MAX_COORD && y1 < -MAX_COORD && y2 < -MAX_COORD) ||
-        (y0 > MAX_COORD && y1 > MAX_COORD && y2 > MAX_COORD)) {
-        return;
-    }
+    frameStats.trianglesDrawn++;
 
-    // Clamp extreme coordinates to prevent huge loops
-    auto clampCoord = [MAX_COORD](int c) {
-        return std::max(-MAX_COORD, std::min(MAX_COORD, c));
-    };
-    x0 = clampCoord(x0); y0 = clampCoord(y0);
-    x1 = clampCoord(x1); y1 = clampCoord(y1);
-    x2 = clampCoord(x2); y2 = clampCoord(y2);
-
-    // Sort vertices by y-coordinate (y0 <= y1 <= y2)
-    // This matches the original Lander algorithm which processes from bottom to top
-    if (y0 > y1) {
-        std::swap(x0, x1);
-        std::swap(y0, y1);
-    }
-    if (y1 > y2) {
-        std::swap(x1, x2);
-        std::swap(y1, y2);
-    }
-    if (y0 > y1) {
-        std::swap(x0, x1);
-        std::swap(y0, y1);
+    if (RasterConfig::backend == RasterBackend::EdgeBlocks) {
+        drawTriangleBlocks(x0, y0, x1, y1, x2, y2, color);
+    } else {
+        drawTriangleScanline(x0, y0, x1, y1, x2, y2, color);
     }
+}
 
-    // Now y0 <= y1 <= y2 (top to bottom in screen coordinates)
-
+// Walk a prepared triangle (y0 <= y1 <= y2) one row at a time, passing
+// each row's span to span(x1, x2, y). The ends are inclusive and usually,
+// but not always, in order
+template <typename Span>
+static void walkTriangleSpans(int x0, int y0, int x1, int y1, int x2, int y2, Span span) {
     // Degenerate triangle check
     if (y0 == y2) {
         // Horizontal line - just draw from min x to max x
         int minX = std::min({x0, x1, x2});
         int maxX = std::max({x0, x1, x2});
-        drawHorizontalLine(minX, maxX, y0, color);
+        span(minX, maxX, y0);
         return;
     }
 
@@ -108,12 +163,12 @@ void ScreenBuffer::drawTriangle(int x0, int y0, int x1, int y1, int x2, int y2,
     // Calculate inverse slopes (dx/dy) for the two edges from top vertex
     // Edge from (x0,y0) to (x2,y2) - the long edge spanning full height
     int dy02 = y2 - y0;
-    int64_t dx02 = ((int64_t)(x2 - x0) << 16) / dy02;
+    int64_t dx02 = edgeSlope(x2 - x0, dy02);
 
     if (y0 == y1) {
         // Flat-top triangle: just draw bottom half
         int dy12 = y2 - y1;
-        int64_t dx12 = ((int64_t)(x2 - x1) << 16) / dy12;
+        int64_t dx12 = edgeSlope(x2 - x1, dy12);
 
         int64_t curx1 = (int64_t)x0 << 16;
         int64_t curx2 = (int64_t)x1 << 16;
@@ -125,14 +180,14 @@ void ScreenBuffer::drawTriangle(int x0, int y0, int x1, int y1, int x2, int y2,
         }
 
         for (int y = y0; y <= y2; y++) {
-            drawHorizontalLine((int)(curx1 >> 16), (int)(curx2 >> 16), y, color);
+            span((int)(curx1 >> 16), (int)(curx2 >> 16), y);
             curx1 += dx02;
             curx2 += dx12;
         }
     } else if (y1 == y2) {
         // Flat-bottom triangle: just draw top half
         int dy01 = y1 - y0;
-        int64_t dx01 = ((int64_t)(x1 - x0) << 16) / dy01;
+        int64_t dx01 = edgeSlope(x1 - x0, dy01);
 
         int64_t curx1 = (int64_t)x0 << 16;
         int64_t curx2 = (int64_t)x0 << 16;
@@ -143,17 +198,17 @@ void ScreenBuffer::drawTriangle(int x0, int y0, int x1, int y1, int x2, int y2,
         }
 
         for (int y = y0; y <= y1; y++) {
-            drawHorizontalLine((int)(curx1 >> 16), (int)(curx2 >> 16), y, color);
+            span((int)(curx1 >> 16), (int)(curx2 >> 16), y);
             curx1 += dx01;
             curx2 += dx02;
         }
     } else {
         // General case: split into flat-bottom and flat-top triangles
         int dy01 = y1 - y0;
-        int64_t dx01 = ((int64_t)(x1 - x0) << 16) / dy01;
+        int64_t dx01 = edgeSlope(x1 - x0, dy01);
 
         int dy12 = y2 - y1;
-        int64_t dx12 = ((int64_t)(x2 - x1) << 16) / dy12;
+        int64_t dx12 = edgeSlope(x2 - x1, dy12);
 
         // Draw top half (from y0 to y1)
         int64_t curx1 = (int64_t)x0 << 16;
@@ -167,7 +222,7 @@ void ScreenBuffer::drawTriangle(int x0, int y0, int x1, int y1, int x2, int y2,
         }
 
         for (int y = y0; y < y1; y++) {
-            drawHorizontalLine((int)(curx1 >> 16), (int)(curx2 >> 16), y, color);
+            span((int)(curx1 >> 16), (int)(curx2 >> 16), y);
             curx1 += slope_left;
             curx2 += slope_right;
         }
@@ -194,13 +249,417 @@ void ScreenBuffer::drawTriangle(int x0, int y0, int x1, int y1, int x2, int y2,
         }
 
         for (int y = y1; y <= y2; y++) {
-            drawHorizontalLine((int)(curx1 >> 16), (int)(curx2 >> 16), y, color);
+            span((int)(curx1 >> 16), (int)(curx2 >> 16), y);
             curx1 += slope_left;
             curx2 += slope_right;
         }
     }
 }
 
+void ScreenBuffer::drawTriangleScanline(int x0, int y0, int x1, int y1, int x2, int y2, Color color) {
+    if (!prepareTriangle(x0, y0, x1, y1, x2, y2)) {
+        return;
+    }
+
+    walkTriangleSpans(x0, y0, x1, y1, x2, y2, [&](int spanX1, int spanX2, int y) {
+        drawHorizontalLine(spanX1, spanX2, y, color);
+    });
+}
+
+// =============================================================================
+// Triangle Unions
+// =============================================================================
+//
+// Triangles of one colour drawn one after another leave the union of their
+// pixels, whatever the order, so overlapping ones (such as the faces of an
+// object's shadow) can be filled together with every pixel written once.
+// Each triangle is walked exactly as drawTriangleScanline() walks it, its
+// spans are clipped and bucketed by row, and each row's spans are sorted and
+// merged before filling. The result is identical to drawing the triangles.
+//
+// =============================================================================
+
+void ScreenBuffer::drawTriangleUnion(const int* vertices, int triangleCount, Color color) {
+    frameStats.trianglesDrawn += triangleCount;
+
+    const int width = PHYSICAL_WIDTH();
+    const int height = PHYSICAL_HEIGHT();
+    int top = height;
+    int bottom = -1;
+
+    unionSpans.clear();
+    for (int i = 0; i < triangleCount; i++) {
+        const int* v = vertices + 6 * i;
+        int x0 = v[0], y0 = v[1], x1 = v[2], y1 = v[3], x2 = v[4], y2 = v[5];
+        if (!prepareTriangle(x0, y0, x1, y1, x2, y2)) {
+            continue;
+        }
+
+        // Clipped as drawHorizontalLine() clips
+        walkTriangleSpans(x0, y0, x1, y1, x2, y2, [&](int spanX1, int spanX2, int y) {
+            if (y < 0 || y >= height) return;
+            if (spanX1 > spanX2) std::swap(spanX1, spanX2);
+            if (spanX2 < 0 || spanX1 >= width) return;
+            unionSpans.push_back({ std::max(spanX1, 0), std::min(spanX2, width - 1), y });
+            top = std::min(top, y);
+            bottom = std::max(bottom, y);
+        });
+    }
+    if (unionSpans.empty()) {
+        return;
+    }
+
+    // Bucket the spans by row
+    unionRowStart.assign(bottom - top + 2, 0);
+    for (const UnionSpan& span : unionSpans) {
+        unionRowStart[span.y - top + 1]++;
+    }
+    for (size_t row = 1; row < unionRowStart.size(); row++) {
+        unionRowStart[row] += unionRowStart[row - 1];
+    }
+    unionSorted.resize(unionSpans.size());
+    for (const UnionSpan& span : unionSpans) {
+        unionSorted[unionRowStart[span.y - top]++] = span;
+    }
+
+    // unionRowStart[row] is now the end of the row's spans
+    int first = 0;
+    for (int row = 0; row <= bottom - top; row++) {
+        int last = unionRowStart[row];
+
+        // Rows hold a few spans: insertion sort them by left end
+        for (int i = first + 1; i < last; i++) {
+            UnionSpan span = unionSorted[i];
+            int j = i;
+            while (j > first && unionSorted[j - 1].x1 > span.x1) {
+                unionSorted[j] = unionSorted[j - 1];
+                j--;
+            }
+            unionSorted[j] = span;
+        }
+
+        // Merge spans that overlap or touch, and fill
+        int i = first;
+        while (i < last) {
+            int x1 = unionSorted[i].x1;
+            int x2 = unionSorted[i].x2;
+            for (i++; i < last && unionSorted[i].x1 <= x2 + 1; i++) {
+                x2 = std::max(x2, unionSorted[i].x2);
+            }
+            drawHorizontalLine(x1, x2, top + row, color);
+        }
+        first = last;
+    }
+}
+
+// =============================================================================
+// Block Rasterization (Edge Functions)
+// =============================================================================
+//
+// The scanline walker fills row y from floor(A(y)) to floor(B(y)), where A and
+// B are edges evaluated in 16.16 from their top vertex. For a pixel px, let
+// D(px, y) = E(y) - (px << 16) for each edge E. Then
+//
+//     px >= floor(E(y))  <=>  D < 1.0        px <= floor(E(y))  <=>  D >= 0
+//
+// so the pixel is covered when min(DA, DB) < 1.0 and max(DA, DB) >= 0. D is
+// linear in both px and y, so its extremes over a block are found at the
+// block corners, which lets a whole 8x8 block be accepted or rejected from
+// four values per edge. Because the tests use the scanline walker's own
+// truncated slopes, both backends cover exactly the same pixels.
+//
+// =============================================================================
+
+// 1.0 in the 16.16 edge format
+static constexpr int64_t EDGE_ONE = (int64_t)1 << 16;
+
+// Coverage bits for one row of a block, starting at column x (width <= 32)
+// Solving D < 1.0 and D >= 0 for px gives the first and last covered column
+static uint32_t edgeRowMask(int64_t edgeA, int64_t edgeB, int x, int width) {
+    int64_t first = (std::min(edgeA, edgeB) >> 16) - x;
+    int64_t last = (std::max(edgeA, edgeB) >> 16) - x;
+    if (first >= width || last < 0) {
+        return 0;
+    }
+    first = std::max<int64_t>(first, 0);
+    last = std::min<int64_t>(last, width - 1);
+
+    uint64_t bits = ((uint64_t)2 << last) - ((uint64_t)1 << first);
+    return static_cast<uint32_t>(bits);
+}
+
+void ScreenBuffer::fillTrapezoidSmall(const RasterEdge& a, const RasterEdge& b,
+                                      int yTop, int yBottom, uint32_t rgba) {
+    int physWidth = PHYSICAL_WIDTH();
+    yTop = std::max(yTop, 0);
+    yBottom = std::min(yBottom, PHYSICAL_HEIGHT() - 1);
+    if (yTop > yBottom) {
+        return;
+    }
+
+    // Bounding box of the trapezoid (edges are straight, so the extremes
+    // are on the first and last rows)
+    int64_t a0 = a.at(yTop), a1 = a.at(yBottom);
+    int64_t b0 = b.at(yTop), b1 = b.at(yBottom);
+    int minX = std::max((int)(std::min({a0, a1, b0, b1}) >> 16), 0);
+    int maxX = std::min((int)(std::max({a0, a1, b0, b1}) >> 16), physWidth - 1);
+    if (minX > maxX) {
+        return;
+    }
+
+    int width = maxX - minX + 1;
+    for (int y = yTop; y <= yBottom; y++) {
+        uint32_t* dest = reinterpret_cast<uint32_t*>(buffer + physicalToOffset(minX, y));
+        int64_t edgeA = a.at(y);
+        int64_t edgeB = b.at(y);
+
+        // Wide boxes are tested in 32-pixel chunks
+        for (int x = 0; x < width; x += 32) {
+            int chunk = std::min(width - x, 32);
+            uint32_t mask = edgeRowMask(edgeA, edgeB, minX + x, chunk);
+            for (int i = 0; mask != 0; i++, mask >>= 1) {
+                if (mask & 1) {
+                    dest[x + i] = rgba;
+                    frameStats.pixelsFilled++;
+                }
+            }
+        }
+    }
+}
+
+void ScreenBuffer::fillTrapezoidBlocks(const RasterEdge& a, const RasterEdge& b,
+                                       int yTop, int yBottom, uint32_t rgba) {
+    int physWidth = PHYSICAL_WIDTH();
+    yTop = std::max(yTop, 0);
+    yBottom = std::min(yBottom, PHYSICAL_HEIGHT() - 1);
+
+    // Blocks are aligned to the screen; both screen dimensions are always a
+    // multiple of BLOCK_SIZE, so blocks never straddle the screen edge
+    for (int blockY = yTop & ~(BLOCK_SIZE - 1); blockY <= yBottom; blockY += BLOCK_SIZE) {
+        int rowFirst = std::max(blockY, yTop);
+        int rowLast = std::min(blockY + BLOCK_SIZE - 1, yBottom);
+        bool allRows = (rowFirst == blockY && rowLast == blockY + BLOCK_SIZE - 1);
+
+        // Edge extremes over the rows of this band
+        int64_t a0 = a.at(rowFirst), a1 = a.at(rowLast);
+        int64_t b0 = b.at(rowFirst), b1 = b.at(rowLast);
+        int64_t aMin = std::min(a0, a1), aMax = std::max(a0, a1);
+        int64_t bMin = std::min(b0, b1), bMax = std::max(b0, b1);
+
+        int minX = std::max((int)(std::min(aMin, bMin) >> 16), 0);
+        int maxX = std::min((int)(std::max(aMax, bMax) >> 16), physWidth - 1);
+        if (minX > maxX) {
+            continue;
+        }
+
+        for (int blockX = minX & ~(BLOCK_SIZE - 1); blockX <= maxX; blockX += BLOCK_SIZE) {
+            // D at the block's left column is the largest, at its right the smallest
+            int64_t left = (int64_t)blockX << 16;
+            int64_t right = (int64_t)(blockX + BLOCK_SIZE - 1) << 16;
+            int64_t daMax = aMax - left, daMin = aMin - right;
+            int64_t dbMax = bMax - left, dbMin = bMin - right;
+
+            // Trivial reject: every pixel is left of both edges or right of both
+            if ((daMin >= EDGE_ONE && dbMin >= EDGE_ONE) || (daMax < 0 && dbMax < 0)) {
+                continue;
+            }
+
+            // Trivial accept: one edge is left of every pixel, the other right
+            bool covered = allRows &&
+                ((daMax < EDGE_ONE && dbMin >= 0) || (dbMax < EDGE_ONE && daMin >= 0));
+
+            for (int y = rowFirst; y <= rowLast; y++) {
+                uint32_t* dest = reinterpret_cast<uint32_t*>(buffer + physicalToOffset(blockX, y));
+                if (covered) {
+                    for (int i = 0; i < BLOCK_SIZE; i++) {
+                        dest[i] = rgba;
+                    }
+                    frameStats.pixelsFilled += BLOCK_SIZE;
+                    continue;
+                }
+
+                uint32_t mask = edgeRowMask(a.at(y), b.at(y), blockX, BLOCK_SIZE);
+                if (mask == (1u << BLOCK_SIZE) - 1) {
+                    for (int i = 0; i < BLOCK_SIZE; i++) {
+                        dest[i] = rgba;
+                    }
+                    frameStats.pixelsFilled += BLOCK_SIZE;
+                    continue;
+                }
+                for (int i = 0; mask != 0; i++, mask >>= 1) {
+                    if (mask & 1) {
+                        dest[i] = rgba;
+                        frameStats.pixelsFilled++;
+                    }
+                }
+            }
+        }
+    }
+}
+
+void ScreenBuffer::drawTriangleBlocks(int x0, int y0, int x1, int y1, int x2, int y2, Color color) {
+    if (!prepareTriangle(x0, y0, x1, y1, x2, y2)) {
+        return;
+    }
+
+    // A single row is a plain span, exactly as in the scanline walker
+    if (y0 == y2) {
+        drawHorizontalLine(std::min({x0, x1, x2}), std::max({x0, x1, x2}), y0, color);
+        return;
+    }
+
+    const StripCorner v0 = {x0, y0};
+    const StripCorner v1 = {x1, y1};
+    const StripCorner v2 = {x2, y2};
+    RasterEdge longEdge = makeEdge(v0, v2);
+    RasterEdge upperEdge = makeEdge(v0, v1);
+    RasterEdge lowerEdge = makeEdge(v1, v2);
+
+    int boxWidth = std::max({x0, x1, x2}) - std::min({x0, x1, x2}) + 1;
+    int boxHeight = y2 - y0 + 1;
+    bool small = boxWidth * boxHeight <= SMALL_TRIANGLE_AREA;
+
+    auto fill = [&](const RasterEdge& a, const RasterEdge& b, int yTop, int yBottom) {
+        if (small) {
+            fillTrapezoidSmall(a, b, yTop, yBottom, packColor(color));
+        } else {
+            fillTrapezoidBlocks(a, b, yTop, yBottom, packColor(color));
+        }
+    };
+
+    // Same row split as the scanline walker: the upper short edge runs to the
+    // row before the middle vertex (or to the last row of a flat-bottom
+    // triangle) and the lower short edge takes over from the middle vertex
+    if (y0 == y1) {
+        fill(longEdge, lowerEdge, y0, y2);
+    } else if (y1 == y2) {
+        fill(longEdge, upperEdge, y0, y2);
+    } else {
+        fill(longEdge, upperEdge, y0, y1 - 1);
+        fill(longEdge, lowerEdge, y1, y2);
+    }
+}
+
+// =============================================================================
+// Terrain Strip Rasterization
+// =============================================================================
+//
+// Adjacent landscape tiles share their left/right edges, and the two triangles
+// of a tile share the diagonal, so drawing a row as independent triangles
+// computes most edge slopes two or three times. The strip rasterizer computes
+// each edge once and fills the triangles in the same order as drawTile().
+//
+// Each edge is walked from its top vertex with a truncated 16.16 slope, which
+// is exactly how drawTriangle() evaluates its edges, so for any y the edge
+// position is identical whichever triangle is being filled.
+//
+// =============================================================================
+
+ScreenBuffer::RasterEdge ScreenBuffer::makeEdge(const StripCorner& a, const StripCorner& b) {
+    const StripCorner& top = (a.y <= b.y) ? a : b;
+    const StripCorner& bottom = (a.y <= b.y) ? b : a;
+
+    RasterEdge edge;
+    edge.x = (int64_t)top.x << 16;
+    edge.yTop = top.y;
+    int dy = bottom.y - top.y;
+    edge.slope = (dy != 0) ? edgeSlope(bottom.x - top.x, dy) : 0;
+    return edge;
+}
+
+void ScreenBuffer::fillStripTriangle(const StripCorner* corner[3],
+                                     const RasterEdge* edgeOpposite[3], Color color) {
+    // Sort corner indices by y (same ordering rules as drawTriangle)
+    int i0 = 0, i1 = 1, i2 = 2;
+    if (corner[i0]->y > corner[i1]->y) std::swap(i0, i1);
+    if (corner[i1]->y > corner[i2]->y) std::swap(i1, i2);
+    if (corner[i0]->y > corner[i1]->y) std::swap(i0, i1);
+
+    int y0 = corner[i0]->y;
+    int y1 = corner[i1]->y;
+    int y2 = corner[i2]->y;
+
+    if (y0 == y2) {
+        int minX = std::min({corner[0]->x, corner[1]->x, corner[2]->x});
+        int maxX = std::max({corner[0]->x, corner[1]->x, corner[2]->x});
+        drawHorizontalLine(minX, maxX, y0, color);
+        return;
+    }
+
+    // The long edge (0->2) spans the full height, the short edges are
+    // 0->1 above the middle vertex and 1->2 from the middle vertex down.
+    // A flat-bottom triangle walks edge 0->1 all the way to its last row.
+    const RasterEdge& longEdge = *edgeOpposite[i1];
+    const RasterEdge& upperEdge = *edgeOpposite[i2];
+    const RasterEdge& lowerEdge = *edgeOpposite[i0];
+    int splitY = (y1 == y2) ? y2 + 1 : y1;
+
+    // Rows outside the screen would be rejected by drawHorizontalLine
+    int yStart = std::max(y0, 0);
+    int yEnd = std::min(y2, PHYSICAL_HEIGHT() - 1);
+
+    for (int y = yStart; y <= yEnd; y++) {
+        const RasterEdge& shortEdge = (y < splitY) ? upperEdge : lowerEdge;
+        drawHorizontalLine((int)(longEdge.at(y) >> 16), (int)(shortEdge.at(y) >> 16), y, color);
+    }
+}
+
+void ScreenBuffer::drawQuadStrip(const StripCorner* top, const StripCorner* bottom,
+                                 const Color* colors, int quadCount) {
+    // Corners outside this range are clamped by drawTriangle, which changes
+    // the edges, so quads that touch them are handed to drawTriangle instead
+    constexpr int MAX_COORD = 10000;
+    auto inRange = [MAX_COORD](const StripCorner& c) {
+        return c.x >= -MAX_COORD && c.x <= MAX_COORD &&
+               c.y >= -MAX_COORD && c.y <= MAX_COORD;
+    };
+
+    if (quadCount <= 0) {
+        return;
+    }
+
+    // The left edge of each quad is the right edge of the previous one
+    RasterEdge leftEdge = makeEdge(top[0], bottom[0]);
+
+    for (int i = 0; i < quadCount; i++) {
+        const StripCorner& topLeft = top[i];
+        const StripCorner& topRight = top[i + 1];
+        const StripCorner& bottomLeft = bottom[i];
+        const StripCorner& bottomRight = bottom[i + 1];
+
+        RasterEdge rightEdge = makeEdge(topRight, bottomRight);
+
+        if (RasterConfig::backend != RasterBackend::Scanline ||
+            !inRange(topLeft) || !inRange(topRight) ||
+            !inRange(bottomLeft) || !inRange(bottomRight)) {
+            drawTriangle(topLeft.x, topLeft.y, topRight.x, topRight.y,
+                         bottomLeft.x, bottomLeft.y, colors[i]);
+            drawTriangle(topRight.x, topRight.y, bottomRight.x, bottomRight.y,
+                         bottomLeft.x, bottomLeft.y, colors[i]);
+            leftEdge = rightEdge;
+            continue;
+        }
+
+        RasterEdge topEdge = makeEdge(topLeft, topRight);
+        RasterEdge bottomEdge = makeEdge(bottomLeft, bottomRight);
+        RasterEdge diagonal = makeEdge(topRight, bottomLeft);
+
+        frameStats.trianglesDrawn += 2;
+
+        // Triangle 1: topLeft, topRight, bottomLeft
+        const StripCorner* upper[3] = {&topLeft, &topRight, &bottomLeft};
+        const RasterEdge* upperEdges[3] = {&diagonal, &leftEdge, &topEdge};
+        fillStripTriangle(upper, upperEdges, colors[i]);
+
+        // Triangle 2: topRight, bottomRight, bottomLeft
+        const StripCorner* lower[3] = {&topRight, &bottomRight, &bottomLeft};
+        const RasterEdge* lowerEdges[3] = {&bottomEdge, &diagonal, &rightEdge};
+        fillStripTriangle(lower, lowerEdges, colors[i]);
+
+        leftEdge = rightEdge;
+    }
+}
+
 void ScreenBuffer::drawHorizontalLine(int x1, int x2, int y, Color color) {
     int physWidth = PHYSICAL_WIDTH();
     int physHeight = PHYSICAL_HEIGHT();
@@ -232,17 +691,12 @@ void ScreenBuffer::drawHorizontalLine(int x1, int x2, int y, Color color) {
     size_t offset = physicalToOffset(x1, y);
     int length = x2 - x1 + 1;
 
-    // Draw the line
-    // Pack color into a 32-bit value for potential optimization
-    uint32_t rgba = (static_cast<uint32_t>(color.r)) |
-                    (static_cast<uint32_t>(color.g) << 8) |
-                    (static_cast<uint32_t>(color.b) << 16) |
-                    (static_cast<uint32_t>(color.a) << 24);
+    // Draw the line with the span fill of the CPU level picked at startup
+    uint32_t rgba = packColor(color);
 
     uint32_t* dest = reinterpret_cast<uint32_t*>(buffer + offset);
-    for (int i = 0; i < length; i++) {
-        dest[i] = rgba;
-    }
+    CpuDispatch::kernels->raster.fillPixels(dest, length, rgba);
+    frameStats.pixelsFilled += length;
 }
 
 Color ScreenBuffer::getPhysicalPixel(int px, int py) const {
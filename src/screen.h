@@ -3,6 +3,7 @@
 
 #include <cstdint>
 #include <cstring>
+#include <vector>
 #include "constants.h"
 #include "font.h"
 
@@ -41,6 +42,42 @@ struct Color {
     static constexpr Color magenta() { return Color(255, 0, 255); }
 };
 
+// =============================================================================
+// Rasterizer Selection
+// =============================================================================
+//
+// Triangles can be filled by two interchangeable backends that cover exactly
+// the same pixels:
+//
+// - Scanline: walks the left and right edges one row at a time, matching the
+//   original Lander algorithm
+// - EdgeBlocks: evaluates the same edges as integer half-space tests over
+//   8x8 pixel blocks. Fully covered blocks are filled with whole-row stores,
+//   partially covered blocks are masked, and small triangles just test every
+//   pixel in their bounding box
+//
+// =============================================================================
+
+enum class RasterBackend {
+    Scanline,
+    EdgeBlocks
+};
+
+namespace RasterConfig {
+    // Backend used by ScreenBuffer::drawTriangle (key 7)
+    extern RasterBackend backend;
+
+    // Batch unclipped terrain tiles into quad strips (off = one drawTile()
+    // per tile, the reference path used by the conformance tests)
+    extern bool terrainStrips;
+}
+
+// A projected corner of a terrain strip (physical coordinates)
+struct StripCorner {
+    int x;
+    int y;
+};
+
 class ScreenBuffer {
 public:
     // Logical dimensions (original game coordinates) - always fixed
@@ -66,6 +103,11 @@ public:
     // Clear the entire buffer to a color
     void clear(Color color = Color::black());
 
+    // Allocate and touch the drawing scratch space at its steady-state size,
+    // so the first frames don't fault it in page by page (the pixel buffer
+    // itself is written in full by the constructor)
+    void prefault();
+
     // Plot a pixel at logical coordinates (scaled to physical)
     // Coordinates are in original game space (0-319, 0-255)
     // Plots a single physical pixel at the scaled position
@@ -80,9 +122,32 @@ public:
     void drawHorizontalLine(int x1, int x2, int y, Color color);
 
     // Draw a filled triangle at physical coordinates
-    // Uses scanline rasterization matching the original Lander algorithm
+    // Uses the backend selected by RasterConfig::backend
     void drawTriangle(int x0, int y0, int x1, int y1, int x2, int y2, Color color);
 
+    // Draw a filled triangle using scanline rasterization
+    // (matches the original Lander algorithm)
+    void drawTriangleScanline(int x0, int y0, int x1, int y1, int x2, int y2, Color color);
+
+    // Draw a filled triangle using edge functions over 8x8 pixel blocks
+    // Covers exactly the same pixels as drawTriangleScanline()
+    void drawTriangleBlocks(int x0, int y0, int x1, int y1, int x2, int y2, Color color);
+
+    // Draw several triangles of one colour, given as x0, y0, x1, y1, x2, y2
+    // each, filling every pixel of their union once. The result is
+    // identical to calling drawTriangle() for each triangle
+    void drawTriangleUnion(const int* vertices, int triangleCount, Color color);
+
+    // Draw a row of quads that share edges (used for the landscape interior)
+    // top[] and bottom[] hold quadCount + 1 corners each, and quad i is filled
+    // with colors[i] as the two triangles (top[i], top[i+1], bottom[i]) and
+    // (top[i+1], bottom[i+1], bottom[i]), left to right. The result is
+    // identical to calling drawTriangle() for each triangle, but every edge
+    // slope is calculated once and shared by the triangles that use it.
+    // With the EdgeBlocks backend the triangles go through drawTriangle()
+    void drawQuadStrip(const StripCorner* top, const StripCorner* bottom,
+                       const Color* colors, int quadCount);
+
     // Get pixel at physical coordinates (for testing)
     Color getPhysicalPixel(int px, int py) const;
 
@@ -104,6 +169,11 @@ public:
     const uint8_t* getData() const { return buffer; }
     uint8_t* getData() { return buffer; }
 
+    // Render into external memory of getBufferSize() bytes with the same
+    // pitch (e.g. a shared-memory frame slot), or nullptr for the own buffer
+    // The contents are not carried over: clear() before drawing
+    void setTarget(uint8_t* pixels) { buffer = pixels ? pixels : ownBuffer; }
+
     // Buffer size in bytes (RGBA = 4 bytes per pixel) - always max size
     static constexpr size_t getBufferSize() {
         return MAX_PHYSICAL_WIDTH * MAX_PHYSICAL_HEIGHT * 4;
@@ -141,12 +211,58 @@ public:
     int drawInt(int x, int y, int value, Color color, int scale = 1);
 
 private:
+    // Size of the pixel blocks used by drawTriangleBlocks()
+    static constexpr int BLOCK_SIZE = 8;
+
+    // Triangles with a bounding box no larger than this skip block traversal
+    static constexpr int SMALL_TRIANGLE_AREA = 2 * BLOCK_SIZE * BLOCK_SIZE;
+
+    // Triangle edge, walked from its top vertex in 16.16 fixed point exactly
+    // as drawTriangleScanline() walks its edges
+    struct RasterEdge {
+        int64_t x;      // x of the top vertex << 16
+        int64_t slope;  // dx/dy in 16.16 (zero for horizontal edges)
+        int yTop;       // y of the top vertex
+
+        // Edge position on row y in 16.16 (the span end is x >> 16)
+        int64_t at(int y) const { return x + slope * (y - yTop); }
+    };
+
+    static RasterEdge makeEdge(const StripCorner& a, const StripCorner& b);
+
+    // Fill one strip triangle using precomputed edges
+    // edgeOpposite[i] is the edge that does not touch corner[i]
+    void fillStripTriangle(const StripCorner* corner[3],
+                           const RasterEdge* edgeOpposite[3], Color color);
+
+    // Fill rows yTop..yBottom between two edges (in either order)
+    // The block version walks 8x8 blocks, the small version tests each pixel
+    void fillTrapezoidBlocks(const RasterEdge& a, const RasterEdge& b,
+                             int yTop, int yBottom, uint32_t rgba);
+    void fillTrapezoidSmall(const RasterEdge& a, const RasterEdge& b,
+                            int yTop, int yBottom, uint32_t rgba);
+
     // Convert physical coordinates to buffer offset (uses max width for stride)
     static size_t physicalToOffset(int px, int py) {
         return (py * MAX_PHYSICAL_WIDTH + px) * 4;
     }
 
+    // Clipped span of one row, collected by drawTriangleUnion()
+    struct UnionSpan {
+        int x1, x2;
+        int y;
+    };
+
+    // drawTriangleUnion() scratch space, kept to avoid reallocating
+    static constexpr int UNION_SPAN_RESERVE = MAX_PHYSICAL_HEIGHT * 4;
+    std::vector<UnionSpan> unionSpans;
+    std::vector<UnionSpan> unionSorted;
+    std::vector<int> unionRowStart;
+
     // RGBA buffer (always allocated at max physical resolution)
+    uint8_t* ownBuffer;
+
+    // Buffer drawn into: ownBuffer, or the target set by setTarget()
     uint8_t* buffer;
 };
 
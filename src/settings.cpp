@@ -50,6 +50,47 @@ std::string getSettingsPath() {
     return "settings.cfg";
 }
 
+// =============================================================================
+// Thread policy keys (mainThreadCpus, audioThreadPolicy, ...)
+// =============================================================================
+
+static std::string getThreadKey(int role, const char* suffix) {
+    return std::string(getThreadRoleName(static_cast<ThreadRole>(role))) + "Thread" + suffix;
+}
+
+// Parse a thread policy setting, returns false if the key isn't one
+static bool parseThreadSetting(const std::string& key, const std::string& value,
+                               GameSettings& settings) {
+    for (int role = 0; role < THREAD_ROLE_COUNT; role++) {
+        ThreadPolicy& policy = settings.threadPolicies[role];
+        if (key == getThreadKey(role, "Cpus")) {
+            uint64_t mask;
+            if (parseCpuList(value.c_str(), mask)) {
+                policy.cpuMask = mask;
+            }
+        } else if (key == getThreadKey(role, "Policy")) {
+            SchedClass schedClass;
+            if (parseSchedClass(value.c_str(), schedClass)) {
+                policy.schedClass = schedClass;
+            }
+        } else if (key == getThreadKey(role, "Priority")) {
+            int v = std::atoi(value.c_str());
+            if (v >= ThreadConfig::MIN_PRIORITY && v <= ThreadConfig::MAX_PRIORITY) {
+                policy.priority = v;
+            }
+        } else if (key == getThreadKey(role, "Nice")) {
+            int v = std::atoi(value.c_str());
+            if (v >= ThreadConfig::MIN_NICE && v <= ThreadConfig::MAX_NICE) {
+                policy.nice = v;
+            }
+        } else {
+            continue;
+        }
+        return true;
+    }
+    return false;
+}
+
 // =============================================================================
 // Save settings
 // =============================================================================
@@ -72,6 +113,18 @@ bool saveSettings(const GameSettings& settings) {
     file << "landscapeScale=" << settings.landscapeScale << "\n";
     file << "starsEnabled=" << (settings.starsEnabled ? 1 : 0) << "\n";
     file << "highScore=" << settings.highScore << "\n";
+    file << "rasterBackend=" << settings.rasterBackend << "\n";
+    file << "presentMode=" << settings.presentMode << "\n";
+
+    for (int role = 0; role < THREAD_ROLE_COUNT; role++) {
+        const ThreadPolicy& policy = settings.threadPolicies[role];
+        char cpus[256];
+        formatCpuList(policy.cpuMask, cpus, sizeof(cpus));
+        file << getThreadKey(role, "Cpus") << "=" << cpus << "\n";
+        file << getThreadKey(role, "Policy") << "=" << getSchedClassName(policy.schedClass) << "\n";
+        file << getThreadKey(role, "Priority") << "=" << policy.priority << "\n";
+        file << getThreadKey(role, "Nice") << "=" << policy.nice << "\n";
+    }
 
     file.close();
     return true;
@@ -137,6 +190,18 @@ GameSettings loadSettings() {
             if (v >= 500) {  // High score must be at least 500 (initial value)
                 settings.highScore = v;
             }
+        } else if (key == "rasterBackend") {
+            int v = std::atoi(value.c_str());
+            if (v == 0 || v == 1) {
+                settings.rasterBackend = v;
+            }
+        } else if (key == "presentMode") {
+            int v = std::atoi(value.c_str());
+            if (v >= 0 && v <= 2) {
+                settings.presentMode = v;
+            }
+        } else {
+            parseThreadSetting(key, value, settings);
         }
     }
 
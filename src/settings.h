@@ -5,6 +5,7 @@
 #define SETTINGS_H
 
 #include <string>
+#include "thread_config.h"
 
 // Settings structure containing all persistent game options
 struct GameSettings {
@@ -16,6 +17,9 @@ struct GameSettings {
     int landscapeScale;  // Landscape scale (1, 2, 4, or 8)
     bool starsEnabled;   // Star particles at high altitude
     int highScore;       // Persistent high score
+    int rasterBackend;   // Triangle rasterizer (0 = scanline, 1 = edge blocks)
+    int presentMode;     // Presentation mode (0 = vsync, 1 = immediate, 2 = paced)
+    ThreadPolicy threadPolicies[THREAD_ROLE_COUNT];  // Affinity and scheduling per thread role
 
     // Default values
     GameSettings()
@@ -27,6 +31,8 @@ struct GameSettings {
         , landscapeScale(1)
         , starsEnabled(true)
         , highScore(500)     // Initial high score matches original Lander
+        , rasterBackend(0)
+        , presentMode(0)
     {}
 };
 
@@ -1,4 +1,7 @@
 #include "sound.h"
+#include "thread_config.h"
+#include "constants.h"
+#include "cpu_dispatch.h"
 #include <cstring>
 #include <cmath>
 #include <algorithm>
@@ -22,6 +25,12 @@ SoundSystem::~SoundSystem() {
 }
 
 bool SoundSystem::init() {
+    if (!openDevice()) return false;
+    loadSounds();
+    return true;
+}
+
+bool SoundSystem::openDevice() {
     if (initialized) return true;
 
     // Initialize SDL audio subsystem
@@ -47,6 +56,24 @@ bool SoundSystem::init() {
         return false;
     }
 
+    // Start audio playback (silence until sounds are loaded and played)
+    audioThreadConfigured = false;
+    SDL_PauseAudioDevice(audioDevice, 0);
+
+    initialized = true;
+    SDL_Log("Sound system initialized: %d Hz, %d channels, %d samples",
+            audioSpec.freq, audioSpec.channels, audioSpec.samples);
+
+    return true;
+}
+
+void SoundSystem::markReady(SoundId id) {
+    readyMask.fetch_or(1u << static_cast<int>(id), std::memory_order_release);
+}
+
+void SoundSystem::loadSounds() {
+    if (!initialized) return;
+
     // Determine base path for resources
     // On macOS app bundle: executable is in .app/Contents/MacOS/, resources in .app/Contents/Resources/
     // In development: sounds are in ./sounds/ relative to working directory
@@ -65,51 +92,60 @@ bool SoundSystem::init() {
     }
 #endif
 
-    // Load all sound effects
+    // Load all sound effects, each one playable as soon as it is loaded
+    static const struct { SoundId id; const char* file; } SOUND_FILES[] = {
+        {SoundId::BOOM, "sounds/boom.wav"},
+        {SoundId::DEAD, "sounds/dead.wav"},
+        {SoundId::SHOOT, "sounds/shoot.wav"},
+        {SoundId::SPLASH, "sounds/splash.wav"},
+        {SoundId::THRUST, "sounds/thrust.wav"},
+        {SoundId::WATER, "sounds/water.wav"},
+    };
+
     bool allLoaded = true;
-    allLoaded &= loadWav(basePath + "sounds/boom.wav", sounds[static_cast<int>(SoundId::BOOM)]);
-    allLoaded &= loadWav(basePath + "sounds/dead.wav", sounds[static_cast<int>(SoundId::DEAD)]);
-    allLoaded &= loadWav(basePath + "sounds/shoot.wav", sounds[static_cast<int>(SoundId::SHOOT)]);
-    allLoaded &= loadWav(basePath + "sounds/splash.wav", sounds[static_cast<int>(SoundId::SPLASH)]);
-    allLoaded &= loadWav(basePath + "sounds/thrust.wav", sounds[static_cast<int>(SoundId::THRUST)]);
-    allLoaded &= loadWav(basePath + "sounds/water.wav", sounds[static_cast<int>(SoundId::WATER)]);
+    for (const auto& entry : SOUND_FILES) {
+        if (loadWav(basePath + entry.file, sounds[static_cast<int>(entry.id)])) {
+            markReady(entry.id);
+        } else {
+            allLoaded = false;
+        }
+    }
 
     // Create pitched variants
     if (sounds[static_cast<int>(SoundId::SHOOT)].loaded) {
         // Pitched down shoot for bullet ground impact (lower pitch = 0.4)
         createPitchedVersion(sounds[static_cast<int>(SoundId::SHOOT)],
                             sounds[static_cast<int>(SoundId::SHOOT_IMPACT)], 0.4f);
+        markReady(SoundId::SHOOT_IMPACT);
     }
 
     if (sounds[static_cast<int>(SoundId::THRUST)].loaded) {
         // Pitched down thrust for hover
         createPitchedVersion(sounds[static_cast<int>(SoundId::THRUST)],
                             sounds[static_cast<int>(SoundId::HOVER)], 0.7f);
+        markReady(SoundId::HOVER);
     }
 
     if (!allLoaded) {
         SDL_LogWarn(SDL_LOG_CATEGORY_AUDIO, "Some sound files failed to load");
     }
 
-    // Start audio playback
-    SDL_PauseAudioDevice(audioDevice, 0);
-
-    initialized = true;
-    SDL_Log("Sound system initialized: %d Hz, %d channels, %d samples",
-            audioSpec.freq, audioSpec.channels, audioSpec.samples);
-
-    return true;
+    loadFinished.store(true, std::memory_order_release);
 }
 
 void SoundSystem::shutdown() {
     if (!initialized) return;
 
+    stopMusic();
+
     if (audioDevice != 0) {
         SDL_CloseAudioDevice(audioDevice);
         audioDevice = 0;
     }
 
     // Free sound data
+    readyMask.store(0, std::memory_order_release);
+    loadFinished.store(false, std::memory_order_release);
     for (int i = 0; i < static_cast<int>(SoundId::COUNT); i++) {
         sounds[i].samples.clear();
         sounds[i].loaded = false;
@@ -194,16 +230,7 @@ void SoundSystem::createPitchedVersion(const SoundData& source, SoundData& dest,
     dest.loaded = true;
 }
 
-int SoundSystem::play(SoundId id, float volume) {
-    if (!enabled || !initialized) return -1;
-
-    int idx = static_cast<int>(id);
-    if (idx < 0 || idx >= static_cast<int>(SoundId::COUNT)) return -1;
-    if (!sounds[idx].loaded) return -1;
-
-    // Find a free channel
-    SDL_LockAudioDevice(audioDevice);
-
+int SoundSystem::startChannel(int idx, SoundId id, float volume, bool looping) {
     int channel = -1;
     for (int i = 0; i < MAX_CHANNELS; i++) {
         if (channels[i].data == nullptr) {
@@ -218,12 +245,26 @@ int SoundSystem::play(SoundId id, float volume) {
         channels[channel].position = 0.0f;
         channels[channel].volume = volume;
         channels[channel].pitch = 1.0f;
-        channels[channel].looping = false;
+        channels[channel].looping = looping;
         channels[channel].soundId = id;
         channels[channel].filterCutoff = 1.0f;  // No filter by default
         channels[channel].filterState = 0.0f;   // Reset filter state
+        channels[channel].startSample = eventSample;
     }
 
+    return channel;
+}
+
+int SoundSystem::play(SoundId id, float volume) {
+    if (!enabled || !initialized) return -1;
+
+    int idx = static_cast<int>(id);
+    if (idx < 0 || idx >= static_cast<int>(SoundId::COUNT)) return -1;
+    if (!isReady(idx)) return -1;
+
+    // Find a free channel
+    SDL_LockAudioDevice(audioDevice);
+    int channel = startChannel(idx, id, volume, false);
     SDL_UnlockAudioDevice(audioDevice);
     return channel;
 }
@@ -236,33 +277,58 @@ int SoundSystem::playLoop(SoundId id, float volume) {
 
     int idx = static_cast<int>(id);
     if (idx < 0 || idx >= static_cast<int>(SoundId::COUNT)) return -1;
-    if (!sounds[idx].loaded) return -1;
+    if (!isReady(idx)) return -1;
 
     // Find a free channel
     SDL_LockAudioDevice(audioDevice);
+    int channel = startChannel(idx, id, volume, true);
+    SDL_UnlockAudioDevice(audioDevice);
+    return channel;
+}
 
-    int channel = -1;
-    for (int i = 0; i < MAX_CHANNELS; i++) {
-        if (channels[i].data == nullptr) {
-            channel = i;
-            break;
-        }
-    }
+bool SoundSystem::playMusic(const std::string& path, float volume, bool loop) {
+    if (!initialized) return false;
 
-    if (channel >= 0) {
-        channels[channel].data = sounds[idx].samples.data();
-        channels[channel].length = static_cast<uint32_t>(sounds[idx].samples.size());
-        channels[channel].position = 0.0f;
-        channels[channel].volume = volume;
-        channels[channel].pitch = 1.0f;
-        channels[channel].looping = true;
-        channels[channel].soundId = id;
-        channels[channel].filterCutoff = 1.0f;  // No filter by default
-        channels[channel].filterState = 0.0f;   // Reset filter state
+    // Open the new track (its decoder starts filling the ring) before
+    // swapping it in, so the audio thread only waits for the pointer swap
+    std::unique_ptr<MusicStream> track = std::make_unique<MusicStream>();
+    if (!track->open(path.c_str(), audioSpec.freq, loop)) {
+        SDL_LogError(SDL_LOG_CATEGORY_AUDIO, "Failed to open music %s", path.c_str());
+        return false;
     }
+    SDL_Log("Streaming music %s: %d Hz, %d channels", path.c_str(),
+            track->getSourceRate(), track->getSourceChannels());
 
+    SDL_LockAudioDevice(audioDevice);
+    music.swap(track);
+    musicVolume = volume;
     SDL_UnlockAudioDevice(audioDevice);
-    return channel;
+
+    // The previous track (if any) stops its decoder outside the lock
+    return true;
+}
+
+void SoundSystem::stopMusic() {
+    std::unique_ptr<MusicStream> track;
+
+    SDL_LockAudioDevice(audioDevice);
+    music.swap(track);
+    SDL_UnlockAudioDevice(audioDevice);
+}
+
+void SoundSystem::beginTicks() {
+    // The next buffer the audio thread mixes starts at samplesMixed
+    frameStartSample = samplesMixed.load(std::memory_order_acquire);
+    eventSample = frameStartSample;
+}
+
+void SoundSystem::setTick(int tick) {
+    uint64_t samplesPerTick = static_cast<uint64_t>(audioSpec.freq) / PHYSICS_RATE;
+    eventSample = frameStartSample + static_cast<uint64_t>(tick) * samplesPerTick;
+}
+
+void SoundSystem::endTicks() {
+    eventSample = 0;
 }
 
 void SoundSystem::stopChannel(int channel) {
@@ -294,6 +360,16 @@ bool SoundSystem::isPlaying(SoundId id) const {
     return false;
 }
 
+int SoundSystem::getActiveVoiceCount() const {
+    int count = 0;
+    for (int i = 0; i < MAX_CHANNELS; i++) {
+        if (channels[i].data != nullptr) {
+            count++;
+        }
+    }
+    return count;
+}
+
 void SoundSystem::setLoopVolume(SoundId id, float volume) {
     SDL_LockAudioDevice(audioDevice);
 
@@ -334,10 +410,36 @@ void SoundSystem::setLoopPitch(SoundId id, float pitch) {
 
 void SoundSystem::audioCallback(void* userdata, Uint8* stream, int len) {
     SoundSystem* self = static_cast<SoundSystem*>(userdata);
+
+    // SDL creates the audio thread, so it applies its policy on the first callback
+    if (!self->audioThreadConfigured) {
+        self->audioThreadConfigured = true;
+        char error[256];
+        if (!applyThreadPolicy(ThreadRole::Audio, error, sizeof(error))) {
+            SDL_LogWarn(SDL_LOG_CATEGORY_AUDIO, "Audio thread policy not fully applied (%s)", error);
+        }
+    }
+
     self->mixAudio(reinterpret_cast<int16_t*>(stream), len / sizeof(int16_t));
 }
 
 void SoundSystem::mixAudio(int16_t* stream, int samples) {
+    // A callback arriving more than 1.5 buffers after the previous one means
+    // the device most likely played silence in between
+    Uint64 now = SDL_GetPerformanceCounter();
+    if (lastCallbackTime != 0 && audioSpec.freq > 0) {
+        Uint64 bufferTicks = SDL_GetPerformanceFrequency() * static_cast<Uint64>(samples) /
+                             static_cast<Uint64>(audioSpec.freq);
+        if (now - lastCallbackTime > bufferTicks + bufferTicks / 2) {
+            lateCallbacks.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    lastCallbackTime = now;
+
+    // This buffer covers output samples bufferStart .. bufferStart + samples
+    uint64_t bufferStart = samplesMixed.load(std::memory_order_relaxed);
+    samplesMixed.store(bufferStart + static_cast<uint64_t>(samples), std::memory_order_release);
+
     // Clear the buffer
     std::memset(stream, 0, samples * sizeof(int16_t));
 
@@ -356,7 +458,16 @@ void SoundSystem::mixAudio(int16_t* stream, int samples) {
         // Using exponential mapping for more natural feel
         float alpha = 0.01f + 0.99f * channel.filterCutoff * channel.filterCutoff;
 
-        for (int i = 0; i < samples; i++) {
+        // Sounds timestamped with a later tick start part way through the
+        // buffer, or in a later buffer (late ones start straight away)
+        int first = 0;
+        if (channel.startSample > bufferStart) {
+            uint64_t delay = channel.startSample - bufferStart;
+            if (delay >= static_cast<uint64_t>(samples)) continue;
+            first = static_cast<int>(delay);
+        }
+
+        for (int i = first; i < samples; i++) {
             if (channel.position >= channel.length) {
                 if (channel.looping) {
                     channel.position = 0.0f;
@@ -392,4 +503,16 @@ void SoundSystem::mixAudio(int16_t* stream, int samples) {
             channel.position += channel.pitch;
         }
     }
+
+    // Mix the music voice (silence where the decoder hasn't caught up)
+    if (music) {
+        float vol = musicVolume * masterVolume;
+        int16_t block[MUSIC_BLOCK];
+        for (int offset = 0; offset < samples; offset += MUSIC_BLOCK) {
+            int count = std::min(MUSIC_BLOCK, samples - offset);
+            int got = music->read(block, count);
+            CpuDispatch::kernels->audio.mixScaled(stream + offset, block, got, vol);
+            if (got < count) break;
+        }
+    }
 }
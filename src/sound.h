@@ -2,8 +2,11 @@
 #define LANDER_SOUND_H
 
 #include <SDL2/SDL.h>
+#include <atomic>
+#include <memory>
 #include <string>
 #include <vector>
+#include "music_stream.h"
 
 // =============================================================================
 // Sound System
@@ -13,6 +16,17 @@
 // - Pitch shifting (for variants like hover thrust, bullet impact)
 // - Looping (for continuous sounds like engine thrust)
 // - Volume control (for spatial audio based on distance)
+// - Sample-accurate start times for sounds made during physics ticks
+// - A music voice streamed from disk (MusicStream), for long tracks
+//
+// A frame runs several physics ticks back to back (8 at 15fps), but each
+// tick stands for 1/PHYSICS_RATE of a second. Between beginTicks() and
+// endTicks(), sounds start at the sample matching the tick that played
+// them: tick 0 at the start of the next audio buffer, tick n that many tick
+// lengths later, so bursts of shots keep their spacing instead of all
+// starting on the same sample. Start times are stored in the channel under
+// the audio device lock that play() already takes, measured against a
+// sample counter the audio thread publishes atomically.
 //
 // =============================================================================
 
@@ -42,6 +56,8 @@ struct AudioChannel {
     // Low-pass filter state (single-pole IIR)
     float filterCutoff = 1.0f;      // 0.0 = fully filtered, 1.0 = no filter
     float filterState = 0.0f;       // Previous output sample for IIR filter
+
+    uint64_t startSample = 0;       // Output sample to start on (silent until then)
 };
 
 // Loaded sound effect data
@@ -59,6 +75,16 @@ public:
     // Initialize SDL audio and load all sounds
     bool init();
 
+    // Startup in two steps, so sounds can load while the game starts:
+    // openDevice() initializes SDL audio and starts playback (main thread),
+    // loadSounds() loads the WAV files and can run on a worker thread.
+    // Each sound becomes playable as soon as it has loaded.
+    bool openDevice();
+    void loadSounds();
+
+    // True once loadSounds() has finished
+    bool isLoaded() const { return loadFinished.load(std::memory_order_acquire); }
+
     // Shutdown and free resources
     void shutdown();
 
@@ -70,6 +96,11 @@ public:
     // Play a looping sound (returns channel for later stop)
     int playLoop(SoundId id, float volume = 1.0f);
 
+    // Timestamp the sounds of a frame's physics ticks (see above)
+    void beginTicks();
+    void setTick(int tick);
+    void endTicks();
+
     // Stop a specific channel
     void stopChannel(int channel);
 
@@ -90,6 +121,13 @@ public:
     // pitch: 1.0 = normal, <1.0 = lower, >1.0 = higher
     void setLoopPitch(SoundId id, float pitch);
 
+    // Stream a WAV track from disk as background music, replacing any track
+    // already playing. Returns false if the file can't be opened
+    bool playMusic(const std::string& path, float volume, bool loop = true);
+    void stopMusic();
+    void setMusicVolume(float volume) { musicVolume = volume; }
+    bool isMusicPlaying() const { return music != nullptr && !music->isFinished(); }
+
     // Master volume control
     void setMasterVolume(float volume) { masterVolume = volume; }
     float getMasterVolume() const { return masterVolume; }
@@ -98,6 +136,11 @@ public:
     void setEnabled(bool enabled) { this->enabled = enabled; }
     bool isEnabled() const { return enabled; }
 
+    // Telemetry: channels currently playing, and audio callbacks that arrived
+    // late enough that the device probably ran out of samples (underruns)
+    int getActiveVoiceCount() const;
+    uint32_t getLateCallbackCount() const { return lateCallbacks.load(std::memory_order_relaxed); }
+
 private:
     // Load a WAV file into a SoundData structure
     bool loadWav(const std::string& path, SoundData& sound);
@@ -105,6 +148,12 @@ private:
     // Create a pitched version of a sound
     void createPitchedVersion(const SoundData& source, SoundData& dest, float pitchFactor);
 
+    // Loaded sounds, one bit per SoundId (set once a sound's samples are complete)
+    void markReady(SoundId id);
+    bool isReady(int index) const {
+        return (readyMask.load(std::memory_order_acquire) & (1u << index)) != 0;
+    }
+
     // SDL audio callback (static, calls instance method)
     static void audioCallback(void* userdata, Uint8* stream, int len);
     void mixAudio(int16_t* stream, int samples);
@@ -124,6 +173,32 @@ private:
     float masterVolume = 1.0f;
     bool enabled = true;
     bool initialized = false;
+
+    // Published by loadSounds() (may run on another thread)
+    std::atomic<uint32_t> readyMask{0};
+    std::atomic<bool> loadFinished{false};
+
+    // Music voice, swapped under the audio device lock
+    std::unique_ptr<MusicStream> music;
+    float musicVolume = 1.0f;
+    static constexpr int MUSIC_BLOCK = 256;   // Samples taken from the stream at a time
+
+    // Start a free channel playing sound idx (audio device must be locked)
+    int startChannel(int idx, SoundId id, float volume, bool looping);
+
+    // Output samples mixed so far (written by the audio thread)
+    std::atomic<uint64_t> samplesMixed{0};
+
+    // Start sample for sounds played now (game thread), 0 = immediately
+    uint64_t frameStartSample = 0;
+    uint64_t eventSample = 0;
+
+    // Callback timing (audio thread) for underrun detection
+    Uint64 lastCallbackTime = 0;
+    std::atomic<uint32_t> lateCallbacks{0};
+
+    // Set once the audio thread has applied its ThreadConfig policy
+    bool audioThreadConfigured = false;
 };
 
 #endif // LANDER_SOUND_H
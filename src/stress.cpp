@@ -0,0 +1,338 @@
+// stress.cpp
+// Scripted worst-case scenarios for benchmarking
+
+#include "stress.h"
+#include "landscape.h"
+#include "particles.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+const char* SCENARIO_NAMES[STRESS_SCENARIO_COUNT] = {
+    "rocks",
+    "explosions",
+    "splashes",
+    "stars",
+    "forest",
+};
+
+constexpr int WORLD_TILES = 256;            // The object map and landscape repeat every 256 tiles
+constexpr int CAMERA_TO_SHIP_TILES = 5;     // CameraConstants::CAMERA_PLAYER_Z in tiles
+constexpr int32_t HOVER_HEIGHT = 3 << 24;   // Ship height above the terrain
+constexpr int32_t ROCK_HEIGHT = 20 << 24;   // Rock spawn height above the ship
+constexpr int ROCKS_PER_FRAME = 4;
+constexpr int EXPLOSION_INTERVAL = 8;       // Frames between explosions
+constexpr int EXPLOSION_CLUSTERS = 50;      // As big as the ship's own
+constexpr int SEA_AREA = 7;                 // Splashes: sea tiles around the ship
+constexpr int32_t DRIFT_STEP = 1 << 18;     // 1/64 tile per frame
+constexpr int DRIFT_PERIOD = 512;           // Frames to drift out and back
+
+bool isIntact(uint8_t objectType)
+{
+    return objectType != ObjectType::NONE && !ObjectMap::isDestroyedType(objectType);
+}
+
+// Position of the width x depth window (tiles from x0, z0, wrapping) with
+// the most cells set, the first found in z-major order on ties
+StressView findBestWindow(const uint8_t* cells, int width, int depth)
+{
+    // Summed-area table over two copies of the world in each direction, so
+    // windows that wrap need no special case
+    constexpr int SIZE = WORLD_TILES * 2 + 1;
+    std::vector<int> sums(SIZE * SIZE, 0);
+    for (int z = 1; z < SIZE; z++) {
+        int rowSum = 0;
+        for (int x = 1; x < SIZE; x++) {
+            rowSum += cells[((z - 1) % WORLD_TILES) * WORLD_TILES + (x - 1) % WORLD_TILES];
+            sums[z * SIZE + x] = sums[(z - 1) * SIZE + x] + rowSum;
+        }
+    }
+
+    StressView best = {0, 0, -1};
+    for (int z0 = 0; z0 < WORLD_TILES; z0++) {
+        for (int x0 = 0; x0 < WORLD_TILES; x0++) {
+            int x1 = x0 + width;
+            int z1 = z0 + depth;
+            int count = sums[z1 * SIZE + x1] - sums[z0 * SIZE + x1]
+                      - sums[z1 * SIZE + x0] + sums[z0 * SIZE + x0];
+            if (count > best.objects) {
+                best = {x0, z0, count};
+            }
+        }
+    }
+    return best;
+}
+
+int wrapTile(int tile)
+{
+    return tile & (WORLD_TILES - 1);
+}
+
+// Ship position above a tile's centre, height tiles (raw) above the terrain
+Vec3 aboveTile(int tileX, int tileZ, int32_t height)
+{
+    Vec3 position;
+    position.x = Fixed::fromRaw((tileX << 24) + (GameConstants::TILE_SIZE.raw >> 1));
+    position.z = Fixed::fromRaw((tileZ << 24) + (GameConstants::TILE_SIZE.raw >> 1));
+    position.y = Fixed::fromRaw(getLandscapeAltitude(position.x, position.z).raw - height);
+    return position;
+}
+
+// Triangle wave from 0 out to DRIFT_PERIOD / 2 steps and back
+int32_t drift(int frame)
+{
+    int phase = frame % DRIFT_PERIOD;
+    int steps = phase < DRIFT_PERIOD / 2 ? phase : DRIFT_PERIOD - phase;
+    return steps * DRIFT_STEP;
+}
+
+} // namespace
+
+// =============================================================================
+// Scenario Names
+// =============================================================================
+
+const char* getStressScenarioName(StressScenario scenario)
+{
+    int index = static_cast<int>(scenario);
+    return (index >= 0 && index < STRESS_SCENARIO_COUNT) ? SCENARIO_NAMES[index] : "?";
+}
+
+bool findStressScenario(const char* name, StressScenario& scenario)
+{
+    for (int i = 0; i < STRESS_SCENARIO_COUNT; i++) {
+        if (std::strcmp(name, SCENARIO_NAMES[i]) == 0) {
+            scenario = static_cast<StressScenario>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+// =============================================================================
+// View Search
+// =============================================================================
+
+StressView findDensestView(const ObjectMap& objects, int tilesX, int tilesZ)
+{
+    std::vector<uint8_t> cells(WORLD_TILES * WORLD_TILES);
+    for (int z = 0; z < WORLD_TILES; z++) {
+        for (int x = 0; x < WORLD_TILES; x++) {
+            cells[z * WORLD_TILES + x] = isIntact(objects.getObjectAt(x, z)) ? 1 : 0;
+        }
+    }
+
+    // The renderer draws objects in columns 1 to tilesX - 1, from the camera
+    // tile minus tilesX / 2, and rows camTileZ to camTileZ + tilesZ - 1
+    StressView window = findBestWindow(cells.data(), tilesX - 1, tilesZ);
+    StressView view;
+    view.cameraTileX = wrapTile(window.cameraTileX + tilesX / 2 - 1);
+    view.cameraTileZ = window.cameraTileZ;
+    view.objects = window.objects;
+    return view;
+}
+
+// =============================================================================
+// StressScript Implementation
+// =============================================================================
+
+int StressScript::getLandscapeScale(int current) const
+{
+    return scenario == StressScenario::Forest ? GameConstants::MAX_SCALE : current;
+}
+
+bool StressScript::getStars(bool current) const
+{
+    return scenario == StressScenario::Stars ? true : current;
+}
+
+uint32_t StressScript::random()
+{
+    // xorshift32: the game's own generators are left alone
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return randomState;
+}
+
+void StressScript::start(const ObjectMap& objects)
+{
+    StressView view = findDensestView(objects, TILES_X, TILES_Z);
+    int shipTileX = view.cameraTileX;
+    int shipTileZ = wrapTile(view.cameraTileZ + CAMERA_TO_SHIP_TILES);
+
+    if (scenario == StressScenario::Splashes) {
+        // Over the middle of the first stretch of sea big enough to keep
+        // the exhaust off land
+        std::vector<uint8_t> sea(WORLD_TILES * WORLD_TILES);
+        for (int z = 0; z < WORLD_TILES; z++) {
+            for (int x = 0; x < WORLD_TILES; x++) {
+                Fixed altitude = getLandscapeAltitudeAtTile(x, z);
+                sea[z * WORLD_TILES + x] = (altitude.raw == GameConstants::SEA_LEVEL.raw) ? 1 : 0;
+            }
+        }
+        StressView area = findBestWindow(sea.data(), SEA_AREA, SEA_AREA);
+        shipTileX = wrapTile(area.cameraTileX + SEA_AREA / 2);
+        shipTileZ = wrapTile(area.cameraTileZ + SEA_AREA / 2);
+    }
+
+    origin = aboveTile(shipTileX, shipTileZ, HOVER_HEIGHT);
+    if (scenario == StressScenario::Stars) {
+        origin.y = Fixed::fromRaw(-StarConfig::MAX_ALTITUDE);
+    }
+
+    // Explosions go off nearest the ship first
+    targets.clear();
+    if (scenario == StressScenario::Explosions) {
+        int halfTilesX = TILES_X / 2;
+        for (int row = 0; row < TILES_Z; row++) {
+            for (int col = 1; col < TILES_X; col++) {
+                int x = wrapTile(view.cameraTileX - halfTilesX + col);
+                int z = wrapTile(view.cameraTileZ + row);
+                if (objects.hasObject(x, z)) {
+                    targets.push_back(static_cast<uint16_t>((z << 8) | x));
+                }
+            }
+        }
+        auto distance = [=](uint16_t tile) {
+            int dx = (tile & 0xFF) - shipTileX;
+            int dz = (tile >> 8) - shipTileZ;
+            dx = std::min(wrapTile(dx), WORLD_TILES - wrapTile(dx));
+            dz = std::min(wrapTile(dz), WORLD_TILES - wrapTile(dz));
+            return dx * dx + dz * dz;
+        };
+        std::stable_sort(targets.begin(), targets.end(), [&](uint16_t a, uint16_t b) {
+            return distance(a) < distance(b);
+        });
+    }
+}
+
+StressFrame StressScript::step(int frame, ObjectMap& objects)
+{
+    StressFrame result;
+    result.shipPosition = origin;
+
+    switch (scenario) {
+        case StressScenario::Rocks: {
+            // Anywhere over the visible landscape
+            int halfTilesX = TILES_X / 2;
+            int32_t top = origin.y.raw - ROCK_HEIGHT;
+            for (int i = 0; i < ROCKS_PER_FRAME; i++) {
+                int32_t x = static_cast<int32_t>(random() % (TILES_X - 1)) - halfTilesX + 1;
+                int32_t z = static_cast<int32_t>(random() % TILES_Z) - CAMERA_TO_SHIP_TILES;
+                Vec3 rock;
+                rock.x = Fixed::fromRaw(origin.x.raw + x * GameConstants::TILE_SIZE.raw);
+                rock.y = Fixed::fromRaw(top);
+                rock.z = Fixed::fromRaw(origin.z.raw + z * GameConstants::TILE_SIZE.raw);
+                spawnRock(rock);
+            }
+            break;
+        }
+
+        case StressScenario::Explosions: {
+            if (targets.empty() || frame % EXPLOSION_INTERVAL != 0) {
+                break;
+            }
+            // Once everything in view has gone, put it all back and go again
+            size_t index = static_cast<size_t>(frame / EXPLOSION_INTERVAL) % targets.size();
+            if (index == 0 && frame > 0) {
+                objects.restoreDestroyedObjects();
+            }
+            int x = targets[index] & 0xFF;
+            int z = targets[index] >> 8;
+            uint8_t objectType = objects.getObjectAt(x, z);
+            if (isIntact(objectType)) {
+                objects.setObjectAt(x, z, ObjectMap::getDestroyedType(objectType));
+            }
+
+            // Where a bullet hit would put it
+            Vec3 position;
+            position.x = Fixed::fromRaw(x << 24);
+            position.z = Fixed::fromRaw(z << 24);
+            Fixed ground = getLandscapeAltitude(position.x, position.z);
+            position.y = Fixed::fromRaw(ground.raw - (GameConstants::TILE_SIZE.raw >> 1));
+            spawnExplosionParticles(position, EXPLOSION_CLUSTERS);
+            break;
+        }
+
+        case StressScenario::Splashes:
+            result.buttons = 1;   // Left button: full thrust
+            break;
+
+        case StressScenario::Stars:
+            result.shipPosition.z = Fixed::fromRaw(origin.z.raw + drift(frame));
+            break;
+
+        case StressScenario::Forest: {
+            result.shipPosition.z = Fixed::fromRaw(origin.z.raw + drift(frame));
+            Fixed ground = getLandscapeAltitude(result.shipPosition.x, result.shipPosition.z);
+            result.shipPosition.y = Fixed::fromRaw(ground.raw - HOVER_HEIGHT);
+            break;
+        }
+
+        case StressScenario::Count:
+            break;
+    }
+
+    return result;
+}
+
+// =============================================================================
+// StressReport Implementation
+// =============================================================================
+
+void StressReport::addFrame(uint32_t frameMicros, const FrameStats& stats)
+{
+    frameTimes.push_back(frameMicros);
+
+    int particles = stats.getParticleTotal();
+    totalParticles += particles;
+    totalObjects += stats.objectsDrawn;
+    totalShadows += stats.shadowsDrawn;
+    totalTriangles += stats.trianglesDrawn;
+    totalPixels += stats.pixelsFilled;
+    totalRejected += stats.particlesRejected;
+    totalDropped += stats.trianglesDropped;
+    peakParticles = std::max(peakParticles, particles);
+    peakObjects = std::max(peakObjects, stats.objectsDrawn);
+    peakShadows = std::max(peakShadows, stats.shadowsDrawn);
+    peakTriangles = std::max(peakTriangles, stats.trianglesDrawn);
+    peakPixels = std::max(peakPixels, stats.pixelsFilled);
+}
+
+uint32_t StressReport::getPercentile(int percent) const
+{
+    if (frameTimes.empty()) {
+        return 0;
+    }
+    std::vector<uint32_t> sorted = frameTimes;
+    std::sort(sorted.begin(), sorted.end());
+
+    // Nearest rank: the smallest time at least percent% of frames are within
+    size_t rank = (static_cast<size_t>(percent) * sorted.size() + 99) / 100;
+    rank = std::max<size_t>(rank, 1);
+    return sorted[std::min(rank, sorted.size()) - 1];
+}
+
+void StressReport::print(FILE* file, const char* scenario, int width, int height, int tilesX, int tilesZ) const
+{
+    size_t frames = std::max<size_t>(frameTimes.size(), 1);
+    std::fprintf(file, "Stress %s: %zu frames, %dx%d, %dx%d tiles\n",
+                 scenario, frameTimes.size(), width, height, tilesX, tilesZ);
+    std::fprintf(file, "  frame ms   p50 %.2f  p90 %.2f  p99 %.2f  max %.2f\n",
+                 getPercentile(50) / 1000.0, getPercentile(90) / 1000.0,
+                 getPercentile(99) / 1000.0, getPercentile(100) / 1000.0);
+    std::fprintf(file, "  particles  mean %llu  peak %d  rejected %llu\n",
+                 static_cast<unsigned long long>(totalParticles / frames), peakParticles,
+                 static_cast<unsigned long long>(totalRejected));
+    std::fprintf(file, "  objects    mean %llu  peak %d  (shadows mean %llu  peak %d)\n",
+                 static_cast<unsigned long long>(totalObjects / frames), peakObjects,
+                 static_cast<unsigned long long>(totalShadows / frames), peakShadows);
+    std::fprintf(file, "  triangles  mean %llu  peak %d  dropped %llu\n",
+                 static_cast<unsigned long long>(totalTriangles / frames), peakTriangles,
+                 static_cast<unsigned long long>(totalDropped));
+    std::fprintf(file, "  pixels     mean %llu  peak %llu\n",
+                 static_cast<unsigned long long>(totalPixels / frames),
+                 static_cast<unsigned long long>(peakPixels));
+}
@@ -0,0 +1,134 @@
+// stress.h
+// Scripted worst-case scenarios for benchmarking
+
+#ifndef LANDER_STRESS_H
+#define LANDER_STRESS_H
+
+#include "math3d.h"
+#include "object_map.h"
+#include "frame_stats.h"
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+// =============================================================================
+// Stress Scenarios
+// =============================================================================
+//
+// Hardware has to be sized for the worst frames, not the average ones. A
+// stress run (--stress <scenario>) plays one of these scenarios headless,
+// with no frame limiter, and prints frame time percentiles with particle,
+// object and triangle counts:
+//
+//   rocks       A storm of falling rocks, spawned over the visible landscape
+//               until the particle buffer is full
+//   explosions  Every object in view blown up in turn, nearest first, each
+//               with a large explosion, leaving smoking remains
+//   splashes    Full thrust low over the sea, for exhaust splash cascades
+//   stars       Drifting at StarConfig::MAX_ALTITUDE, where the star count
+//               is highest
+//   forest      Landscape scale 8, drifting low over the part of the world
+//               with the most objects in view
+//
+// The script only decides where the ship is, which buttons are held and
+// what is spawned or destroyed each frame; the game itself runs as usual (in
+// debug mode, so the ship can't crash out of the scenario). Everything is
+// derived from the frame number and the object map, so a scenario plays the
+// same way every time at a given landscape scale.
+//
+// =============================================================================
+
+enum class StressScenario {
+    Rocks,
+    Explosions,
+    Splashes,
+    Stars,
+    Forest,
+    Count
+};
+
+constexpr int STRESS_SCENARIO_COUNT = static_cast<int>(StressScenario::Count);
+
+// Name used on the command line
+const char* getStressScenarioName(StressScenario scenario);
+
+// Find a scenario by name, returns false if there is none
+bool findStressScenario(const char* name, StressScenario& scenario);
+
+// Camera tile of the view with the most (intact) objects, for a view of
+// tilesX x tilesZ tiles as the landscape renderer draws it
+struct StressView {
+    int cameraTileX;
+    int cameraTileZ;
+    int objects;
+};
+StressView findDensestView(const ObjectMap& objects, int tilesX, int tilesZ);
+
+// What the script does in one frame
+struct StressFrame {
+    Vec3 shipPosition;
+    uint32_t buttons = 0;   // Mouse buttons held (SDL mask, 1 = thrust)
+};
+
+class StressScript {
+public:
+    explicit StressScript(StressScenario scenario) : scenario(scenario) {}
+
+    StressScenario getScenario() const { return scenario; }
+
+    // Landscape scale and stars setting the scenario runs with, given the
+    // current ones
+    int getLandscapeScale(int current) const;
+    bool getStars(bool current) const;
+
+    // Pick where to fly (once the objects are placed and the landscape scale
+    // is set)
+    void start(const ObjectMap& objects);
+
+    // Spawn and destroy for a frame, and return the ship's state for it
+    StressFrame step(int frame, ObjectMap& objects);
+
+private:
+    StressScenario scenario;
+    Vec3 origin;                    // Ship position at frame 0
+    std::vector<uint16_t> targets;  // Explosions: tiles (z << 8 | x), nearest first
+    uint32_t randomState = 0x2545F491;
+
+    uint32_t random();
+};
+
+// Frame times and scene counters of a stress run
+class StressReport {
+public:
+    // Record one frame: its time in microseconds (without the frame
+    // limiter) and its scene counters
+    void addFrame(uint32_t frameMicros, const FrameStats& stats);
+
+    int getFrameCount() const { return static_cast<int>(frameTimes.size()); }
+
+    // Nearest-rank percentile of the frame times, in microseconds
+    uint32_t getPercentile(int percent) const;
+
+    int getPeakParticles() const { return peakParticles; }
+    int getPeakTriangles() const { return peakTriangles; }
+
+    // Print the summary, headed by the scenario name and display setup
+    void print(FILE* file, const char* scenario, int width, int height, int tilesX, int tilesZ) const;
+
+private:
+    std::vector<uint32_t> frameTimes;
+    uint64_t totalParticles = 0;
+    uint64_t totalObjects = 0;
+    uint64_t totalShadows = 0;
+    uint64_t totalTriangles = 0;
+    uint64_t totalPixels = 0;
+    uint64_t totalRejected = 0;
+    uint64_t totalDropped = 0;
+    int peakParticles = 0;
+    int peakObjects = 0;
+    int peakShadows = 0;
+    int peakTriangles = 0;
+    uint64_t peakPixels = 0;
+};
+
+#endif // LANDER_STRESS_H
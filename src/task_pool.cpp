@@ -0,0 +1,65 @@
+// task_pool.cpp
+// Small fixed-size thread pool for background work
+
+#include "task_pool.h"
+
+// =============================================================================
+// TaskPool Implementation
+// =============================================================================
+
+TaskPool::TaskPool(int threadCount, std::function<void()> threadStart)
+    : threadStart(std::move(threadStart))
+{
+    if (threadCount < 1) threadCount = 1;
+    for (int i = 0; i < threadCount; i++) {
+        workers.emplace_back(&TaskPool::workerLoop, this);
+    }
+}
+
+TaskPool::~TaskPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeUp.notify_all();
+
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+std::future<void> TaskPool::submit(std::function<void()> task)
+{
+    std::packaged_task<void()> packaged(std::move(task));
+    std::future<void> done = packaged.get_future();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.push_back(std::move(packaged));
+    }
+    wakeUp.notify_one();
+    return done;
+}
+
+void TaskPool::workerLoop()
+{
+    if (threadStart) {
+        threadStart();
+    }
+
+    for (;;) {
+        std::packaged_task<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeUp.wait(lock, [this] { return stopping || !queue.empty(); });
+
+            // Drain the queue before stopping so submitted work always runs
+            if (queue.empty()) {
+                return;
+            }
+            task = std::move(queue.front());
+            queue.pop_front();
+        }
+        task();
+    }
+}
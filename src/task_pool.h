@@ -0,0 +1,54 @@
+// task_pool.h
+// Small fixed-size thread pool for background work
+
+#ifndef LANDER_TASK_POOL_H
+#define LANDER_TASK_POOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// =============================================================================
+// Task Pool
+// =============================================================================
+//
+// Runs tasks on a few worker threads in the order they were submitted. Used at
+// startup so object placement and sound loading overlap with window creation,
+// and the first frame can be drawn while sounds are still loading.
+//
+// submit() returns a future that becomes ready when the task has run. Tasks
+// must not throw. Destroying the pool runs every task that was already
+// submitted, then joins the workers. An optional threadStart function runs on
+// each worker before it takes any task (e.g. to apply a ThreadConfig policy).
+//
+// =============================================================================
+
+class TaskPool {
+public:
+    explicit TaskPool(int threadCount, std::function<void()> threadStart = nullptr);
+    ~TaskPool();
+
+    TaskPool(const TaskPool&) = delete;
+    TaskPool& operator=(const TaskPool&) = delete;
+
+    // Queue a task, returns a future to wait for it
+    std::future<void> submit(std::function<void()> task);
+
+    int getThreadCount() const { return static_cast<int>(workers.size()); }
+
+private:
+    void workerLoop();
+
+    std::function<void()> threadStart;
+    std::vector<std::thread> workers;
+    std::deque<std::packaged_task<void()>> queue;
+    std::mutex mutex;
+    std::condition_variable wakeUp;
+    bool stopping = false;
+};
+
+#endif // LANDER_TASK_POOL_H
@@ -0,0 +1,312 @@
+// telemetry.cpp
+// Local telemetry endpoint over a Unix domain socket
+
+#include "telemetry.h"
+#include "particles.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+// Suppress SIGPIPE when a collector disconnects mid-line
+#if defined(MSG_NOSIGNAL)
+static constexpr int SEND_FLAGS = MSG_NOSIGNAL | MSG_DONTWAIT;
+#elif !defined(_WIN32)
+static constexpr int SEND_FLAGS = MSG_DONTWAIT;
+#endif
+
+// =============================================================================
+// Helpers
+// =============================================================================
+
+static const char* getStageName(int stage)
+{
+    switch (static_cast<TelemetryStage>(stage)) {
+        case TelemetryStage::Update:  return "update";
+        case TelemetryStage::Scene:   return "scene";
+        case TelemetryStage::Present: return "present";
+        default:                      return "other";
+    }
+}
+
+// Nearest-rank percentile of sorted samples, in milliseconds
+static double percentileMs(const uint32_t* sorted, int count, int percent)
+{
+    if (count == 0) return 0.0;
+    int rank = (count * percent + 99) / 100;
+    if (rank < 1) rank = 1;
+    return sorted[rank - 1] / 1000.0;
+}
+
+#ifndef _WIN32
+static bool setNonBlocking(int socket)
+{
+    int flags = fcntl(socket, F_GETFL, 0);
+    return flags >= 0 && fcntl(socket, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+#endif
+
+// =============================================================================
+// TelemetryServer Implementation
+// =============================================================================
+
+TelemetryServer::TelemetryServer()
+{
+    socketPath[0] = '\0';
+    for (int i = 0; i < TELEMETRY_STAGE_COUNT; i++) {
+        stageTotals[i] = 0;
+    }
+}
+
+TelemetryServer::~TelemetryServer()
+{
+    close();
+}
+
+#ifdef _WIN32
+
+bool TelemetryServer::open(const char*) { return false; }
+void TelemetryServer::close() {}
+void TelemetryServer::acceptClients() {}
+void TelemetryServer::closeClient(Client&) {}
+bool TelemetryServer::sendNonBlocking(Client&, const char*, int) { return false; }
+
+#else
+
+bool TelemetryServer::open(const char* path)
+{
+    close();
+
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (std::strlen(path) >= sizeof(address.sun_path) || std::strlen(path) >= sizeof(socketPath)) {
+        return false;
+    }
+    std::strcpy(address.sun_path, path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return false;
+    }
+
+#ifdef SO_NOSIGPIPE
+    int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+
+    // Remove a socket file left behind by a previous run
+    unlink(path);
+
+    if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(fd, MAX_CLIENTS) != 0 || !setNonBlocking(fd)) {
+        ::close(fd);
+        return false;
+    }
+
+    listenSocket = fd;
+    std::strcpy(socketPath, path);
+    return true;
+}
+
+void TelemetryServer::close()
+{
+    for (int i = 0; i < MAX_CLIENTS; i++) {
+        closeClient(clients[i]);
+    }
+    if (listenSocket >= 0) {
+        ::close(listenSocket);
+        listenSocket = -1;
+        unlink(socketPath);
+        socketPath[0] = '\0';
+    }
+}
+
+void TelemetryServer::acceptClients()
+{
+    for (;;) {
+        int fd = accept(listenSocket, nullptr, nullptr);
+        if (fd < 0) {
+            return;  // EAGAIN: no more pending connections
+        }
+
+        Client* slot = nullptr;
+        for (int i = 0; i < MAX_CLIENTS; i++) {
+            if (clients[i].socket < 0) {
+                slot = &clients[i];
+                break;
+            }
+        }
+        if (!slot || !setNonBlocking(fd)) {
+            ::close(fd);
+            continue;
+        }
+
+#ifdef SO_NOSIGPIPE
+        int one = 1;
+        setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+        slot->socket = fd;
+        slot->pendingLength = 0;
+    }
+}
+
+void TelemetryServer::closeClient(Client& client)
+{
+    if (client.socket >= 0) {
+        ::close(client.socket);
+        client.socket = -1;
+    }
+    client.pendingLength = 0;
+}
+
+bool TelemetryServer::sendNonBlocking(Client& client, const char* data, int length)
+{
+    ssize_t sent = send(client.socket, data, static_cast<size_t>(length), SEND_FLAGS);
+    if (sent < 0) {
+        if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+            return false;
+        }
+        sent = 0;
+    }
+
+    // Keep the unsent tail so the collector still gets a whole line
+    int remaining = length - static_cast<int>(sent);
+    std::memmove(client.pending, data + sent, static_cast<size_t>(remaining));
+    client.pendingLength = remaining;
+    return true;
+}
+
+#endif // _WIN32
+
+int TelemetryServer::getClientCount() const
+{
+    int count = 0;
+    for (int i = 0; i < MAX_CLIENTS; i++) {
+        if (clients[i].socket >= 0) {
+            count++;
+        }
+    }
+    return count;
+}
+
+void TelemetryServer::recordFrame(uint32_t frameMicros,
+                                  const uint32_t stageMicros[TELEMETRY_STAGE_COUNT],
+                                  const FrameStats& stats)
+{
+    // Keep the most recent MAX_SAMPLES frames of the interval
+    frameTimes[frameCount % MAX_SAMPLES] = frameMicros;
+    frameCount++;
+
+    for (int i = 0; i < TELEMETRY_STAGE_COUNT; i++) {
+        stageTotals[i] += stageMicros[i];
+    }
+    particlesRejected += stats.particlesRejected;
+    trianglesDropped += stats.trianglesDropped;
+    lastStats = stats;
+}
+
+int TelemetryServer::formatLine(char* buffer, size_t size, const TelemetryStatus& status) const
+{
+    uint32_t sorted[MAX_SAMPLES];
+    int samples = std::min(frameCount, MAX_SAMPLES);
+    std::copy(frameTimes, frameTimes + samples, sorted);
+    std::sort(sorted, sorted + samples);
+
+    int length = 0;
+    auto append = [&](const char* format, auto... args) {
+        if (length < 0) return;
+        int written = std::snprintf(buffer + length, size - length, format, args...);
+        length = (written < 0 || static_cast<size_t>(length + written) >= size) ? -1 : length + written;
+    };
+
+    append("{\"seq\":%llu,\"frames\":%d", static_cast<unsigned long long>(sequence), frameCount);
+
+    append(",\"frame_ms\":{\"p50\":%.2f,\"p90\":%.2f,\"p99\":%.2f,\"max\":%.2f}",
+           percentileMs(sorted, samples, 50), percentileMs(sorted, samples, 90),
+           percentileMs(sorted, samples, 99), percentileMs(sorted, samples, 100));
+
+    append(",\"stage_ms\":{");
+    for (int i = 0; i < TELEMETRY_STAGE_COUNT; i++) {
+        double average = frameCount > 0 ? stageTotals[i] / 1000.0 / frameCount : 0.0;
+        append("%s\"%s\":%.2f", i > 0 ? "," : "", getStageName(i), average);
+    }
+    append("}");
+
+    append(",\"settings\":{\"scale\":%d,\"landscape_scale\":%d,\"target_fps\":%d,"
+           "\"stars\":%s,\"clipping\":%s,\"sound\":%s,\"present\":\"%s\"}",
+           status.displayScale, status.landscapeScale, status.targetFPS,
+           status.stars ? "true" : "false", status.clipping ? "true" : "false",
+           status.sound ? "true" : "false", status.presentMode);
+
+    append(",\"particles\":{\"total\":%d,\"budget\":%d,\"rejected\":%d",
+           lastStats.getParticleTotal(), ParticleConstants::MAX_PARTICLES, particlesRejected);
+    for (int i = 0; i < PARTICLE_KIND_COUNT; i++) {
+        append(",\"%s\":%d", getParticleKindName(static_cast<ParticleKind>(i)), lastStats.particles[i]);
+    }
+    append("}");
+
+    append(",\"triangles_dropped\":%d", trianglesDropped);
+    append(",\"audio\":{\"voices\":%d,\"late_callbacks\":%u}",
+           status.audioVoices, static_cast<unsigned>(status.audioLateCallbacks));
+    append(",\"lines_dropped\":%llu}\n", static_cast<unsigned long long>(linesDropped));
+
+    return length < 0 ? 0 : length;
+}
+
+void TelemetryServer::publish(const TelemetryStatus& status)
+{
+    if (isOpen()) {
+        acceptClients();
+
+        char line[MAX_LINE];
+        int length = getClientCount() > 0 ? formatLine(line, sizeof(line), status) : 0;
+
+        for (int i = 0; i < MAX_CLIENTS && length > 0; i++) {
+            Client& client = clients[i];
+            if (client.socket < 0) continue;
+
+            // Finish the previous line first; if that still doesn't go
+            // through the collector is behind and misses this line
+            if (client.pendingLength > 0) {
+                char pending[MAX_LINE];
+                int pendingLength = client.pendingLength;
+                std::memcpy(pending, client.pending, static_cast<size_t>(pendingLength));
+                if (!sendNonBlocking(client, pending, pendingLength)) {
+                    closeClient(client);
+                    continue;
+                }
+                if (client.pendingLength > 0) {
+                    linesDropped++;
+                    continue;
+                }
+            }
+
+            if (!sendNonBlocking(client, line, length)) {
+                closeClient(client);
+            } else if (client.pendingLength == length) {
+                // Nothing was accepted: drop the line instead of queueing it
+                client.pendingLength = 0;
+                linesDropped++;
+            } else {
+                linesSent++;
+            }
+        }
+    }
+
+    // Start the next interval
+    sequence++;
+    frameCount = 0;
+    for (int i = 0; i < TELEMETRY_STAGE_COUNT; i++) {
+        stageTotals[i] = 0;
+    }
+    particlesRejected = 0;
+    trianglesDropped = 0;
+}
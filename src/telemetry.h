@@ -0,0 +1,119 @@
+// telemetry.h
+// Local telemetry endpoint over a Unix domain socket
+
+#ifndef LANDER_TELEMETRY_H
+#define LANDER_TELEMETRY_H
+
+#include "frame_stats.h"
+#include <cstddef>
+#include <cstdint>
+
+// =============================================================================
+// Telemetry
+// =============================================================================
+//
+// Streams a summary of recent frames to local collectors, one JSON object per
+// line. The game listens on a Unix domain socket (--telemetry <path>) and
+// any number of collectors (up to MAX_CLIENTS) can connect and read lines:
+//
+//   socat - UNIX-CONNECT:/tmp/lander.sock
+//
+// Each line covers the frames since the previous one: frame time percentiles,
+// average time per stage, the active settings, particle counts from the last
+// frame and the audio voice / underrun counters.
+//
+// Publishing never blocks the frame. The socket is non-blocking, and a
+// collector that doesn't keep up simply misses lines: if its socket buffer
+// is full the line is dropped for that collector (and counted), and a line
+// that was only partly sent is finished before any new line is queued, so
+// collectors always see whole lines.
+//
+// Unix domain sockets are not used on Windows, where open() always fails.
+//
+// =============================================================================
+
+// Stages timed by the game loop
+enum class TelemetryStage {
+    Update,     // Physics ticks
+    Scene,      // Drawing the scene and HUD into the screen buffer
+    Present,    // Texture upload and present
+    Count
+};
+
+constexpr int TELEMETRY_STAGE_COUNT = static_cast<int>(TelemetryStage::Count);
+
+// Settings and audio state reported with each line
+struct TelemetryStatus {
+    int displayScale = 1;
+    int landscapeScale = 1;
+    int targetFPS = 0;
+    bool stars = false;
+    bool clipping = false;
+    bool sound = false;
+    const char* presentMode = "vsync";
+    int audioVoices = 0;
+    uint32_t audioLateCallbacks = 0;
+};
+
+class TelemetryServer {
+public:
+    static constexpr int MAX_CLIENTS = 4;
+    static constexpr int MAX_SAMPLES = 1024;     // Frames kept between publishes
+    static constexpr int MAX_LINE = 1024;        // Longest line (and pending data)
+
+    TelemetryServer();
+    ~TelemetryServer();
+
+    // Start listening on the given socket path (replaces a stale socket file)
+    bool open(const char* path);
+    void close();
+    bool isOpen() const { return listenSocket >= 0; }
+
+    // Record one frame: total and per-stage times in microseconds, plus the
+    // scene counters of that frame
+    void recordFrame(uint32_t frameMicros, const uint32_t stageMicros[TELEMETRY_STAGE_COUNT],
+                     const FrameStats& stats);
+
+    // Send a line summarising the frames recorded since the last publish to
+    // every connected collector, then start a new interval
+    void publish(const TelemetryStatus& status);
+
+    // Format the current interval as a JSON line (including the newline)
+    // Returns the line length, or 0 if it doesn't fit
+    int formatLine(char* buffer, size_t size, const TelemetryStatus& status) const;
+
+    int getClientCount() const;
+    uint64_t getLinesSent() const { return linesSent; }
+    uint64_t getLinesDropped() const { return linesDropped; }
+
+private:
+    struct Client {
+        int socket = -1;
+        char pending[MAX_LINE];   // Unsent tail of a partly sent line
+        int pendingLength = 0;
+    };
+
+    void acceptClients();
+    void closeClient(Client& client);
+
+    // Send as much as possible without blocking, returns false on error
+    bool sendNonBlocking(Client& client, const char* data, int length);
+
+    int listenSocket = -1;
+    char socketPath[108];
+    Client clients[MAX_CLIENTS];
+
+    // Current interval
+    uint32_t frameTimes[MAX_SAMPLES];
+    int frameCount = 0;            // Frames recorded (may exceed MAX_SAMPLES)
+    uint64_t stageTotals[TELEMETRY_STAGE_COUNT];
+    int particlesRejected = 0;     // Summed over the interval
+    int trianglesDropped = 0;      // Summed over the interval
+    FrameStats lastStats;
+
+    uint64_t sequence = 0;
+    uint64_t linesSent = 0;
+    uint64_t linesDropped = 0;
+};
+
+#endif // LANDER_TELEMETRY_H
@@ -0,0 +1,214 @@
+// thread_config.cpp
+// Core affinity and scheduling policy for the game's threads
+
+#include "thread_config.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace ThreadConfig {
+    ThreadPolicy policies[THREAD_ROLE_COUNT];
+}
+
+static const char* const SCHED_CLASS_NAMES[SCHED_CLASS_COUNT] = {
+    "default", "batch", "idle", "fifo", "rr"
+};
+
+// =============================================================================
+// Names and Parsing
+// =============================================================================
+
+const char* getThreadRoleName(ThreadRole role)
+{
+    switch (role) {
+        case ThreadRole::Main:   return "main";
+        case ThreadRole::Audio:  return "audio";
+        case ThreadRole::Worker: return "worker";
+        default:                 return "unknown";
+    }
+}
+
+const char* getSchedClassName(SchedClass schedClass)
+{
+    int index = static_cast<int>(schedClass);
+    return (index >= 0 && index < SCHED_CLASS_COUNT) ? SCHED_CLASS_NAMES[index] : "default";
+}
+
+bool parseSchedClass(const char* text, SchedClass& schedClass)
+{
+    for (int i = 0; i < SCHED_CLASS_COUNT; i++) {
+        if (std::strcmp(text, SCHED_CLASS_NAMES[i]) == 0) {
+            schedClass = static_cast<SchedClass>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool parseCpuList(const char* text, uint64_t& mask)
+{
+    uint64_t result = 0;
+    const char* p = text;
+
+    while (*p) {
+        char* end;
+        long first = std::strtol(p, &end, 10);
+        if (end == p || first < 0 || first > 63) return false;
+        long last = first;
+        p = end;
+
+        if (*p == '-') {
+            p++;
+            last = std::strtol(p, &end, 10);
+            if (end == p || last < first || last > 63) return false;
+            p = end;
+        }
+
+        for (long cpu = first; cpu <= last; cpu++) {
+            result |= uint64_t(1) << cpu;
+        }
+
+        if (*p == ',') {
+            p++;
+            if (*p == '\0') return false;
+        } else if (*p != '\0') {
+            return false;
+        }
+    }
+
+    mask = result;
+    return true;
+}
+
+void formatCpuList(uint64_t mask, char* buffer, size_t size)
+{
+    size_t length = 0;
+    buffer[0] = '\0';
+
+    int cpu = 0;
+    while (cpu < 64) {
+        if (!(mask & (uint64_t(1) << cpu))) {
+            cpu++;
+            continue;
+        }
+
+        // Collapse runs of CPUs into ranges
+        int last = cpu;
+        while (last < 63 && (mask & (uint64_t(1) << (last + 1)))) {
+            last++;
+        }
+
+        int written = (last == cpu)
+            ? std::snprintf(buffer + length, size - length, "%s%d", length ? "," : "", cpu)
+            : std::snprintf(buffer + length, size - length, "%s%d-%d", length ? "," : "", cpu, last);
+        if (written < 0 || length + written >= size) {
+            return;
+        }
+        length += written;
+        cpu = last + 1;
+    }
+}
+
+// =============================================================================
+// Applying Policies
+// =============================================================================
+
+// Append "what: reason" to the error text
+static void addError(char* error, size_t errorSize, const char* what, int errorNumber)
+{
+    size_t length = std::strlen(error);
+    if (length + 1 < errorSize) {
+        std::snprintf(error + length, errorSize - length, "%s%s: %s",
+                      length ? ", " : "", what, std::strerror(errorNumber));
+    }
+}
+
+#ifdef __linux__
+
+static int getLinuxPolicy(SchedClass schedClass)
+{
+    switch (schedClass) {
+        case SchedClass::Batch:      return SCHED_BATCH;
+        case SchedClass::Idle:       return SCHED_IDLE;
+        case SchedClass::Fifo:       return SCHED_FIFO;
+        case SchedClass::RoundRobin: return SCHED_RR;
+        default:                     return SCHED_OTHER;
+    }
+}
+
+bool applyThreadPolicy(ThreadRole role, char* error, size_t errorSize)
+{
+    const ThreadPolicy& policy = ThreadConfig::policies[static_cast<int>(role)];
+    error[0] = '\0';
+    bool ok = true;
+
+    if (policy.cpuMask != 0) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int cpu = 0; cpu < 64 && cpu < CPU_SETSIZE; cpu++) {
+            if (policy.cpuMask & (uint64_t(1) << cpu)) {
+                CPU_SET(cpu, &set);
+            }
+        }
+        int result = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+        if (result != 0) {
+            addError(error, errorSize, "affinity", result);
+            ok = false;
+        }
+    }
+
+    bool realTimeApplied = false;
+    if (policy.schedClass != SchedClass::Default) {
+        int linuxPolicy = getLinuxPolicy(policy.schedClass);
+        sched_param param;
+        std::memset(&param, 0, sizeof(param));
+        if (policy.isRealTime()) {
+            int priority = policy.priority;
+            if (priority < sched_get_priority_min(linuxPolicy)) priority = sched_get_priority_min(linuxPolicy);
+            if (priority > sched_get_priority_max(linuxPolicy)) priority = sched_get_priority_max(linuxPolicy);
+            param.sched_priority = priority;
+        }
+        int result = pthread_setschedparam(pthread_self(), linuxPolicy, &param);
+        if (result != 0) {
+            addError(error, errorSize, getSchedClassName(policy.schedClass), result);
+            ok = false;
+        } else {
+            realTimeApplied = policy.isRealTime();
+        }
+    }
+
+    // Nice levels are per thread on Linux; they don't affect real-time
+    // threads, but still apply if a real-time class was refused
+    if (policy.nice != 0 && !realTimeApplied) {
+        pid_t thread = static_cast<pid_t>(syscall(SYS_gettid));
+        if (setpriority(PRIO_PROCESS, static_cast<id_t>(thread), policy.nice) != 0) {
+            addError(error, errorSize, "nice", errno);
+            ok = false;
+        }
+    }
+
+    return ok;
+}
+
+#else
+
+bool applyThreadPolicy(ThreadRole role, char* error, size_t errorSize)
+{
+    error[0] = '\0';
+    if (ThreadConfig::policies[static_cast<int>(role)].isDefault()) {
+        return true;
+    }
+    std::snprintf(error, errorSize, "thread policies are only supported on Linux");
+    return false;
+}
+
+#endif // __linux__
@@ -0,0 +1,96 @@
+// thread_config.h
+// Core affinity and scheduling policy for the game's threads
+
+#ifndef LANDER_THREAD_CONFIG_H
+#define LANDER_THREAD_CONFIG_H
+
+#include <cstddef>
+#include <cstdint>
+
+// =============================================================================
+// Thread Configuration
+// =============================================================================
+//
+// Each thread role (the main thread that runs the simulation and renders,
+// the SDL audio callback thread and the engine's worker threads) can be given
+// its own policy in the settings file:
+//
+//   mainThreadCpus=2-3        CPUs the thread may run on (empty = any)
+//   mainThreadPolicy=fifo     default, batch, idle, fifo or rr
+//   mainThreadPriority=10     Real-time priority for fifo / rr (1-99)
+//   mainThreadNice=-5         Nice level for the other classes (-20 to 19)
+//
+// with audioThread... and workerThread... keys for the other roles. Each
+// thread applies its policy itself when it starts.
+//
+// Policies are applied through the Linux thread APIs, one part at a time, so
+// a part the process is not permitted to change (a real-time class without
+// CAP_SYS_NICE or RLIMIT_RTPRIO, a negative nice level) leaves that part at
+// the kernel default and the rest still applies. When a real-time class is
+// refused, the nice level is applied instead. Other platforms ignore the
+// policies and report them as unsupported.
+//
+// =============================================================================
+
+enum class ThreadRole {
+    Main,       // Simulation and rendering
+    Audio,      // SDL audio callback
+    Worker,     // TaskPool workers
+    Count
+};
+
+constexpr int THREAD_ROLE_COUNT = static_cast<int>(ThreadRole::Count);
+
+enum class SchedClass {
+    Default,    // SCHED_OTHER
+    Batch,      // SCHED_BATCH
+    Idle,       // SCHED_IDLE
+    Fifo,       // SCHED_FIFO (real-time)
+    RoundRobin, // SCHED_RR (real-time)
+    Count
+};
+
+constexpr int SCHED_CLASS_COUNT = static_cast<int>(SchedClass::Count);
+
+struct ThreadPolicy {
+    uint64_t cpuMask = 0;                     // Bit n = CPU n, 0 = any CPU
+    SchedClass schedClass = SchedClass::Default;
+    int priority = 0;                         // Real-time priority (fifo / rr)
+    int nice = 0;                             // Nice level (other classes)
+
+    bool isDefault() const {
+        return cpuMask == 0 && schedClass == SchedClass::Default && nice == 0;
+    }
+
+    bool isRealTime() const {
+        return schedClass == SchedClass::Fifo || schedClass == SchedClass::RoundRobin;
+    }
+};
+
+namespace ThreadConfig {
+    // Policy for each role (loaded from settings)
+    extern ThreadPolicy policies[THREAD_ROLE_COUNT];
+
+    // Nice levels and real-time priorities accepted in settings
+    constexpr int MIN_NICE = -20;
+    constexpr int MAX_NICE = 19;
+    constexpr int MIN_PRIORITY = 1;
+    constexpr int MAX_PRIORITY = 99;
+}
+
+// Role name used in logs and as the settings key prefix ("main", ...)
+const char* getThreadRoleName(ThreadRole role);
+
+// Scheduling class names used in settings ("default", "fifo", ...)
+const char* getSchedClassName(SchedClass schedClass);
+bool parseSchedClass(const char* text, SchedClass& schedClass);
+
+// CPU lists like "0,2-3" (empty = any CPU, up to 64 CPUs)
+bool parseCpuList(const char* text, uint64_t& mask);
+void formatCpuList(uint64_t mask, char* buffer, size_t size);
+
+// Apply the role's policy to the calling thread
+// Returns false if any part could not be applied, with the reasons in error
+bool applyThreadPolicy(ThreadRole role, char* error, size_t errorSize);
+
+#endif // LANDER_THREAD_CONFIG_H
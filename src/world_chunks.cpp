@@ -0,0 +1,256 @@
+// world_chunks.cpp
+// Unbounded world: wide positions and objects streamed in 64x64 tile chunks
+
+#include "world_chunks.h"
+#include "landscape.h"
+#include <cstring>
+
+// =============================================================================
+// Helpers
+// =============================================================================
+
+// Window slot that shows a chunk (chunks are congruent to their slot mod 4)
+static int getSlot(int64_t chunkX, int64_t chunkZ)
+{
+    constexpr int mask = ChunkedWorld::WINDOW_CHUNKS - 1;
+    return static_cast<int>(chunkZ & mask) * ChunkedWorld::WINDOW_CHUNKS +
+           static_cast<int>(chunkX & mask);
+}
+
+// First window tile of a slot on each axis
+static uint8_t getSlotTileX(int slot)
+{
+    return static_cast<uint8_t>((slot % ChunkedWorld::WINDOW_CHUNKS) * ChunkedWorld::CHUNK_SIZE);
+}
+
+static uint8_t getSlotTileZ(int slot)
+{
+    return static_cast<uint8_t>((slot / ChunkedWorld::WINDOW_CHUNKS) * ChunkedWorld::CHUNK_SIZE);
+}
+
+// Scramble a 64-bit value into 32 well-mixed bits (splitmix64 finalizer)
+static uint32_t mixBits(uint64_t value)
+{
+    value ^= value >> 30;
+    value *= 0xBF58476D1CE4E5B9ULL;
+    value ^= value >> 27;
+    value *= 0x94D049BB133111EBULL;
+    value ^= value >> 31;
+    return static_cast<uint32_t>(value);
+}
+
+// =============================================================================
+// ChunkedWorld Implementation
+// =============================================================================
+
+ChunkedWorld::ChunkedWorld(ObjectMap& window, uint32_t seed)
+    : window(window), seed(seed)
+{
+}
+
+void ChunkedWorld::reset(const WidePosition& player)
+{
+    // Drop the window without saving it, so every chunk is shown as generated
+    deltas.clear();
+    for (int slot = 0; slot < WINDOW_SLOTS; slot++) {
+        if (slots[slot]) {
+            slots[slot]->slot = -1;
+            slots[slot] = nullptr;
+        }
+    }
+    windowValid = false;
+    update(player);
+}
+
+void ChunkedWorld::update(const WidePosition& player)
+{
+    // Keep the player in the middle of the window, moving it a chunk at a
+    // time once the player is half a chunk past the middle
+    int64_t firstX = getChunk(player.getTileX() + CHUNK_SIZE / 2) - WINDOW_CHUNKS / 2;
+    int64_t firstZ = getChunk(player.getTileZ() + CHUNK_SIZE / 2) - WINDOW_CHUNKS / 2;
+    if (windowValid && firstX == windowX && firstZ == windowZ) {
+        return;
+    }
+
+    for (int64_t chunkZ = firstZ; chunkZ < firstZ + WINDOW_CHUNKS; chunkZ++) {
+        for (int64_t chunkX = firstX; chunkX < firstX + WINDOW_CHUNKS; chunkX++) {
+            int slot = getSlot(chunkX, chunkZ);
+            Chunk* shown = slots[slot];
+            if (shown && shown->x == chunkX && shown->z == chunkZ) {
+                continue;
+            }
+            if (shown) {
+                storeSlot(slot);
+            }
+            loadSlot(slot, chunkX, chunkZ);
+        }
+    }
+
+    windowX = firstX;
+    windowZ = firstZ;
+    windowValid = true;
+}
+
+uint8_t ChunkedWorld::getObjectAt(int64_t tileX, int64_t tileZ)
+{
+    int64_t chunkX = getChunk(tileX);
+    int64_t chunkZ = getChunk(tileZ);
+
+    // In the window: the window has the latest state
+    Chunk* shown = slots[getSlot(chunkX, chunkZ)];
+    if (shown && shown->x == chunkX && shown->z == chunkZ) {
+        return window.getObjectAt(static_cast<uint8_t>(tileX), static_cast<uint8_t>(tileZ));
+    }
+
+    // Elsewhere: the generated object unless a delta replaced it
+    int localX = static_cast<int>(tileX & (CHUNK_SIZE - 1));
+    int localZ = static_cast<int>(tileZ & (CHUNK_SIZE - 1));
+    auto changes = deltas.find(ChunkKey(chunkX, chunkZ));
+    if (changes != deltas.end()) {
+        uint16_t index = static_cast<uint16_t>(localZ * CHUNK_SIZE + localX);
+        for (const Delta& delta : changes->second) {
+            if (delta.index == index) return delta.objectType;
+        }
+    }
+    return getCachedChunk(chunkX, chunkZ).objects[localZ][localX];
+}
+
+int ChunkedWorld::getCachedChunks() const
+{
+    int count = 0;
+    for (const Chunk& chunk : cache) {
+        if (chunk.valid) count++;
+    }
+    return count;
+}
+
+size_t ChunkedWorld::getDeltaCount() const
+{
+    size_t count = 0;
+    for (const auto& entry : deltas) {
+        count += entry.second.size();
+    }
+    return count;
+}
+
+ChunkedWorld::Chunk& ChunkedWorld::getCachedChunk(int64_t chunkX, int64_t chunkZ)
+{
+    Chunk* victim = nullptr;
+    for (Chunk& chunk : cache) {
+        if (chunk.valid && chunk.x == chunkX && chunk.z == chunkZ) {
+            chunk.lastUsed = ++useClock;
+            return chunk;
+        }
+
+        // Chunks in the window are never evicted
+        if (!chunk.valid) {
+            if (!victim || victim->valid) victim = &chunk;
+        } else if (chunk.slot < 0 && (!victim || (victim->valid && chunk.lastUsed < victim->lastUsed))) {
+            victim = &chunk;
+        }
+    }
+
+    victim->x = chunkX;
+    victim->z = chunkZ;
+    victim->valid = true;
+    victim->slot = -1;
+    victim->lastUsed = ++useClock;
+    generate(*victim);
+    return *victim;
+}
+
+void ChunkedWorld::generate(Chunk& chunk)
+{
+    using namespace GameConstants;
+
+    std::memset(chunk.objects, ObjectType::NONE, sizeof(chunk.objects));
+
+    // Each chunk has its own random sequence, seeded from its position
+    uint64_t key = static_cast<uint64_t>(chunk.x) * 0x9E3779B97F4A7C15ULL ^
+                   static_cast<uint64_t>(chunk.z) * 0xC2B2AE3D27D4EB4FULL ^ seed;
+    RandomNumberGenerator rng;
+    rng.seed(mixBits(key) | 1, mixBits(key + 1));
+
+    // Placed as in placeObjectsOnMap(): x from the top bits of the random
+    // number, z from the next byte, avoiding the sea and the launchpad
+    for (int i = 0; i < OBJECTS_PER_CHUNK; i++) {
+        uint32_t r0, r1;
+        rng.getRandomNumbers(r0, r1);
+        int localX = static_cast<int>(r0 >> 26);
+        int localZ = static_cast<int>((r0 << 8) >> 26);
+
+        // The terrain repeats every 256 tiles, so the 8.24 tile is enough
+        uint32_t tileX = static_cast<uint32_t>(chunk.x * CHUNK_SIZE + localX) & 0xFF;
+        uint32_t tileZ = static_cast<uint32_t>(chunk.z * CHUNK_SIZE + localZ) & 0xFF;
+        Fixed altitude = getLandscapeAltitude(Fixed::fromRaw(static_cast<int32_t>(tileX << 24)),
+                                              Fixed::fromRaw(static_cast<int32_t>(tileZ << 24)));
+        if (altitude == SEA_LEVEL || altitude == LAUNCHPAD_ALTITUDE) {
+            continue;
+        }
+
+        chunk.objects[localZ][localX] = static_cast<uint8_t>((r0 & 7) + 1);
+    }
+
+    // Every launchpad keeps its three rockets
+    if ((chunk.x & (WINDOW_CHUNKS - 1)) == 0 && (chunk.z & (WINDOW_CHUNKS - 1)) == 0) {
+        chunk.objects[1][7] = ObjectType::LAUNCHPAD_OBJECT;
+        chunk.objects[3][7] = ObjectType::LAUNCHPAD_OBJECT;
+        chunk.objects[5][7] = ObjectType::LAUNCHPAD_OBJECT;
+    }
+
+    chunksGenerated++;
+}
+
+void ChunkedWorld::storeSlot(int slot)
+{
+    Chunk& chunk = *slots[slot];
+    uint8_t tileX = getSlotTileX(slot);
+    uint8_t tileZ = getSlotTileZ(slot);
+
+    // Whatever differs from the generated chunk is a delta
+    std::vector<Delta> changes;
+    for (int z = 0; z < CHUNK_SIZE; z++) {
+        for (int x = 0; x < CHUNK_SIZE; x++) {
+            uint8_t objectType = window.getObjectAt(static_cast<uint8_t>(tileX + x),
+                                                    static_cast<uint8_t>(tileZ + z));
+            if (objectType != chunk.objects[z][x]) {
+                changes.push_back({static_cast<uint16_t>(z * CHUNK_SIZE + x), objectType});
+            }
+        }
+    }
+
+    ChunkKey key(chunk.x, chunk.z);
+    if (changes.empty()) {
+        deltas.erase(key);
+    } else {
+        deltas[key] = std::move(changes);
+    }
+
+    chunk.slot = -1;
+    slots[slot] = nullptr;
+}
+
+void ChunkedWorld::loadSlot(int slot, int64_t chunkX, int64_t chunkZ)
+{
+    Chunk& chunk = getCachedChunk(chunkX, chunkZ);
+    chunk.slot = slot;
+    slots[slot] = &chunk;
+
+    uint8_t tileX = getSlotTileX(slot);
+    uint8_t tileZ = getSlotTileZ(slot);
+    for (int z = 0; z < CHUNK_SIZE; z++) {
+        for (int x = 0; x < CHUNK_SIZE; x++) {
+            window.setObjectAt(static_cast<uint8_t>(tileX + x), static_cast<uint8_t>(tileZ + z),
+                               chunk.objects[z][x]);
+        }
+    }
+
+    auto changes = deltas.find(ChunkKey(chunkX, chunkZ));
+    if (changes != deltas.end()) {
+        for (const Delta& delta : changes->second) {
+            window.setObjectAt(static_cast<uint8_t>(tileX + delta.index % CHUNK_SIZE),
+                               static_cast<uint8_t>(tileZ + delta.index / CHUNK_SIZE),
+                               delta.objectType);
+        }
+    }
+}
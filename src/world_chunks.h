@@ -0,0 +1,152 @@
+// world_chunks.h
+// Unbounded world: wide positions and objects streamed in 64x64 tile chunks
+
+#ifndef LANDER_WORLD_CHUNKS_H
+#define LANDER_WORLD_CHUNKS_H
+
+#include "math3d.h"
+#include "object_map.h"
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+
+// =============================================================================
+// Unbounded World
+// =============================================================================
+//
+// Positions are 8.24 fixed point, so the world wraps every 256 tiles and the
+// original ObjectMap holds the objects for exactly one wrap: flying in a
+// straight line brings the same objects round again. In an unbounded world
+// the objects are instead generated per 64x64 tile chunk from a seeded RNG,
+// so every chunk of the world has its own.
+//
+// The game itself still runs in 8.24 - physics, particles and the renderer
+// are unchanged and everything is drawn camera-relative as before. What
+// changes is:
+//
+// - WidePosition follows the player's 8.24 position across wraps in 40.24
+//   fixed point, so the game knows which chunk the player is really in
+// - ObjectMap becomes a window onto the world: its 256x256 tiles are 4x4
+//   chunk slots, and tile (x, z) holds the object of the nearest wide tile
+//   that wraps to (x, z). ChunkedWorld keeps the slots filled with the
+//   chunks around the player (at least 96 tiles in every direction, more
+//   than the landscape ever shows), so all code that reads and writes
+//   objects through ObjectMap keeps working
+// - Generated chunks are kept in a small LRU cache, and an object's changes
+//   (destroyed, or restored) are stored as deltas against its generated
+//   chunk when the chunk leaves the window. They are applied again when it
+//   comes back, however long the player has been away
+//
+// Memory and per-tick cost don't depend on how far the player travels: the
+// window and cache have fixed sizes, the per-tick check compares the
+// player's chunk with the last one, and streaming a chunk in or out is a
+// copy of one slot. Only the deltas grow, with the number of objects the
+// player has destroyed.
+//
+// The terrain comes from a Fourier series whose periods all divide 256
+// tiles, so the landscape (and the launchpad with its rockets) still repeats
+// every 256 tiles; it is only the object layout that no longer does.
+//
+// =============================================================================
+
+// Position in the unbounded world, in 40.24 fixed point
+struct WidePosition {
+    int64_t x = 0;
+    int64_t z = 0;
+
+    // Jump to an 8.24 position in the first wrap (the launchpad's)
+    void set(const Vec3& position) {
+        x = position.x.raw;
+        z = position.z.raw;
+    }
+
+    // Follow an 8.24 position that moved less than half a wrap
+    void follow(const Vec3& position) {
+        x += static_cast<int32_t>(static_cast<uint32_t>(position.x.raw) - static_cast<uint32_t>(x));
+        z += static_cast<int32_t>(static_cast<uint32_t>(position.z.raw) - static_cast<uint32_t>(z));
+    }
+
+    int64_t getTileX() const { return x >> 24; }
+    int64_t getTileZ() const { return z >> 24; }
+};
+
+class ChunkedWorld {
+public:
+    static constexpr int CHUNK_SIZE = 64;
+    static constexpr int WINDOW_CHUNKS = ObjectMapConstants::MAP_SIZE / CHUNK_SIZE;
+    static constexpr int WINDOW_SLOTS = WINDOW_CHUNKS * WINDOW_CHUNKS;
+
+    // Generated chunks kept: the window's chunks plus as many recent ones
+    static constexpr int CACHE_CHUNKS = 2 * WINDOW_SLOTS;
+
+    // Same density as the original's 2048 objects over 256x256 tiles
+    static constexpr int OBJECTS_PER_CHUNK = ObjectMapConstants::OBJECT_COUNT / WINDOW_SLOTS;
+
+    static constexpr uint32_t DEFAULT_SEED = 0x4C414E44;
+
+    // The window is usually the global objectMap
+    explicit ChunkedWorld(ObjectMap& window, uint32_t seed = DEFAULT_SEED);
+
+    // Forget every change and fill the window around the player
+    void reset(const WidePosition& player);
+
+    // Stream chunks into the window as the player moves (once per tick)
+    void update(const WidePosition& player);
+
+    // Object at a wide tile as it is now, wherever it is
+    uint8_t getObjectAt(int64_t tileX, int64_t tileZ);
+
+    // Chunk holding a wide tile
+    static int64_t getChunk(int64_t tile) { return tile >> 6; }
+
+    // Statistics
+    int getChunksGenerated() const { return chunksGenerated; }
+    int getCachedChunks() const;
+    size_t getDeltaCount() const;
+
+private:
+    struct Chunk {
+        int64_t x = 0;
+        int64_t z = 0;
+        bool valid = false;
+        int slot = -1;                  // Window slot showing it, or -1
+        uint64_t lastUsed = 0;
+        uint8_t objects[CHUNK_SIZE][CHUNK_SIZE];
+    };
+
+    // A changed object within a chunk
+    struct Delta {
+        uint16_t index;                 // z * CHUNK_SIZE + x
+        uint8_t objectType;
+    };
+
+    using ChunkKey = std::pair<int64_t, int64_t>;
+
+    // Find or generate a chunk, evicting the least recently used one that
+    // is not in the window
+    Chunk& getCachedChunk(int64_t chunkX, int64_t chunkZ);
+    void generate(Chunk& chunk);
+
+    // Move a slot's chunk out of the window (saving its deltas) and another in
+    void storeSlot(int slot);
+    void loadSlot(int slot, int64_t chunkX, int64_t chunkZ);
+
+    ObjectMap& window;
+    uint32_t seed;
+
+    Chunk cache[CACHE_CHUNKS];
+    Chunk* slots[WINDOW_SLOTS] = {};
+    uint64_t useClock = 0;
+    int chunksGenerated = 0;
+
+    // First chunk of the window on each axis, and whether it is filled
+    int64_t windowX = 0;
+    int64_t windowZ = 0;
+    bool windowValid = false;
+
+    std::map<ChunkKey, std::vector<Delta>> deltas;
+};
+
+#endif // LANDER_WORLD_CHUNKS_H
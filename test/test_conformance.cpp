@@ -0,0 +1,330 @@
+// test_conformance.cpp
+// Checks that every optimized render path produces exactly the same frame as
+// the reference path (scanline triangles, one drawTile() per terrain tile)
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "../src/landscape_renderer.h"
+#include "../src/landscape.h"
+#include "../src/particles.h"
+#include "../src/object_map.h"
+#include "../src/graphics_buffer.h"
+#include "../src/clipping.h"
+
+// =============================================================================
+// Simple Test Framework
+// =============================================================================
+
+static int testsRun = 0;
+static int testsPassed = 0;
+static int testsFailed = 0;
+
+#define TEST(name) void test_##name()
+#define RUN_TEST(name) do { \
+    std::printf("  %s... ", #name); \
+    std::fflush(stdout); \
+    testsRun++; \
+    int failedBefore = testsFailed; \
+    test_##name(); \
+    if (testsFailed == failedBefore) { \
+        testsPassed++; \
+        std::printf("PASSED\n"); \
+    } \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        std::printf("FAILED\n    Assertion failed: %s\n    at %s:%d\n", \
+                    #cond, __FILE__, __LINE__); \
+        testsFailed++; \
+        return; \
+    } \
+} while(0)
+
+// =============================================================================
+// Render Paths
+// =============================================================================
+
+struct RenderPath {
+    const char* name;
+    RasterBackend backend;
+    bool terrainStrips;
+};
+
+static const RenderPath REFERENCE_PATH = {"reference", RasterBackend::Scanline, false};
+
+// Every optimized path must match the reference frame bit for bit
+static const RenderPath OPTIMIZED_PATHS[] = {
+    {"strips", RasterBackend::Scanline, true},
+    {"blocks", RasterBackend::EdgeBlocks, false},
+    {"blocks_strips", RasterBackend::EdgeBlocks, true},
+};
+
+// =============================================================================
+// Scenes
+// =============================================================================
+
+enum class ParticleScene {
+    None,        // Landscape and objects only
+    Exhaust,     // Exhaust plume, bullets and splashes
+    Explosions,  // Explosions with sparks, debris and smoke
+    Sky          // High altitude: stars and falling rocks
+};
+
+// Camera target positions (x, y, z in tiles / 16)
+static const int CAMERA_POSITIONS[][3] = {
+    {0, -8, 0},
+    {37, -24, 53},
+    {165, -40, 290},
+    {420, -12, 777},
+};
+
+constexpr int CAMERA_COUNT = sizeof(CAMERA_POSITIONS) / sizeof(CAMERA_POSITIONS[0]);
+
+static Vec3 cameraTarget(int index) {
+    Vec3 pos;
+    pos.x = Fixed::fromRaw(CAMERA_POSITIONS[index][0] << 20);
+    pos.y = Fixed::fromRaw(CAMERA_POSITIONS[index][1] << 20);
+    pos.z = Fixed::fromRaw(CAMERA_POSITIONS[index][2] << 20);
+    return pos;
+}
+
+// Fill the particle system for a scene around the ship position
+// The particles are simulated for a few frames so they spread out
+static void buildParticleScene(ParticleScene scene, const Vec3& shipPos) {
+    particleSystem.clear();
+
+    Vec3 vel = {Fixed(0), Fixed(0), Fixed(0)};
+    Vec3 down = {Fixed(0), Fixed::fromRaw(0x200000), Fixed(0)};
+    Vec3 forward = {Fixed::fromRaw(0x100000), Fixed::fromRaw(-0x80000), Fixed::fromRaw(0x400000)};
+
+    for (int frame = 0; frame < 24; frame++) {
+        switch (scene) {
+            case ParticleScene::None:
+                break;
+            case ParticleScene::Exhaust:
+                spawnExhaustParticles(shipPos, vel, down, true);
+                spawnBulletParticle(shipPos, vel, forward);
+                if (frame % 8 == 0) {
+                    spawnSplashParticles(shipPos, down, frame == 0);
+                }
+                break;
+            case ParticleScene::Explosions:
+                if (frame % 6 == 0) {
+                    Vec3 pos = shipPos;
+                    pos.x = Fixed::fromRaw(pos.x.raw + (frame - 12) * 0x400000);
+                    pos.z = Fixed::fromRaw(pos.z.raw + frame * 0x200000);
+                    spawnExplosionParticles(pos, 20);
+                    spawnSmokeParticle(pos);
+                }
+                break;
+            case ParticleScene::Sky:
+                updateStars(shipPos, forward, StarConfig::MAX_ALTITUDE);
+                if (frame % 8 == 0) {
+                    Vec3 rockPos = shipPos;
+                    rockPos.y = Fixed::fromRaw(rockPos.y.raw - 0x4000000);
+                    spawnRock(rockPos);
+                }
+                break;
+        }
+        particleSystem.update();
+    }
+}
+
+// =============================================================================
+// Frame Comparison
+// =============================================================================
+
+static ScreenBuffer referenceFrame;
+static ScreenBuffer optimizedFrame;
+static LandscapeRenderer landscapeRenderer;
+
+// FNV-1a over the visible part of the frame
+static uint64_t hashFrame(const ScreenBuffer& screen) {
+    uint64_t hash = 14695981039346656037ull;
+    for (int y = 0; y < ScreenBuffer::PHYSICAL_HEIGHT(); y++) {
+        const uint8_t* row = screen.getData() + y * ScreenBuffer::getPitch();
+        for (int i = 0; i < ScreenBuffer::getCurrentPitch(); i++) {
+            hash = (hash ^ row[i]) * 1099511628211ull;
+        }
+    }
+    return hash;
+}
+
+// Draw the current scene the way the game does, through the given path
+static void renderFrame(const RenderPath& path, const Camera& camera, ScreenBuffer& screen) {
+    RasterConfig::backend = path.backend;
+    RasterConfig::terrainStrips = path.terrainStrips;
+
+    // Rocks spin every time they are buffered: draw every path at one angle
+    setRockRotationAngle(0);
+
+    Fixed shipDepthZ = Fixed::fromInt(15);
+    screen.clear(Color::black());
+    landscapeRenderer.renderObjects(screen, camera);
+    bufferParticlesBehind(camera, shipDepthZ);
+    bufferStars(camera);
+    bufferRocks(camera);
+    bufferParticlesInFront(camera, shipDepthZ);
+    landscapeRenderer.render(screen, camera);
+
+    RasterConfig::backend = RasterBackend::Scanline;
+    RasterConfig::terrainStrips = true;
+}
+
+// Save the reference frame, the optimized frame and a diff image where
+// matching pixels are dimmed and mismatching pixels are magenta
+static void dumpMismatch(const char* sceneName, const RenderPath& path) {
+    static ScreenBuffer diff;
+    int width = ScreenBuffer::PHYSICAL_WIDTH();
+    int height = ScreenBuffer::PHYSICAL_HEIGHT();
+    diff.clear(Color::black());
+
+    int mismatches = 0;
+    for (int y = 0; y < height; y++) {
+        int offset = y * ScreenBuffer::getPitch();
+        const uint8_t* a = referenceFrame.getData() + offset;
+        const uint8_t* b = optimizedFrame.getData() + offset;
+        uint8_t* out = diff.getData() + offset;
+        for (int x = 0; x < width * 4; x += 4) {
+            bool same = std::memcmp(a + x, b + x, 4) == 0;
+            out[x + 0] = same ? a[x + 0] / 4 : 255;
+            out[x + 1] = same ? a[x + 1] / 4 : 0;
+            out[x + 2] = same ? a[x + 2] / 4 : 255;
+            out[x + 3] = 255;
+            mismatches += same ? 0 : 1;
+        }
+    }
+
+    char filename[128];
+    std::snprintf(filename, sizeof(filename), "conformance_%s_reference.png", sceneName);
+    referenceFrame.savePNG(filename);
+    std::snprintf(filename, sizeof(filename), "conformance_%s_%s.png", sceneName, path.name);
+    optimizedFrame.savePNG(filename);
+    std::snprintf(filename, sizeof(filename), "conformance_%s_%s_diff.png", sceneName, path.name);
+    diff.savePNG(filename);
+
+    std::printf("\n    %s differs from reference in %s (%d pixels), see %s\n    ",
+                path.name, sceneName, mismatches, filename);
+}
+
+// Render a particle scene from every camera position at every landscape
+// scale, display scale and clipping mode, and compare all paths
+static bool sceneMatches(ParticleScene scene, const char* sceneLabel) {
+    static const int LANDSCAPE_SCALES[] = {1, 2, 4, 8};
+    static const int DISPLAY_SCALES[] = {1, 2, 4};
+
+    int originalScale = DisplayConfig::scale;
+    int originalLandscapeScale = GameConstants::landscapeScale;
+    bool originalClipping = ClippingConfig::enabled;
+    bool ok = true;
+
+    for (int cam = 0; cam < CAMERA_COUNT && ok; cam++) {
+        Vec3 shipPos = cameraTarget(cam);
+        Camera camera;
+        camera.followTarget(shipPos, false);
+        buildParticleScene(scene, shipPos);
+
+        for (int landscapeScale : LANDSCAPE_SCALES) {
+            for (int displayScale : DISPLAY_SCALES) {
+                for (int clipping = 0; clipping < 2 && ok; clipping++) {
+                    GameConstants::landscapeScale = landscapeScale;
+                    DisplayConfig::scale = displayScale;
+                    ClippingConfig::enabled = clipping != 0;
+
+                    renderFrame(REFERENCE_PATH, camera, referenceFrame);
+                    uint64_t referenceHash = hashFrame(referenceFrame);
+
+                    for (const RenderPath& path : OPTIMIZED_PATHS) {
+                        renderFrame(path, camera, optimizedFrame);
+                        if (hashFrame(optimizedFrame) != referenceHash) {
+                            char sceneName[64];
+                            std::snprintf(sceneName, sizeof(sceneName), "%s_cam%d_land%d_x%d_%s",
+                                          sceneLabel, cam, landscapeScale, displayScale,
+                                          clipping ? "clip" : "noclip");
+                            dumpMismatch(sceneName, path);
+                            ok = false;
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    DisplayConfig::scale = originalScale;
+    GameConstants::landscapeScale = originalLandscapeScale;
+    ClippingConfig::enabled = originalClipping;
+    return ok;
+}
+
+// =============================================================================
+// Tests
+// =============================================================================
+
+TEST(landscape_and_objects) {
+    ASSERT(sceneMatches(ParticleScene::None, "objects"));
+}
+
+TEST(exhaust_and_bullets) {
+    ASSERT(sceneMatches(ParticleScene::Exhaust, "exhaust"));
+}
+
+TEST(explosions) {
+    ASSERT(sceneMatches(ParticleScene::Explosions, "explosions"));
+}
+
+TEST(stars_and_rocks) {
+    ASSERT(sceneMatches(ParticleScene::Sky, "sky"));
+}
+
+TEST(scene_is_not_empty) {
+    // Guard against a harness that compares blank frames
+    Camera camera;
+    camera.followTarget(cameraTarget(1), false);
+    buildParticleScene(ParticleScene::Explosions, cameraTarget(1));
+    ASSERT(particleSystem.getParticleCount() > 0);
+
+    renderFrame(REFERENCE_PATH, camera, referenceFrame);
+    int lit = 0;
+    for (int y = 0; y < ScreenBuffer::PHYSICAL_HEIGHT(); y += 7) {
+        const uint8_t* row = referenceFrame.getData() + y * ScreenBuffer::getPitch();
+        for (int x = 0; x < ScreenBuffer::PHYSICAL_WIDTH() * 4; x += 28) {
+            if (row[x] != 0 || row[x + 1] != 0 || row[x + 2] != 0) lit++;
+        }
+    }
+    ASSERT(lit > 1000);
+
+    // Hashes must see single pixel changes
+    uint64_t before = hashFrame(referenceFrame);
+    referenceFrame.getData()[ScreenBuffer::getPitch() * 100 + 400] ^= 1;
+    ASSERT(hashFrame(referenceFrame) != before);
+}
+
+// =============================================================================
+// Main
+// =============================================================================
+
+int main() {
+    std::printf("Render Path Conformance Tests\n");
+    std::printf("=============================\n\n");
+
+    // Same object layout as the game
+    placeObjectsOnMap();
+
+    std::printf("Harness:\n");
+    RUN_TEST(scene_is_not_empty);
+
+    std::printf("\nScenes (all optimized paths against the reference):\n");
+    RUN_TEST(landscape_and_objects);
+    RUN_TEST(exhaust_and_bullets);
+    RUN_TEST(explosions);
+    RUN_TEST(stars_and_rocks);
+
+    std::printf("\n=============================\n");
+    std::printf("Tests: %d total, %d passed, %d failed\n",
+                testsRun, testsPassed, testsFailed);
+
+    return testsFailed > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
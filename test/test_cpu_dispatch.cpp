@@ -0,0 +1,214 @@
+// test_cpu_dispatch.cpp
+// Test every CPU level's kernels give exactly the scalar results
+
+#include "cpu_dispatch.h"
+#include "landscape.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+// =============================================================================
+// Simple Test Framework
+// =============================================================================
+
+static int testsRun = 0;
+static int testsPassed = 0;
+static int testsFailed = 0;
+
+#define TEST(name) void test_##name()
+#define RUN_TEST(name) do { \
+    std::printf("  %s... ", #name); \
+    std::fflush(stdout); \
+    testsRun++; \
+    int failedBefore = testsFailed; \
+    test_##name(); \
+    if (testsFailed == failedBefore) { \
+        testsPassed++; \
+        std::printf("PASSED\n"); \
+    } \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        std::printf("FAILED\n    Assertion failed: %s\n    at %s:%d\n", \
+                    #cond, __FILE__, __LINE__); \
+        testsFailed++; \
+        return; \
+    } \
+} while(0)
+
+// =============================================================================
+// Helpers
+// =============================================================================
+
+static uint32_t randomState = 0x12345678;
+
+static uint32_t nextRandom()
+{
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return randomState;
+}
+
+// Levels whose kernels this machine can run
+static std::vector<CpuLevel> runnableLevels()
+{
+    std::vector<CpuLevel> levels;
+    for (int i = 0; i <= static_cast<int>(CpuDispatch::detect()); i++) {
+        CpuLevel level = static_cast<CpuLevel>(i);
+        if (CpuDispatch::getKernels(level).targeted) {
+            levels.push_back(level);
+        }
+    }
+    return levels;
+}
+
+// =============================================================================
+// Tests
+// =============================================================================
+
+TEST(selection)
+{
+    // Before selection the baseline kernels are bound
+    ASSERT(CpuDispatch::kernels == &CpuDispatch::getKernels(CpuLevel::Baseline));
+    ASSERT(CpuDispatch::level == CpuLevel::Baseline);
+
+    CpuLevel best = CpuDispatch::detect();
+    ASSERT(best >= CpuLevel::Baseline);
+    ASSERT(CpuDispatch::getKernels(best).targeted);
+
+    // Asking for more than the machine has gives the best it has
+    CpuLevel bound = CpuDispatch::select(CpuLevel::AVX512);
+    ASSERT(bound == best);
+    ASSERT(CpuDispatch::kernels == &CpuDispatch::getKernels(best));
+
+    // Lower levels can be forced
+    bound = CpuDispatch::select(CpuLevel::Scalar);
+    ASSERT(bound == CpuLevel::Scalar);
+    ASSERT(CpuDispatch::kernels == &CpuDispatch::getKernels(CpuLevel::Scalar));
+    bound = CpuDispatch::select(CpuLevel::Baseline);
+    ASSERT(bound == CpuLevel::Baseline);
+    ASSERT(CpuDispatch::kernels == &CpuDispatch::getKernels(CpuLevel::Baseline));
+}
+
+TEST(level_names)
+{
+    for (int i = 0; i < CPU_LEVEL_COUNT; i++) {
+        CpuLevel level = static_cast<CpuLevel>(i);
+        CpuLevel found = CpuLevel::Count;
+        bool known = CpuDispatch::findLevel(CpuDispatch::getLevelName(level), found);
+        ASSERT(known);
+        // The baseline is named after its backend, "scalar" without SIMD
+        ASSERT(found == level || std::strcmp(CpuDispatch::getLevelName(found), "scalar") == 0);
+    }
+
+    CpuLevel found = CpuLevel::Scalar;
+    bool known = CpuDispatch::findLevel("avx2", found);
+    ASSERT(known && found == CpuLevel::AVX2);
+    known = CpuDispatch::findLevel("mmx", found);
+    ASSERT(!known);
+}
+
+TEST(fill_pixels)
+{
+    for (CpuLevel level : runnableLevels()) {
+        const CpuKernels& kernels = CpuDispatch::getKernels(level);
+        for (int offset = 0; offset < 4; offset++) {
+            for (int count = 0; count <= 70; count++) {
+                uint32_t pixels[80];
+                for (uint32_t& pixel : pixels) pixel = 0xDEADBEEF;
+
+                uint32_t color = 0x11223344u + count;
+                kernels.raster.fillPixels(pixels + offset, count, color);
+                for (int i = 0; i < 80; i++) {
+                    bool inside = (i >= offset && i < offset + count);
+                    ASSERT(pixels[i] == (inside ? color : 0xDEADBEEF));
+                }
+            }
+        }
+    }
+}
+
+TEST(altitude_rows)
+{
+    for (CpuLevel level : runnableLevels()) {
+        const CpuKernels& kernels = CpuDispatch::getKernels(level);
+        for (int round = 0; round < 2000; round++) {
+            // Every fifth row starts by the launchpad
+            int32_t x = static_cast<int32_t>(nextRandom());
+            int32_t z = static_cast<int32_t>(nextRandom());
+            if (round % 5 == 0) {
+                x = static_cast<int32_t>(nextRandom() % (24 << 24)) - (12 << 24);
+                z = static_cast<int32_t>(nextRandom() % (12 << 24)) - (2 << 24);
+            }
+            int count = 1 + static_cast<int>(nextRandom() % 40);
+
+            int32_t altitudes[40];
+            kernels.landscape.altitudeRow(x, z, count, altitudes);
+            for (int i = 0; i < count; i++) {
+                Fixed cornerX = Fixed::fromRaw(static_cast<int32_t>(
+                    static_cast<uint32_t>(x) + static_cast<uint32_t>(i) * static_cast<uint32_t>(GameConstants::TILE_SIZE.raw)));
+                ASSERT(altitudes[i] == getLandscapeAltitude(cornerX, Fixed::fromRaw(z)).raw);
+            }
+        }
+    }
+}
+
+TEST(mix_scaled)
+{
+    const float volumes[] = {0.0f, 0.05f, 0.3f, 0.75f, 1.0f, 1.7f, 3.0f};
+    const CpuKernels& reference = CpuDispatch::getKernels(CpuLevel::Scalar);
+
+    for (CpuLevel level : runnableLevels()) {
+        const CpuKernels& kernels = CpuDispatch::getKernels(level);
+        for (float volume : volumes) {
+            for (int count = 0; count <= 70; count += 3) {
+                int16_t src[70], expected[70], mixed[70];
+                for (int i = 0; i < count; i++) {
+                    // Include full-scale samples, so the clamp is tested
+                    src[i] = (i % 7 == 0) ? (i % 2 ? 32767 : -32768) : static_cast<int16_t>(nextRandom());
+                    expected[i] = mixed[i] = static_cast<int16_t>(nextRandom());
+                }
+                reference.audio.mixScaled(expected, src, count, volume);
+                kernels.audio.mixScaled(mixed, src, count, volume);
+                ASSERT(std::memcmp(expected, mixed, count * sizeof(int16_t)) == 0);
+            }
+        }
+    }
+
+    // The reference itself
+    int16_t dest[3] = {30000, -30000, 100};
+    int16_t src[3] = {10000, -10000, 51};
+    reference.audio.mixScaled(dest, src, 3, 0.5f);
+    ASSERT(dest[0] == 32767 && dest[1] == -32768 && dest[2] == 125);
+}
+
+// =============================================================================
+// Main
+// =============================================================================
+
+int main()
+{
+    std::printf("CPU Dispatch Tests\n");
+    std::printf("==================\n\n");
+
+    std::printf("Detected: %s, checking:", CpuDispatch::getLevelName(CpuDispatch::detect()));
+    for (CpuLevel level : runnableLevels()) {
+        std::printf(" %s", CpuDispatch::getLevelName(level));
+    }
+    std::printf("\n\n");
+
+    RUN_TEST(selection);
+    RUN_TEST(level_names);
+    RUN_TEST(fill_pixels);
+    RUN_TEST(altitude_rows);
+    RUN_TEST(mix_scaled);
+
+    std::printf("\n==================\n");
+    std::printf("Tests: %d total, %d passed, %d failed\n",
+                testsRun, testsPassed, testsFailed);
+
+    return testsFailed > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,236 @@
+// test_fixed_simd.cpp
+// Test the packed fixed-point kernels give exactly the scalar results
+
+#include "fixed_simd.h"
+#include "math3d.h"
+#include "projection.h"
+#include "landscape.h"
+#include <cstdint>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+
+// =============================================================================
+// Simple Test Framework
+// =============================================================================
+
+static int testsRun = 0;
+static int testsPassed = 0;
+static int testsFailed = 0;
+
+#define TEST(name) void test_##name()
+#define RUN_TEST(name) do { \
+    std::printf("  %s... ", #name); \
+    std::fflush(stdout); \
+    testsRun++; \
+    int failedBefore = testsFailed; \
+    test_##name(); \
+    if (testsFailed == failedBefore) { \
+        testsPassed++; \
+        std::printf("PASSED\n"); \
+    } \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        std::printf("FAILED\n    Assertion failed: %s\n    at %s:%d\n", \
+                    #cond, __FILE__, __LINE__); \
+        testsFailed++; \
+        return; \
+    } \
+} while(0)
+
+// =============================================================================
+// Helpers
+// =============================================================================
+
+// Small deterministic generator, so failures can be reproduced
+static uint32_t randomState = 0x12345678;
+
+static int32_t randomRaw()
+{
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return static_cast<int32_t>(randomState);
+}
+
+// Values around the edges of the 8.24 range and of the multiply
+static const int32_t edgeValues[] = {
+    0, 1, -1, 2, -2, 0x00FFFFFF, 0x01000000, -0x01000000, 0x00800000,
+    0x7FFFFFFF, INT32_MIN, INT32_MIN + 1, 0x7FFFFF00, 0x40000000, -0x40000000,
+    0x12345678, -0x12345678, 0x00010000, 0x0000FFFF
+};
+static const int EDGE_COUNT = sizeof(edgeValues) / sizeof(edgeValues[0]);
+
+// Pairs of operands: every pair of edge values, then random ones
+static void makeOperands(std::vector<int32_t>& a, std::vector<int32_t>& b)
+{
+    for (int i = 0; i < EDGE_COUNT; i++) {
+        for (int j = 0; j < EDGE_COUNT; j++) {
+            a.push_back(edgeValues[i]);
+            b.push_back(edgeValues[j]);
+        }
+    }
+    for (int i = 0; i < 20000; i++) {
+        a.push_back(randomRaw());
+        b.push_back(randomRaw() >> (i % 24));
+    }
+    while (a.size() % FixedX8::LANES != 0) {
+        a.push_back(randomRaw());
+        b.push_back(randomRaw());
+    }
+}
+
+// =============================================================================
+// Tests
+// =============================================================================
+
+TEST(arithmetic)
+{
+    std::vector<int32_t> a, b;
+    makeOperands(a, b);
+
+    for (size_t i = 0; i < a.size(); i += FixedX8::LANES) {
+        FixedX8 x = FixedX8::load(&a[i]);
+        FixedX8 y = FixedX8::load(&b[i]);
+        for (int lane = 0; lane < FixedX8::LANES; lane++) {
+            Fixed fa = Fixed::fromRaw(a[i + lane]);
+            Fixed fb = Fixed::fromRaw(b[i + lane]);
+            uint32_t ua = static_cast<uint32_t>(a[i + lane]);
+            uint32_t ub = static_cast<uint32_t>(b[i + lane]);
+            ASSERT((x * y).lane(lane) == (fa * fb).raw);
+            ASSERT((x + y).lane(lane) == static_cast<int32_t>(ua + ub));
+            ASSERT((x - y).lane(lane) == static_cast<int32_t>(ua - ub));
+            ASSERT(FixedX8::mulInt(x, y).lane(lane) == static_cast<int32_t>(ua * ub));
+            ASSERT((x >> 7).lane(lane) == (a[i + lane] >> 7));
+            ASSERT(FixedX8::min(x, y).lane(lane) == (a[i + lane] < b[i + lane] ? a[i + lane] : b[i + lane]));
+            ASSERT(FixedX8::max(x, y).lane(lane) == (a[i + lane] > b[i + lane] ? a[i + lane] : b[i + lane]));
+            ASSERT(FixedX8::cmpGt(x, y).lane(lane) == (a[i + lane] > b[i + lane] ? -1 : 0));
+        }
+
+        // The 4-lane type agrees with its own lanes
+        FixedX4 x4 = FixedX4::load(&a[i]);
+        FixedX4 y4 = FixedX4::load(&b[i]);
+        for (int lane = 0; lane < FixedX4::LANES; lane++) {
+            ASSERT((x4 * y4).lane(lane) == (x * y).lane(lane));
+            ASSERT(FixedX4::mulInt(x4, y4).lane(lane) == FixedX8::mulInt(x, y).lane(lane));
+        }
+    }
+}
+
+TEST(division)
+{
+    std::vector<int32_t> a, b;
+    makeOperands(a, b);
+    for (int32_t& divisor : b) {
+        if (divisor == 0) divisor = 1;
+    }
+
+    for (int shift : {0, 8, 16, 21}) {
+        for (size_t i = 0; i < a.size(); i += FixedX8::LANES) {
+            FixedX8 q = FixedX8::divShifted(FixedX8::load(&a[i]), FixedX8::load(&b[i]), shift);
+            FixedX4 q4 = FixedX4::divShifted(FixedX4::load(&a[i]), FixedX4::load(&b[i]), shift);
+            for (int lane = 0; lane < FixedX8::LANES; lane++) {
+                int32_t expected = static_cast<int32_t>(
+                    (static_cast<int64_t>(a[i + lane]) * (int64_t(1) << shift)) / b[i + lane]);
+                ASSERT(q.lane(lane) == expected);
+                if (lane < FixedX4::LANES) ASSERT(q4.lane(lane) == expected);
+            }
+        }
+    }
+}
+
+TEST(transform_points)
+{
+    Mat3x3 m = calculateRotationMatrix(0x1234567, -0x2345678);
+    Vec3 points[23];
+    for (Vec3& p : points) {
+        p = Vec3(Fixed::fromRaw(randomRaw() >> 4), Fixed::fromRaw(randomRaw() >> 4), Fixed::fromRaw(randomRaw() >> 4));
+    }
+
+    // Every count, including short last packs
+    for (int count = 0; count <= 23; count++) {
+        Vec3 out[23];
+        transformPoints(m, points, out, count);
+        for (int i = 0; i < count; i++) {
+            Vec3 expected = m * points[i];
+            ASSERT(out[i].x == expected.x && out[i].y == expected.y && out[i].z == expected.z);
+        }
+    }
+
+    // In place
+    Vec3 copy[23];
+    for (int i = 0; i < 23; i++) copy[i] = points[i];
+    transformPoints(m, copy, copy, 23);
+    for (int i = 0; i < 23; i++) {
+        ASSERT(copy[i].x == (m * points[i]).x);
+    }
+}
+
+TEST(altitude_rows)
+{
+    const int COUNT = 19;
+    Fixed row[COUNT];
+
+    // Across the launchpad, the sea, and the wrap at the edge of the world
+    for (int z = -12; z < 256; z += 3) {
+        for (int x = -10; x < 256; x += 37) {
+            Fixed startX = Fixed::fromInt(x);
+            Fixed worldZ = Fixed::fromRaw(static_cast<int32_t>(static_cast<uint32_t>(z) << 24) + (z & 0xFFFF));
+            getLandscapeAltitudeRow(startX, worldZ, COUNT, row);
+            for (int i = 0; i < COUNT; i++) {
+                Fixed worldX = Fixed::fromRaw(static_cast<int32_t>(
+                    static_cast<uint32_t>(startX.raw) + static_cast<uint32_t>(i) * 0x01000000u));
+                ASSERT(row[i] == getLandscapeAltitude(worldX, worldZ));
+            }
+        }
+    }
+}
+
+TEST(project_vertices)
+{
+    std::vector<Vec3> points;
+    for (int i = 0; i < 2000; i++) {
+        int shift = 2 + i % 8;
+        points.push_back(Vec3(Fixed::fromRaw(randomRaw() >> shift), Fixed::fromRaw(randomRaw() >> shift),
+                              Fixed::fromRaw(randomRaw() >> (shift + i % 3))));
+    }
+    points.push_back(Vec3(Fixed::fromInt(1), Fixed::fromInt(1), Fixed::fromRaw(0)));
+    points.push_back(Vec3(Fixed::fromRaw(INT32_MIN), Fixed::fromRaw(0x7FFFFFFF), Fixed::fromRaw(1)));
+
+    std::vector<ProjectedVertex> results(points.size());
+    projectVertices(points.data(), static_cast<int>(points.size()), results.data());
+    for (size_t i = 0; i < points.size(); i++) {
+        ProjectedVertex expected = projectVertex(points[i]);
+        ASSERT(results[i].visible == expected.visible);
+        if (expected.visible) {
+            ASSERT(results[i].screenX == expected.screenX);
+            ASSERT(results[i].screenY == expected.screenY);
+            ASSERT(results[i].onScreen == expected.onScreen);
+        }
+    }
+}
+
+// =============================================================================
+// Main
+// =============================================================================
+
+int main()
+{
+    std::printf("Packed Fixed-Point Tests\n");
+    std::printf("========================\n\n");
+    std::printf("Backend: %s\n\n", FixedSimd::backendName());
+
+    RUN_TEST(arithmetic);
+    RUN_TEST(division);
+    RUN_TEST(transform_points);
+    RUN_TEST(altitude_rows);
+    RUN_TEST(project_vertices);
+
+    std::printf("\n========================\n");
+    std::printf("Tests: %d total, %d passed, %d failed\n",
+                testsRun, testsPassed, testsFailed);
+
+    return testsFailed > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
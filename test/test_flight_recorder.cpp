@@ -0,0 +1,207 @@
+// test_flight_recorder.cpp
+// Test the slow-frame flight recorder
+
+#include "flight_recorder.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+// =============================================================================
+// Simple Test Framework
+// =============================================================================
+
+static int testsRun = 0;
+static int testsPassed = 0;
+static int testsFailed = 0;
+
+#define TEST(name) void test_##name()
+#define RUN_TEST(name) do { \
+    std::printf("  %s... ", #name); \
+    std::fflush(stdout); \
+    testsRun++; \
+    int failedBefore = testsFailed; \
+    test_##name(); \
+    if (testsFailed == failedBefore) { \
+        testsPassed++; \
+        std::printf("PASSED\n"); \
+    } \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        std::printf("FAILED\n    Assertion failed: %s\n    at %s:%d\n", \
+                    #cond, __FILE__, __LINE__); \
+        testsFailed++; \
+        return; \
+    } \
+} while(0)
+
+// =============================================================================
+// Helpers
+// =============================================================================
+
+static const char* PREFIX = "test_flight_recorder";
+
+static std::string dumpPath(uint64_t frame, const char* extension)
+{
+    return std::string(PREFIX) + "-" + std::to_string(frame) + extension;
+}
+
+// Lines of a file, or -1 if it doesn't exist
+static int countLines(const std::string& path, std::string* lastLine = nullptr)
+{
+    FILE* file = std::fopen(path.c_str(), "r");
+    if (!file) return -1;
+    int lines = 0;
+    char line[4096];
+    while (std::fgets(line, sizeof(line), file)) {
+        lines++;
+        if (lastLine) *lastLine = line;
+    }
+    std::fclose(file);
+    return lines;
+}
+
+static FlightFrame makeFrame(uint64_t number, uint32_t micros)
+{
+    FlightFrame frame;
+    frame.frame = number;
+    frame.frameMicros = micros;
+    frame.stageMicros[static_cast<int>(TelemetryStage::Scene)] = micros / 2;
+    frame.camera = Vec3(Fixed::fromInt(3), Fixed::fromInt(-2), Fixed::fromInt(7));
+    frame.audioVoices = 4;
+    frame.stats.tilesDrawn = static_cast<int>(number % 100);
+    return frame;
+}
+
+// =============================================================================
+// Tests
+// =============================================================================
+
+TEST(write_frames)
+{
+    FlightFrame frames[3] = {makeFrame(10, 1000), makeFrame(11, 9000), makeFrame(12, 30000)};
+    std::string path = std::string(PREFIX) + "-format.csv";
+    FILE* file = std::fopen(path.c_str(), "w");
+    ASSERT(file);
+    FlightRecorder::writeFrames(file, frames, 3, 20000);
+    std::fclose(file);
+
+    // Summary, column names, then the frames oldest first
+    std::string last;
+    int lines = countLines(path, &last);
+    ASSERT(lines == 5);
+    ASSERT(last.compare(0, 29, "30000,0,15000,0,1,3.0000,-2.0") == 0);
+
+    char summary[4096] = {};
+    char columns[4096] = {};
+    char first[4096] = {};
+    file = std::fopen(path.c_str(), "r");
+    ASSERT(file);
+    bool read = std::fgets(summary, sizeof(summary), file) &&
+                std::fgets(columns, sizeof(columns), file) &&
+                std::fgets(first, sizeof(first), file);
+    std::fclose(file);
+    std::remove(path.c_str());
+
+    ASSERT(read);
+    ASSERT(std::strncmp(summary, "# frame 12 took 30.00 ms (budget 20.00 ms)", 42) == 0);
+    ASSERT(std::strncmp(columns, "frame_us,update_us,scene_us,present_us,over_budget,", 51) == 0);
+    ASSERT(std::strncmp(first, "1000,0,500,0,0,", 15) == 0);
+}
+
+TEST(dumps)
+{
+    FlightRecorder recorder;
+    ASSERT(!recorder.isOpen());
+    bool opened = recorder.open(PREFIX, 20000, false);
+    ASSERT(opened);
+    ASSERT(recorder.isOpen());
+
+    // Frames within budget are only recorded
+    uint64_t frame = 0;
+    for (; frame < 50; frame++) {
+        bool dumped = recorder.record(makeFrame(frame, 20000), nullptr);
+        ASSERT(!dumped);
+    }
+
+    // The first slow frame dumps what there is
+    bool dumped = recorder.record(makeFrame(frame, 45000), nullptr);
+    ASSERT(dumped);
+    recorder.flush();
+    ASSERT(recorder.getDumpsWritten() == 1);
+    std::string last;
+    int lines = countLines(dumpPath(frame, ".csv"), &last);
+    std::remove(dumpPath(frame, ".csv").c_str());
+    ASSERT(lines == 2 + 51);
+    ASSERT(last.compare(0, 6, "45000,") == 0);
+    uint64_t firstDump = frame++;
+
+    // Slow frames in the next HISTORY are counted, but not dumped
+    uint64_t slow = 0;
+    for (; frame < firstDump + FlightRecorder::HISTORY; frame++) {
+        bool isSlow = frame % 10 == 0;
+        dumped = recorder.record(makeFrame(frame, isSlow ? 30000 : 100), nullptr);
+        ASSERT(!dumped);
+        if (isSlow) slow++;
+    }
+    ASSERT(slow > 0 && recorder.getDumpsSkipped() == slow);
+    ASSERT(recorder.getSlowFrames() == 1 + slow);
+
+    // After that the whole ring is dumped
+    dumped = recorder.record(makeFrame(frame, 30000), nullptr);
+    ASSERT(dumped);
+    recorder.close();
+    ASSERT(!recorder.isOpen());
+    ASSERT(recorder.getDumpsWritten() == 2);
+    lines = countLines(dumpPath(frame, ".csv"));
+    std::remove(dumpPath(frame, ".csv").c_str());
+    ASSERT(lines == 2 + FlightRecorder::HISTORY);
+}
+
+TEST(screenshots)
+{
+    static ScreenBuffer screen;
+    screen.clear(Color{0x20, 0x40, 0x60, 0xFF});
+
+    FlightRecorder recorder;
+    bool opened = recorder.open(PREFIX, 10000, true);
+    ASSERT(opened);
+    bool dumped = recorder.record(makeFrame(7, 10001), &screen);
+    ASSERT(dumped);
+    recorder.close();
+
+    unsigned char signature[8] = {};
+    size_t read = 0;
+    FILE* png = std::fopen(dumpPath(7, ".png").c_str(), "rb");
+    if (png) {
+        read = std::fread(signature, 1, 8, png);
+        std::fclose(png);
+    }
+    std::remove(dumpPath(7, ".csv").c_str());
+    std::remove(dumpPath(7, ".png").c_str());
+
+    ASSERT(read == 8);
+    ASSERT(signature[1] == 'P' && signature[2] == 'N' && signature[3] == 'G');
+}
+
+// =============================================================================
+// Main
+// =============================================================================
+
+int main()
+{
+    std::printf("Flight Recorder Tests\n");
+    std::printf("=====================\n\n");
+
+    RUN_TEST(write_frames);
+    RUN_TEST(dumps);
+    RUN_TEST(screenshots);
+
+    std::printf("\n=====================\n");
+    std::printf("Tests: %d total, %d passed, %d failed\n",
+                testsRun, testsPassed, testsFailed);
+
+    return testsFailed > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
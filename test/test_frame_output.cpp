@@ -0,0 +1,211 @@
+// test_frame_output.cpp
+// Test the shared-memory frame ring and its consumer protocol
+
+#include "frame_output.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <unistd.h>
+
+// =============================================================================
+// Simple Test Framework
+// =============================================================================
+
+static int testsRun = 0;
+static int testsPassed = 0;
+static int testsFailed = 0;
+
+#define TEST(name) void test_##name()
+#define RUN_TEST(name) do { \
+    std::printf("  %s... ", #name); \
+    std::fflush(stdout); \
+    testsRun++; \
+    int failedBefore = testsFailed; \
+    test_##name(); \
+    if (testsFailed == failedBefore) { \
+        testsPassed++; \
+        std::printf("PASSED\n"); \
+    } \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        std::printf("FAILED\n    Assertion failed: %s\n    at %s:%d\n", \
+                    #cond, __FILE__, __LINE__); \
+        testsFailed++; \
+        return; \
+    } \
+} while(0)
+
+// =============================================================================
+// Helpers
+// =============================================================================
+
+static const int MAX_WIDTH = 64;
+static const int MAX_HEIGHT = 32;
+
+static char ringName[64];
+
+// Fill the visible part of a frame with a pattern based on its number
+static void drawFrame(uint8_t* pixels, int width, int height, int frame)
+{
+    for (int y = 0; y < height; y++) {
+        uint8_t* row = pixels + y * MAX_WIDTH * 4;
+        for (int x = 0; x < width; x++) {
+            row[x * 4 + 0] = static_cast<uint8_t>(x + frame);
+            row[x * 4 + 1] = static_cast<uint8_t>(y);
+            row[x * 4 + 2] = static_cast<uint8_t>(frame);
+            row[x * 4 + 3] = 255;
+        }
+    }
+}
+
+static void publishFrame(FrameOutput& output, int width, int height, int frame)
+{
+    drawFrame(output.beginFrame(), width, height, frame);
+    output.publish(width, height);
+}
+
+// =============================================================================
+// Tests
+// =============================================================================
+
+TEST(open_and_layout)
+{
+    FrameOutput output;
+    bool outputOpen = output.open(ringName, MAX_WIDTH, MAX_HEIGHT);
+    ASSERT(outputOpen);
+
+    FrameReader reader;
+    bool readerOpen = reader.open(ringName);
+    ASSERT(readerOpen);
+    ASSERT(reader.getLatestFrame() == 0);
+
+    // Nothing published yet
+    FrameView view;
+    bool read = reader.readLatest(view);
+    ASSERT(!read);
+
+    // Readers refuse rings that don't exist
+    FrameReader missing;
+    bool missingOpen = missing.open("/lander_test_missing_ring");
+    ASSERT(!missingOpen);
+}
+
+TEST(publish_and_read)
+{
+    FrameOutput output;
+    bool outputOpen = output.open(ringName, MAX_WIDTH, MAX_HEIGHT);
+    ASSERT(outputOpen);
+    FrameReader reader;
+    bool readerOpen = reader.open(ringName);
+    ASSERT(readerOpen);
+
+    publishFrame(output, 40, 20, 1);
+    ASSERT(reader.getLatestFrame() == 1);
+
+    FrameView view;
+    bool read = reader.readLatest(view);
+    ASSERT(read);
+    ASSERT(view.width == 40);
+    ASSERT(view.height == 20);
+    ASSERT(view.pitch == MAX_WIDTH * 4);
+    ASSERT(view.format == FrameOutputLayout::FORMAT_RGBA32);
+    ASSERT(view.frameNumber == 1);
+    ASSERT(view.timestampNs > 0);
+    ASSERT(view.pixels[0] == 1 && view.pixels[2] == 1);
+    ASSERT(view.pixels[(19 * MAX_WIDTH + 39) * 4 + 1] == 19);
+    ASSERT(reader.isValid(view));
+
+    // The latest frame replaces the previous one
+    publishFrame(output, MAX_WIDTH, MAX_HEIGHT, 2);
+    read = reader.readLatest(view);
+    ASSERT(read);
+    ASSERT(view.frameNumber == 2);
+    ASSERT(view.width == MAX_WIDTH);
+    ASSERT(view.pixels[2] == 2);
+}
+
+TEST(slow_consumer)
+{
+    FrameOutput output;
+    bool outputOpen = output.open(ringName, MAX_WIDTH, MAX_HEIGHT);
+    ASSERT(outputOpen);
+    FrameReader reader;
+    bool readerOpen = reader.open(ringName);
+    ASSERT(readerOpen);
+
+    publishFrame(output, MAX_WIDTH, MAX_HEIGHT, 1);
+    FrameView view;
+    bool read = reader.readLatest(view);
+    ASSERT(read);
+
+    // The frame stays intact while the game fills the other slots...
+    for (int frame = 2; frame < 1 + FrameOutputLayout::SLOT_COUNT; frame++) {
+        publishFrame(output, MAX_WIDTH, MAX_HEIGHT, frame);
+        ASSERT(reader.isValid(view));
+    }
+
+    // ...and is invalidated as soon as the game starts reusing its slot
+    output.beginFrame();
+    ASSERT(!reader.isValid(view));
+    output.publish(MAX_WIDTH, MAX_HEIGHT);
+
+    // The game never waited: every frame was published
+    ASSERT(output.getFramesPublished() == 1 + FrameOutputLayout::SLOT_COUNT);
+    read = reader.readLatest(view);
+    ASSERT(read);
+    ASSERT(view.frameNumber == output.getFramesPublished());
+}
+
+TEST(wait_for_frame)
+{
+    FrameOutput output;
+    bool outputOpen = output.open(ringName, MAX_WIDTH, MAX_HEIGHT);
+    ASSERT(outputOpen);
+    FrameReader reader;
+    bool readerOpen = reader.open(ringName);
+    ASSERT(readerOpen);
+
+    // Times out when nothing is published
+    uint32_t seen = reader.getLatestFrame();
+    bool arrived = reader.waitForFrame(seen, 10);
+    ASSERT(!arrived);
+
+    // Wakes when a frame arrives
+    bool woke = false;
+    std::thread consumer([&reader, &woke, seen] {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (!woke && std::chrono::steady_clock::now() < deadline) {
+            woke = reader.waitForFrame(seen, 100);
+        }
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    publishFrame(output, MAX_WIDTH, MAX_HEIGHT, 1);
+    consumer.join();
+    ASSERT(woke);
+
+    // Already newer: returns straight away
+    arrived = reader.waitForFrame(seen, 0);
+    ASSERT(arrived);
+}
+
+int main()
+{
+    std::printf("Frame Output Tests\n");
+    std::printf("==================\n\n");
+
+    std::snprintf(ringName, sizeof(ringName), "/lander_test_%d", static_cast<int>(getpid()));
+
+    RUN_TEST(open_and_layout);
+    RUN_TEST(publish_and_read);
+    RUN_TEST(slow_consumer);
+    RUN_TEST(wait_for_frame);
+
+    std::printf("\n==================\n");
+    std::printf("Tests: %d total, %d passed, %d failed\n",
+                testsRun, testsPassed, testsFailed);
+
+    return testsFailed > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -3,40 +3,100 @@
 
 #include "graphics_buffer.h"
 #include "screen.h"
-#include <iostream>
-#include <cassert>
+#include "frame_stats.h"
+#include <cstdio>
+#include <cstdlib>
+
+// =============================================================================
+// Simple Test Framework
+// =============================================================================
+
+static int testsRun = 0;
+static int testsPassed = 0;
+static int testsFailed = 0;
+
+#define TEST(name) void test_##name()
+#define RUN_TEST(name) do { \
+    std::printf("  %s... ", #name); \
+    std::fflush(stdout); \
+    testsRun++; \
+    int failedBefore = testsFailed; \
+    test_##name(); \
+    if (testsFailed == failedBefore) { \
+        testsPassed++; \
+        std::printf("PASSED\n"); \
+    } \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        std::printf("FAILED\n    Assertion failed: %s\n    at %s:%d\n", \
+                    #cond, __FILE__, __LINE__); \
+        testsFailed++; \
+        return; \
+    } \
+} while(0)
+
+// =============================================================================
+// Helpers
+// =============================================================================
+
+// Small deterministic generator, so failures can be reproduced
+static uint32_t randomState = 0x2468ACE1;
+
+static int randomInt(int low, int high)
+{
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return low + static_cast<int>(randomState % static_cast<uint32_t>(high - low + 1));
+}
 
-void testRowBufferBasics()
+// Whether two screens have the same physical pixels
+static bool screensMatch(const ScreenBuffer& a, const ScreenBuffer& b)
 {
-    std::cout << "Testing RowBuffer basics..." << std::endl;
+    for (int y = 0; y < ScreenBuffer::PHYSICAL_HEIGHT(); y++) {
+        for (int x = 0; x < ScreenBuffer::PHYSICAL_WIDTH(); x++) {
+            Color pixelA = a.getPhysicalPixel(x, y);
+            Color pixelB = b.getPhysicalPixel(x, y);
+            if (pixelA.r != pixelB.r || pixelA.g != pixelB.g ||
+                pixelA.b != pixelB.b || pixelA.a != pixelB.a) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// =============================================================================
+// Tests
+// =============================================================================
 
+TEST(row_buffer_basics)
+{
     RowBuffer buffer;
 
     // Initially empty
-    assert(buffer.isEmpty());
-    assert(buffer.getTriangleCount() == 0);
+    ASSERT(buffer.isEmpty());
+    ASSERT(buffer.getTriangleCount() == 0);
 
     // Add a triangle
     buffer.addTriangle(10, 20, 30, 40, 50, 60, Color{0xFF, 0x00, 0x00, 0xFF});
-    assert(!buffer.isEmpty());
-    assert(buffer.getTriangleCount() == 1);
+    ASSERT(!buffer.isEmpty());
+    ASSERT(buffer.getTriangleCount() == 1);
 
     // Add another triangle
     buffer.addTriangle(100, 110, 120, 130, 140, 150, Color{0x00, 0xFF, 0x00, 0xFF});
-    assert(buffer.getTriangleCount() == 2);
+    ASSERT(buffer.getTriangleCount() == 2);
 
     // Clear the buffer
     buffer.clear();
-    assert(buffer.isEmpty());
-    assert(buffer.getTriangleCount() == 0);
-
-    std::cout << "  PASS" << std::endl;
+    ASSERT(buffer.isEmpty());
+    ASSERT(buffer.getTriangleCount() == 0);
 }
 
-void testRowBufferDraw()
+TEST(row_buffer_draw)
 {
-    std::cout << "Testing RowBuffer draw..." << std::endl;
-
     RowBuffer buffer;
     ScreenBuffer screen;
 
@@ -48,42 +108,34 @@ void testRowBufferDraw()
     buffer.draw(screen);
 
     // Verify buffer still has triangles after draw (draw doesn't clear)
-    assert(buffer.getTriangleCount() == 2);
-
-    std::cout << "  PASS" << std::endl;
+    ASSERT(buffer.getTriangleCount() == 2);
 }
 
-void testGraphicsBufferSystemBasics()
+TEST(graphics_buffer_system_basics)
 {
-    std::cout << "Testing GraphicsBufferSystem basics..." << std::endl;
-
     GraphicsBufferSystem system;
 
     // Clear all buffers
     system.clearAll();
-    assert(system.getTotalTriangleCount() == 0);
+    ASSERT(system.getTotalTriangleCount() == 0);
 
     // Add triangles to different rows
     system.addTriangle(0, 10, 20, 30, 40, 50, 60, Color{0xFF, 0x00, 0x00, 0xFF});
     system.addTriangle(5, 100, 110, 120, 130, 140, 150, Color{0x00, 0xFF, 0x00, 0xFF});
     system.addTriangle(10, 200, 210, 220, 230, 240, 250, Color{0x00, 0x00, 0xFF, 0xFF});
 
-    assert(system.getTriangleCount(0) == 1);
-    assert(system.getTriangleCount(5) == 1);
-    assert(system.getTriangleCount(10) == 1);
-    assert(system.getTotalTriangleCount() == 3);
+    ASSERT(system.getTriangleCount(0) == 1);
+    ASSERT(system.getTriangleCount(5) == 1);
+    ASSERT(system.getTriangleCount(10) == 1);
+    ASSERT(system.getTotalTriangleCount() == 3);
 
     // Clear all
     system.clearAll();
-    assert(system.getTotalTriangleCount() == 0);
-
-    std::cout << "  PASS" << std::endl;
+    ASSERT(system.getTotalTriangleCount() == 0);
 }
 
-void testGraphicsBufferSystemDrawAndClear()
+TEST(graphics_buffer_system_draw_and_clear)
 {
-    std::cout << "Testing GraphicsBufferSystem drawAndClearRow..." << std::endl;
-
     GraphicsBufferSystem system;
     ScreenBuffer screen;
 
@@ -91,25 +143,21 @@ void testGraphicsBufferSystemDrawAndClear()
     system.addTriangle(0, 100, 100, 150, 50, 200, 100, Color{0xFF, 0x00, 0x00, 0xFF});
     system.addTriangle(5, 100, 150, 150, 100, 200, 150, Color{0x00, 0xFF, 0x00, 0xFF});
 
-    assert(system.getTriangleCount(0) == 1);
-    assert(system.getTriangleCount(5) == 1);
+    ASSERT(system.getTriangleCount(0) == 1);
+    ASSERT(system.getTriangleCount(5) == 1);
 
     // Draw and clear row 0
     system.drawAndClearRow(0, screen);
-    assert(system.getTriangleCount(0) == 0);
-    assert(system.getTriangleCount(5) == 1);  // Row 5 still has its triangle
+    ASSERT(system.getTriangleCount(0) == 0);
+    ASSERT(system.getTriangleCount(5) == 1);  // Row 5 still has its triangle
 
     // Draw and clear row 5
     system.drawAndClearRow(5, screen);
-    assert(system.getTriangleCount(5) == 0);
-
-    std::cout << "  PASS" << std::endl;
+    ASSERT(system.getTriangleCount(5) == 0);
 }
 
-void testInvalidRowHandling()
+TEST(invalid_row_handling)
 {
-    std::cout << "Testing invalid row handling..." << std::endl;
-
     GraphicsBufferSystem system;
     ScreenBuffer screen;
 
@@ -119,33 +167,25 @@ void testInvalidRowHandling()
     system.drawAndClearRow(-1, screen);
     system.drawAndClearRow(100, screen);
 
-    assert(system.getTriangleCount(-1) == 0);
-    assert(system.getTriangleCount(100) == 0);
-
-    std::cout << "  PASS" << std::endl;
+    ASSERT(system.getTriangleCount(-1) == 0);
+    ASSERT(system.getTriangleCount(100) == 0);
 }
 
-void testGlobalInstance()
+TEST(global_instance)
 {
-    std::cout << "Testing global graphicsBuffers instance..." << std::endl;
-
     // The global instance should be accessible
     graphicsBuffers.clearAll();
-    assert(graphicsBuffers.getTotalTriangleCount() == 0);
+    ASSERT(graphicsBuffers.getTotalTriangleCount() == 0);
 
     graphicsBuffers.addTriangle(3, 50, 50, 100, 100, 150, 50, Color{0xFF, 0xFF, 0x00, 0xFF});
-    assert(graphicsBuffers.getTriangleCount(3) == 1);
+    ASSERT(graphicsBuffers.getTriangleCount(3) == 1);
 
     graphicsBuffers.clearAll();
-    assert(graphicsBuffers.getTotalTriangleCount() == 0);
-
-    std::cout << "  PASS" << std::endl;
+    ASSERT(graphicsBuffers.getTotalTriangleCount() == 0);
 }
 
-void testMultipleTrianglesPerRow()
+TEST(multiple_triangles_per_row)
 {
-    std::cout << "Testing multiple triangles per row..." << std::endl;
-
     GraphicsBufferSystem system;
 
     // Add many triangles to the same row
@@ -154,28 +194,165 @@ void testMultipleTrianglesPerRow()
                           Color{static_cast<uint8_t>(i*5), 0, 0, 0xFF});
     }
 
-    assert(system.getTriangleCount(2) == 50);
+    ASSERT(system.getTriangleCount(2) == 50);
 
     system.clearAll();
-    assert(system.getTriangleCount(2) == 0);
+    ASSERT(system.getTriangleCount(2) == 0);
+}
 
-    std::cout << "  PASS" << std::endl;
+TEST(frame_stats_counters)
+{
+    GraphicsBufferSystem system;
+    ScreenBuffer screen;
+    frameStats.reset();
+
+    // Fill row 4 past capacity (512 per row): the overflow is counted as dropped
+    constexpr int CAPACITY = 512;
+    int submitted = CAPACITY + 10;
+    for (int i = 0; i < submitted; i++) {
+        system.addTriangle(4, 10, 10, 20, 10, 10, 20, Color{0xFF, 0x00, 0x00, 0xFF});
+    }
+    system.addShadowTriangle(7, 10, 10, 20, 10, 10, 20, Color{0x00, 0x00, 0x00, 0xFF});
+
+    ASSERT(frameStats.rowTriangles[4] == submitted);
+    ASSERT(frameStats.rowTriangles[7] == 1);
+    ASSERT(frameStats.getBusiestRow() == 4);
+    ASSERT(frameStats.trianglesBuffered == CAPACITY + 1);
+    ASSERT(frameStats.trianglesDropped == 10);
+
+    // Drawing the row counts the triangles that reached the rasterizer
+    system.drawAndClearRow(7, screen);
+    ASSERT(frameStats.trianglesDrawn == 1);
+    ASSERT(frameStats.pixelsFilled > 0);
+
+    frameStats.reset();
+    ASSERT(frameStats.trianglesBuffered == 0);
+    ASSERT(frameStats.rowTriangles[4] == 0);
 }
 
-int main()
+TEST(off_screen_triangles)
 {
-    std::cout << "=== Graphics Buffer Tests ===" << std::endl;
+    GraphicsBufferSystem system;
+    frameStats.reset();
+
+    int width = ScreenBuffer::PHYSICAL_WIDTH();
+    int height = ScreenBuffer::PHYSICAL_HEIGHT();
+    Color red{0xFF, 0x00, 0x00, 0xFF};
+
+    // Wholly past each edge: skipped, even far enough out to wrap in 16 bits
+    system.addTriangle(1, -10, 10, -20, 50, -1, 30, red);
+    system.addTriangle(1, width, 10, width + 40000, 50, width + 5, 30, red);
+    system.addTriangle(1, 10, -1, 50, -40000, 30, -8, red);
+    system.addTriangle(1, 10, height, 50, height + 1, 30, height + 100, red);
+    ASSERT(system.getTriangleCount(1) == 0);
+    ASSERT(frameStats.trianglesOffScreen == 4);
+
+    // Crossing an edge, or spanning the screen with every vertex off it: kept
+    system.addTriangle(1, -10, 10, 20, 50, -1, 30, red);
+    system.addTriangle(1, -100, -100, width + 100, -100, width / 2, height + 100, red);
+    ASSERT(system.getTriangleCount(1) == 2);
+    ASSERT(frameStats.trianglesOffScreen == 4);
+    ASSERT(frameStats.trianglesBuffered == 2);
+}
 
-    testRowBufferBasics();
-    testRowBufferDraw();
-    testGraphicsBufferSystemBasics();
-    testGraphicsBufferSystemDrawAndClear();
-    testInvalidRowHandling();
-    testGlobalInstance();
-    testMultipleTrianglesPerRow();
+TEST(merged_shadows)
+{
+    int width = ScreenBuffer::PHYSICAL_WIDTH();
+    int height = ScreenBuffer::PHYSICAL_HEIGHT();
+    Color dark{0x10, 0x10, 0x10, 0xFF};
+    Color darker{0x08, 0x08, 0x08, 0xFF};
+
+    static ScreenBuffer merged;
+    static ScreenBuffer separate;
+
+    for (int round = 0; round < 200; round++) {
+        RowBuffer buffer;
+        merged.clear(Color{0x40, 0x80, 0x40, 0xFF});
+        separate.clear(Color{0x40, 0x80, 0x40, 0xFF});
+
+        // Overlapping clusters in two colours, some crossing the screen
+        // edges, some slivers and degenerate
+        int centreX = randomInt(-100, width + 100);
+        int centreY = randomInt(-100, height + 100);
+        int count = randomInt(1, 40);
+        for (int i = 0; i < count; i++) {
+            int spread = (i % 7 == 0) ? 2 : 200;
+            int v[6];
+            for (int j = 0; j < 6; j += 2) {
+                v[j] = centreX + randomInt(-spread, spread);
+                v[j + 1] = centreY + randomInt(-spread, spread);
+            }
+            if (i % 11 == 5) {
+                v[4] = v[2];
+                v[5] = v[3];
+            }
+            Color color = (i / 5) % 2 ? darker : dark;
+            buffer.addTriangle(v[0], v[1], v[2], v[3], v[4], v[5], color);
+            separate.drawTriangle(v[0], v[1], v[2], v[3], v[4], v[5], color);
+        }
+
+        frameStats.reset();
+        buffer.drawMerged(merged);
+        ASSERT(frameStats.trianglesDrawn == static_cast<int>(buffer.getTriangleCount()));
+        ASSERT(screensMatch(merged, separate));
+    }
+}
 
-    std::cout << std::endl;
-    std::cout << "All graphics buffer tests passed!" << std::endl;
+TEST(prefault)
+{
+    Color color{0x20, 0x20, 0x20, 0xFF};
+
+    // Prefaulting empties a buffer, which then works as before
+    RowBuffer buffer;
+    buffer.addTriangle(10, 10, 50, 10, 30, 40, color);
+    buffer.prefault();
+    ASSERT(buffer.isEmpty());
+    buffer.addTriangle(10, 10, 50, 10, 30, 40, color);
+    buffer.addTriangle(30, 20, 70, 20, 50, 60, color);
+    ASSERT(buffer.getTriangleCount() == 2);
 
-    return 0;
+    GraphicsBufferSystem system;
+    system.addTriangle(0, 10, 10, 50, 10, 30, 40, color);
+    system.addShadowTriangle(1, 10, 10, 50, 10, 30, 40, color);
+    system.prefault();
+    ASSERT(system.getTotalTriangleCount() == 0);
+
+    // A prefaulted screen draws merged shadows as any other
+    static ScreenBuffer prefaulted;
+    static ScreenBuffer plain;
+    prefaulted.prefault();
+    prefaulted.clear();
+    plain.clear();
+    buffer.drawMerged(prefaulted);
+    buffer.drawMerged(plain);
+    ASSERT(screensMatch(prefaulted, plain));
+    ASSERT(prefaulted.getPhysicalPixel(30, 15).r == color.r);
+}
+
+// =============================================================================
+// Main
+// =============================================================================
+
+int main()
+{
+    std::printf("Graphics Buffer Tests\n");
+    std::printf("=====================\n\n");
+
+    RUN_TEST(row_buffer_basics);
+    RUN_TEST(row_buffer_draw);
+    RUN_TEST(graphics_buffer_system_basics);
+    RUN_TEST(graphics_buffer_system_draw_and_clear);
+    RUN_TEST(invalid_row_handling);
+    RUN_TEST(global_instance);
+    RUN_TEST(multiple_triangles_per_row);
+    RUN_TEST(frame_stats_counters);
+    RUN_TEST(off_screen_triangles);
+    RUN_TEST(merged_shadows);
+    RUN_TEST(prefault);
+
+    std::printf("\n=====================\n");
+    std::printf("Tests: %d total, %d passed, %d failed\n",
+                testsRun, testsPassed, testsFailed);
+
+    return testsFailed > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
 }
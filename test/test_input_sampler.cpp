@@ -0,0 +1,186 @@
+// test_input_sampler.cpp
+// Test mouse input is split across physics ticks by arrival time
+
+#include "input_sampler.h"
+#include <cstdio>
+#include <cstdlib>
+
+// =============================================================================
+// Simple Test Framework
+// =============================================================================
+
+static int testsRun = 0;
+static int testsPassed = 0;
+static int testsFailed = 0;
+
+#define TEST(name) void test_##name()
+#define RUN_TEST(name) do { \
+    std::printf("  %s... ", #name); \
+    std::fflush(stdout); \
+    testsRun++; \
+    int failedBefore = testsFailed; \
+    test_##name(); \
+    if (testsFailed == failedBefore) { \
+        testsPassed++; \
+        std::printf("PASSED\n"); \
+    } \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        std::printf("FAILED\n    Assertion failed: %s\n    at %s:%d\n", \
+                    #cond, __FILE__, __LINE__); \
+        testsFailed++; \
+        return; \
+    } \
+} while(0)
+
+// =============================================================================
+// Tests
+// =============================================================================
+
+TEST(motion_slices)
+{
+    InputSampler sampler;
+    sampler.reset(1000);
+
+    // 64ms over 8 ticks: 8ms slices starting at 1000
+    sampler.addMotion(1001, 5, -1);
+    sampler.addMotion(1007, 1, 0);
+    sampler.addMotion(1008, 2, 2);
+    sampler.addMotion(1040, -3, 4);
+    sampler.addMotion(1063, 7, 7);
+    sampler.splitTicks(1064, 8);
+
+    ASSERT(sampler.getTick(0).dx == 6 && sampler.getTick(0).dy == -1);
+    ASSERT(sampler.getTick(1).dx == 2 && sampler.getTick(1).dy == 2);
+    ASSERT(sampler.getTick(5).dx == -3 && sampler.getTick(5).dy == 4);
+    ASSERT(sampler.getTick(7).dx == 7 && sampler.getTick(7).dy == 7);
+    static const int EMPTY_TICKS[] = {2, 3, 4, 6};
+    for (int tick : EMPTY_TICKS) {
+        ASSERT(sampler.getTick(tick).dx == 0 && sampler.getTick(tick).dy == 0);
+    }
+
+    // The next split starts where this one ended
+    sampler.addMotion(1064, 1, 1);
+    sampler.addMotion(1071, 2, 2);
+    sampler.splitTicks(1072, 2);
+    ASSERT(sampler.getTick(0).dx == 1 && sampler.getTick(1).dx == 2);
+}
+
+TEST(totals_kept)
+{
+    InputSampler sampler;
+    sampler.reset(0);
+
+    uint32_t time = 0;
+    int totalX = 0, totalY = 0, splitX = 0, splitY = 0;
+    for (int frame = 0; frame < 500; frame++) {
+        // Stamps before the slice start, on it and past its end included
+        for (int i = 0; i < frame % 7; i++) {
+            int dx = (frame * 31 + i * 17) % 41 - 20;
+            int dy = (frame * 13 + i * 29) % 37 - 18;
+            sampler.addMotion(time - 3 + static_cast<uint32_t>((frame * 7 + i * 11) % 80), dx, dy);
+            totalX += dx;
+            totalY += dy;
+        }
+        time += 1 + frame % 67;
+        int ticks = frame % 9;
+        sampler.splitTicks(time, ticks);
+        for (int tick = 0; tick < ticks; tick++) {
+            splitX += sampler.getTick(tick).dx;
+            splitY += sampler.getTick(tick).dy;
+        }
+    }
+    sampler.splitTicks(time, 1);
+    splitX += sampler.getTick(0).dx;
+    splitY += sampler.getTick(0).dy;
+
+    ASSERT(splitX == totalX && splitY == totalY);
+}
+
+TEST(buttons)
+{
+    InputSampler sampler;
+    sampler.reset(100);
+
+    // Left pressed in tick 2, released in tick 5 of 8
+    sampler.pressButtons(117, 1);
+    sampler.releaseButtons(142, 1);
+    sampler.splitTicks(164, 8);
+    for (int tick = 0; tick < 8; tick++) {
+        bool held = tick >= 2 && tick <= 5;
+        ASSERT((sampler.getTick(tick).buttons == 1) == held);
+    }
+
+    // A click inside one slice reaches that tick
+    sampler.pressButtons(170, 4);
+    sampler.releaseButtons(171, 4);
+    sampler.splitTicks(180, 2);
+    ASSERT(sampler.getTick(0).buttons == 4 && sampler.getTick(1).buttons == 0);
+
+    // A button still held carries into the next split
+    sampler.pressButtons(185, 2);
+    sampler.splitTicks(190, 1);
+    sampler.splitTicks(200, 3);
+    for (int tick = 0; tick < 3; tick++) {
+        ASSERT(sampler.getTick(tick).buttons == 2);
+    }
+    ASSERT(sampler.getButtons() == 2);
+}
+
+TEST(no_ticks_discard_and_reset)
+{
+    InputSampler sampler;
+    sampler.reset(0);
+
+    // No ticks this frame: the motion waits for the next split
+    sampler.addMotion(5, 3, 4);
+    sampler.splitTicks(10, 0);
+    sampler.addMotion(15, 1, 1);
+    sampler.splitTicks(20, 2);
+    ASSERT(sampler.getTick(0).dx == 3 && sampler.getTick(1).dx == 1);
+
+    // Discarded motion is dropped, but button changes are kept
+    sampler.addMotion(25, 9, 9);
+    sampler.pressButtons(26, 1);
+    sampler.discard(30);
+    ASSERT(sampler.getButtons() == 1);
+    sampler.splitTicks(40, 1);
+    ASSERT(sampler.getTick(0).dx == 0 && sampler.getTick(0).buttons == 1);
+
+    // Reset releases everything
+    sampler.addMotion(45, 9, 9);
+    sampler.reset(50);
+    ASSERT(sampler.getButtons() == 0);
+    sampler.splitTicks(60, 1);
+    ASSERT(sampler.getTick(0).dx == 0 && sampler.getTick(0).buttons == 0);
+
+    // The millisecond counter wrapping inside a frame
+    sampler.reset(0xFFFFFFF0u);
+    sampler.addMotion(0xFFFFFFF2u, 1, 0);
+    sampler.addMotion(0x0000000Cu, 2, 0);
+    sampler.splitTicks(0x00000010u, 2);
+    ASSERT(sampler.getTick(0).dx == 1 && sampler.getTick(1).dx == 2);
+}
+
+// =============================================================================
+// Main
+// =============================================================================
+
+int main()
+{
+    std::printf("Input Sampler Tests\n");
+    std::printf("===================\n\n");
+
+    RUN_TEST(motion_slices);
+    RUN_TEST(totals_kept);
+    RUN_TEST(buttons);
+    RUN_TEST(no_ticks_discard_and_reset);
+
+    std::printf("\n===================\n");
+    std::printf("Tests: %d total, %d passed, %d failed\n",
+                testsRun, testsPassed, testsFailed);
+
+    return testsFailed > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,202 @@
+// test_minimap.cpp
+// Test the world overview map and its incremental updates
+
+#include "minimap.h"
+#include "landscape.h"
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+
+// =============================================================================
+// Simple Test Framework
+// =============================================================================
+
+static int testsRun = 0;
+static int testsPassed = 0;
+static int testsFailed = 0;
+
+#define TEST(name) void test_##name()
+#define RUN_TEST(name) do { \
+    std::printf("  %s... ", #name); \
+    std::fflush(stdout); \
+    testsRun++; \
+    int failedBefore = testsFailed; \
+    test_##name(); \
+    if (testsFailed == failedBefore) { \
+        testsPassed++; \
+        std::printf("PASSED\n"); \
+    } \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        std::printf("FAILED\n    Assertion failed: %s\n    at %s:%d\n", \
+                    #cond, __FILE__, __LINE__); \
+        testsFailed++; \
+        return; \
+    } \
+} while(0)
+
+// =============================================================================
+// Helpers
+// =============================================================================
+
+// Read back a physical pixel from the screen buffer
+static Color getPixel(const ScreenBuffer& screen, int px, int py)
+{
+    const uint8_t* p = screen.getData() + py * ScreenBuffer::getPitch() + px * 4;
+    return Color(p[0], p[1], p[2], p[3]);
+}
+
+static bool sameColor(Color a, Color b)
+{
+    return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+}
+
+// Find a tile of open land away from the launchpad
+static bool findLandTile(int& tileX, int& tileZ)
+{
+    for (int z = 64; z < 256; z++) {
+        for (int x = 64; x < 256; x++) {
+            Fixed altitude = getLandscapeAltitudeAtTile(x, z);
+            if (altitude != GameConstants::SEA_LEVEL &&
+                altitude != GameConstants::LAUNCHPAD_ALTITUDE) {
+                tileX = x;
+                tileZ = z;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// =============================================================================
+// Tests
+// =============================================================================
+
+TEST(build)
+{
+    auto objects = std::make_unique<ObjectMap>();
+    objects->setObjectAt(7, 1, ObjectType::ROCKET);
+    auto minimap = std::make_unique<Minimap>(*objects);
+    minimap->build();
+    ASSERT(minimap->getBuildCount() == 1);
+
+    ASSERT(minimap->getTexel(0, 0) == MinimapPalette::LAUNCHPAD);
+    ASSERT(minimap->getTexel(7, 1) == MinimapPalette::ROCKET);
+
+    int seaTiles = 0;
+    int landTiles = 0;
+    for (int z = 0; z < Minimap::TILES; z++) {
+        for (int x = 0; x < Minimap::TILES; x++) {
+            uint8_t texel = minimap->getTexel(x, z);
+            if (texel == MinimapPalette::SEA) seaTiles++;
+            if (texel >= MinimapPalette::LAND && texel < MinimapPalette::TREE) landTiles++;
+        }
+    }
+    ASSERT(seaTiles > 0);
+    ASSERT(landTiles > 0);
+}
+
+TEST(object_changes)
+{
+    auto objects = std::make_unique<ObjectMap>();
+    auto minimap = std::make_unique<Minimap>(*objects);
+    minimap->build();
+    objects->setChangeCallback(Minimap::objectChanged, minimap.get());
+
+    int x = 0;
+    int z = 0;
+    bool found = findLandTile(x, z);
+    ASSERT(found);
+    uint8_t terrain = minimap->getTexel(x, z);
+
+    objects->setObjectAt(static_cast<uint8_t>(x), static_cast<uint8_t>(z), ObjectType::BUILDING);
+    ASSERT(minimap->getTexel(x, z) == MinimapPalette::BUILDING);
+
+    objects->setObjectAt(static_cast<uint8_t>(x), static_cast<uint8_t>(z),
+                         ObjectMap::getDestroyedType(ObjectType::BUILDING));
+    ASSERT(minimap->getTexel(x, z) == MinimapPalette::DESTROYED);
+
+    objects->restoreDestroyedObjects();
+    ASSERT(minimap->getTexel(x, z) == MinimapPalette::BUILDING);
+
+    objects->setObjectAt(static_cast<uint8_t>(x), static_cast<uint8_t>(z), ObjectType::NONE);
+    ASSERT(minimap->getTexel(x, z) == terrain);
+
+    // None of this needed a rebuild
+    ASSERT(minimap->getBuildCount() == 1);
+}
+
+TEST(cached_blit)
+{
+    int savedScale = DisplayConfig::scale;
+    DisplayConfig::scale = 1;
+
+    auto objects = std::make_unique<ObjectMap>();
+    auto minimap = std::make_unique<Minimap>(*objects);
+    minimap->build();
+    objects->setChangeCallback(Minimap::objectChanged, minimap.get());
+    auto screen = std::make_unique<ScreenBuffer>();
+
+    int x = 0;
+    int z = 0;
+    bool found = findLandTile(x, z);
+    ASSERT(found);
+
+    // At 1x each display pixel covers 4x4 tiles, north at the top; the
+    // player marker is kept in the opposite corner
+    const int mapX = 100;
+    const int mapY = 50;
+    int px = mapX + x / 4;
+    int py = mapY + (255 - z) / 4;
+
+    minimap->draw(*screen, mapX, mapY, 0, 0);
+    ASSERT(minimap->getImageBuildCount() == 1);
+    Color before = getPixel(*screen, px, py);
+    ASSERT(!sameColor(before, MinimapPalette::getColor(MinimapPalette::DESTROYED)));
+
+    // A destroyed object shows over the rest of its block without a rebuild
+    objects->setObjectAt(static_cast<uint8_t>(x), static_cast<uint8_t>(z), ObjectType::SMOKING_BUILDING);
+    minimap->draw(*screen, mapX, mapY, 0, 0);
+    ASSERT(minimap->getImageBuildCount() == 1);
+    ASSERT(sameColor(getPixel(*screen, px, py), MinimapPalette::getColor(MinimapPalette::DESTROYED)));
+
+    objects->setObjectAt(static_cast<uint8_t>(x), static_cast<uint8_t>(z), ObjectType::NONE);
+    minimap->draw(*screen, mapX, mapY, 0, 0);
+    ASSERT(sameColor(getPixel(*screen, px, py), before));
+
+    // The player's tile is marked in white
+    ASSERT(sameColor(getPixel(*screen, mapX, mapY + 63), Color::white()));
+
+    // A new display scale resolves the image again, one tile per pixel at 4x
+    DisplayConfig::scale = 4;
+    objects->setObjectAt(static_cast<uint8_t>(x), static_cast<uint8_t>(z), ObjectType::ROCKET);
+    minimap->draw(*screen, mapX / 4, mapY / 4, 0, 0);
+    ASSERT(minimap->getImageBuildCount() == 2);
+    ASSERT(sameColor(getPixel(*screen, mapX / 4 * 4 + x, mapY / 4 * 4 + 255 - z),
+                     MinimapPalette::getColor(MinimapPalette::ROCKET)));
+    ASSERT(minimap->getBuildCount() == 1);
+
+    DisplayConfig::scale = savedScale;
+}
+
+// =============================================================================
+// Main
+// =============================================================================
+
+int main()
+{
+    std::printf("Minimap Tests\n");
+    std::printf("=============\n\n");
+
+    RUN_TEST(build);
+    RUN_TEST(object_changes);
+    RUN_TEST(cached_blit);
+
+    std::printf("\n=============\n");
+    std::printf("Tests: %d total, %d passed, %d failed\n",
+                testsRun, testsPassed, testsFailed);
+
+    return testsFailed > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,261 @@
+// test_music_stream.cpp
+// Test streaming, mixing down and resampling WAV tracks
+
+#include "music_stream.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+// =============================================================================
+// Simple Test Framework
+// =============================================================================
+
+static int testsRun = 0;
+static int testsPassed = 0;
+static int testsFailed = 0;
+
+#define TEST(name) void test_##name()
+#define RUN_TEST(name) do { \
+    std::printf("  %s... ", #name); \
+    std::fflush(stdout); \
+    testsRun++; \
+    int failedBefore = testsFailed; \
+    test_##name(); \
+    if (testsFailed == failedBefore) { \
+        testsPassed++; \
+        std::printf("PASSED\n"); \
+    } \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        std::printf("FAILED\n    Assertion failed: %s\n    at %s:%d\n", \
+                    #cond, __FILE__, __LINE__); \
+        testsFailed++; \
+        return; \
+    } \
+} while(0)
+
+// =============================================================================
+// Helpers
+// =============================================================================
+
+static const char* WAV_PATH = "test_music_stream.wav";
+
+static void writeLE16(std::FILE* f, int value)
+{
+    std::fputc(value & 0xFF, f);
+    std::fputc((value >> 8) & 0xFF, f);
+}
+
+static void writeLE32(std::FILE* f, uint32_t value)
+{
+    writeLE16(f, static_cast<int>(value & 0xFFFF));
+    writeLE16(f, static_cast<int>(value >> 16));
+}
+
+// Write a PCM WAV file; samples are interleaved when there are two channels
+// An extra chunk before "data" checks that unknown chunks are skipped
+static bool writeWav(const std::vector<int>& samples, int channels, int rate, int bits)
+{
+    std::FILE* f = std::fopen(WAV_PATH, "wb");
+    if (!f) return false;
+    uint32_t dataSize = static_cast<uint32_t>(samples.size() * (bits / 8));
+
+    std::fputs("RIFF", f);
+    writeLE32(f, 4 + 8 + 16 + 8 + 3 + 1 + 8 + dataSize);
+    std::fputs("WAVE", f);
+
+    std::fputs("fmt ", f);
+    writeLE32(f, 16);
+    writeLE16(f, 1);
+    writeLE16(f, channels);
+    writeLE32(f, static_cast<uint32_t>(rate));
+    writeLE32(f, static_cast<uint32_t>(rate * channels * bits / 8));
+    writeLE16(f, channels * bits / 8);
+    writeLE16(f, bits);
+
+    std::fputs("LIST", f);
+    writeLE32(f, 3);
+    std::fputs("abc", f);
+    std::fputc(0, f);  // Pad byte
+
+    std::fputs("data", f);
+    writeLE32(f, dataSize);
+    for (int sample : samples) {
+        if (bits == 16) {
+            writeLE16(f, sample);
+        } else {
+            std::fputc(sample, f);
+        }
+    }
+    return std::fclose(f) == 0;
+}
+
+// Read from the stream the way the audio callback does until it finishes
+// or maxSamples have been read
+static std::vector<int16_t> readAll(MusicStream& stream, size_t maxSamples)
+{
+    std::vector<int16_t> out;
+    int16_t block[512];
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!stream.isFinished() && out.size() < maxSamples &&
+           std::chrono::steady_clock::now() < deadline) {
+        int got = stream.read(block, 512);
+        out.insert(out.end(), block, block + got);
+        if (got == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    return out;
+}
+
+// =============================================================================
+// Tests
+// =============================================================================
+
+TEST(rejects_bad_files)
+{
+    MusicStream stream;
+    bool opened = stream.open("no_such_track.wav", 22050, false);
+    ASSERT(!opened);
+    ASSERT(!stream.isOpen());
+
+    // 24-bit PCM is not supported
+    bool written = writeWav({0, 0, 0}, 1, 22050, 24);
+    ASSERT(written);
+    opened = stream.open(WAV_PATH, 22050, false);
+    ASSERT(!opened);
+
+    // A rate so low one source frame resamples to more than the ring
+    written = writeWav({0, 0, 0}, 1, 1, 16);
+    ASSERT(written);
+    opened = stream.open(WAV_PATH, 44100, false);
+    ASSERT(!opened);
+}
+
+TEST(same_rate_mono)
+{
+    // Longer than the ring, so the decoder has to wait for the reader
+    const int length = MusicStream::RING_SAMPLES * 3 + 123;
+    std::vector<int> samples(length);
+    for (int i = 0; i < length; i++) {
+        samples[i] = (i % 2000) - 1000;
+    }
+    bool written = writeWav(samples, 1, 22050, 16);
+    ASSERT(written);
+
+    MusicStream stream;
+    bool opened = stream.open(WAV_PATH, 22050, false);
+    ASSERT(opened);
+    ASSERT(stream.getSourceRate() == 22050);
+    ASSERT(stream.getSourceChannels() == 1);
+
+    std::vector<int16_t> out = readAll(stream, length * 2);
+    ASSERT(stream.isFinished());
+
+    // Same rate: samples come out one behind (the resampler starts from
+    // silence) and otherwise unchanged
+    ASSERT(static_cast<int>(out.size()) == length);
+    ASSERT(out[0] == 0);
+    for (int i = 1; i < length; i++) {
+        ASSERT(out[i] == samples[i - 1]);
+    }
+}
+
+TEST(stereo_downsample)
+{
+    // Left and right average to a constant 1000
+    const int frames = 8000;
+    std::vector<int> samples;
+    for (int i = 0; i < frames; i++) {
+        samples.push_back(3000);
+        samples.push_back(-1000);
+    }
+    bool written = writeWav(samples, 2, 44100, 16);
+    ASSERT(written);
+
+    MusicStream stream;
+    bool opened = stream.open(WAV_PATH, 22050, false);
+    ASSERT(opened);
+    ASSERT(stream.getSourceChannels() == 2);
+
+    std::vector<int16_t> out = readAll(stream, frames);
+    ASSERT(stream.isFinished());
+    ASSERT(static_cast<int>(out.size()) == frames / 2);
+    for (size_t i = 1; i < out.size(); i++) {
+        ASSERT(out[i] == 1000);
+    }
+}
+
+TEST(low_rate_upsample)
+{
+    // At 2 kHz a full chunk resamples to more output than the ring holds
+    const int frames = 2000;
+    std::vector<int> samples(frames, 1000);
+    bool written = writeWav(samples, 1, 2000, 16);
+    ASSERT(written);
+
+    MusicStream stream;
+    bool opened = stream.open(WAV_PATH, 44100, false);
+    ASSERT(opened);
+
+    std::vector<int16_t> out = readAll(stream, frames * 30);
+    ASSERT(stream.isFinished());
+    int expected = frames * 44100 / 2000;
+    ASSERT(std::abs(static_cast<int>(out.size()) - expected) <= 2);
+
+    // After the ramp up from silence over the first source sample
+    for (size_t i = 23; i < out.size(); i++) {
+        ASSERT(out[i] == 1000);
+    }
+}
+
+TEST(eight_bit_loop)
+{
+    // Unsigned 8-bit: 128 is silence, 192 is +16384
+    std::vector<int> samples(1000, 192);
+    bool written = writeWav(samples, 1, 22050, 8);
+    ASSERT(written);
+
+    MusicStream stream;
+    bool opened = stream.open(WAV_PATH, 22050, true);
+    ASSERT(opened);
+
+    // Looping tracks keep playing past their end
+    std::vector<int16_t> out = readAll(stream, 5000);
+    ASSERT(out.size() >= 5000);
+    ASSERT(!stream.isFinished());
+    for (size_t i = 1; i < out.size(); i++) {
+        ASSERT(out[i] == 16384);
+    }
+
+    stream.close();
+    ASSERT(!stream.isOpen());
+}
+
+// =============================================================================
+// Main
+// =============================================================================
+
+int main()
+{
+    std::printf("Music Stream Tests\n");
+    std::printf("==================\n\n");
+
+    RUN_TEST(rejects_bad_files);
+    RUN_TEST(same_rate_mono);
+    RUN_TEST(stereo_downsample);
+    RUN_TEST(low_rate_upsample);
+    RUN_TEST(eight_bit_loop);
+
+    std::remove(WAV_PATH);
+
+    std::printf("\n==================\n");
+    std::printf("Tests: %d total, %d passed, %d failed\n",
+                testsRun, testsPassed, testsFailed);
+
+    return testsFailed > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -146,6 +146,31 @@ void validateBlueprint(const ObjectBlueprint& bp, const char* name,
     }
     TEST(allColorsValid,
          (std::string(name) + " colors in valid range").c_str());
+
+    // The bounding radius reaches the furthest vertex, and no further
+    int64_t radiusSquared = static_cast<int64_t>(bp.boundingRadius) * bp.boundingRadius;
+    int64_t furthest = 0;
+    for (uint32_t i = 0; i < bp.vertexCount; i++) {
+        const ObjectVertex& v = bp.vertices[i];
+        int64_t squared = static_cast<int64_t>(v.x) * v.x + static_cast<int64_t>(v.y) * v.y +
+                          static_cast<int64_t>(v.z) * v.z;
+        if (squared > furthest) furthest = squared;
+    }
+    int64_t smaller = static_cast<int64_t>(bp.boundingRadius - 1) * (bp.boundingRadius - 1);
+    TEST(furthest <= radiusSquared && smaller < furthest,
+         (std::string(name) + " bounding radius fits its vertices").c_str());
+
+    // Upward faces, and the vertices they use
+    uint32_t upward = 0, upwardVertices = 0;
+    for (uint32_t i = 0; i < bp.faceCount; i++) {
+        const ObjectFace& f = bp.faces[i];
+        if (f.normalY < 0) {
+            upward |= 1u << i;
+            upwardVertices |= (1u << f.vertex0) | (1u << f.vertex1) | (1u << f.vertex2);
+        }
+    }
+    TEST(bp.upwardFaces == upward && bp.upwardFaceVertices == upwardVertices,
+         (std::string(name) + " upward face masks match its normals").c_str());
 }
 
 void testLandscapeObjects() {
@@ -369,6 +369,132 @@ void testObjectPlacement() {
     test(objectCount == objectCount2, "Placement is deterministic with same seed");
 }
 
+// =============================================================================
+// Test: Change callback
+// =============================================================================
+struct ChangeLog {
+    int count = 0;
+    int lastX = -1;
+    int lastZ = -1;
+};
+
+static void recordChange(void* context, uint8_t tileX, uint8_t tileZ) {
+    ChangeLog* log = static_cast<ChangeLog*>(context);
+    log->count++;
+    log->lastX = tileX;
+    log->lastZ = tileZ;
+}
+
+void testChangeCallback() {
+    printf("\nTesting change callback...\n");
+
+    ObjectMap map;
+    ChangeLog log;
+    map.setChangeCallback(recordChange, &log);
+
+    map.setObjectAt(10, 20, ObjectType::BUILDING);
+    test(log.count == 1 && log.lastX == 10 && log.lastZ == 20, "setObjectAt reports the tile");
+
+    map.setObjectAt(10, 20, ObjectType::BUILDING);
+    test(log.count == 1, "Setting the same object is not reported");
+
+    map.setObjectAt(30, 40, ObjectType::SMOKING_GAZEBO);
+    map.setObjectAt(50, 60, ObjectType::FIR_TREE);
+    log.count = 0;
+    map.restoreDestroyedObjects();
+    test(log.count == 1 && log.lastX == 30 && log.lastZ == 40,
+         "restoreDestroyedObjects reports only restored tiles");
+
+    map.setChangeCallback(nullptr, nullptr);
+    map.setObjectAt(10, 20, ObjectType::NONE);
+    test(log.count == 1, "No reports once the callback is removed");
+}
+
+// =============================================================================
+// Test: Version
+// =============================================================================
+void testVersion() {
+    printf("\nTesting version...\n");
+
+    ObjectMap map;
+    uint32_t version = map.getVersion();
+
+    map.setObjectAt(10, 20, ObjectType::BUILDING);
+    test(map.getVersion() != version, "setObjectAt changes the version");
+    version = map.getVersion();
+
+    map.setObjectAt(10, 20, ObjectType::BUILDING);
+    test(map.getVersion() == version, "Setting the same object keeps the version");
+
+    map.restoreDestroyedObjects();
+    test(map.getVersion() == version, "Restoring nothing keeps the version");
+
+    map.setObjectAt(30, 40, ObjectType::SMOKING_GAZEBO);
+    version = map.getVersion();
+    map.restoreDestroyedObjects();
+    test(map.getVersion() != version, "Restoring an object changes the version");
+    version = map.getVersion();
+
+    map.clear();
+    test(map.getVersion() != version, "clear changes the version");
+}
+
+// =============================================================================
+// Test: Published snapshots
+// =============================================================================
+static bool snapshotMatches(const ObjectMap& map) {
+    for (int z = 0; z < ObjectMapConstants::MAP_SIZE; z++) {
+        for (int x = 0; x < ObjectMapConstants::MAP_SIZE; x++) {
+            uint8_t tileX = static_cast<uint8_t>(x);
+            uint8_t tileZ = static_cast<uint8_t>(z);
+            if (map.getPublished().getObjectAt(tileX, tileZ) != map.getObjectAt(tileX, tileZ)) {
+                return false;
+            }
+        }
+    }
+    return map.getPublished().getVersion() == map.getVersion();
+}
+
+void testPublish() {
+    printf("\nTesting published snapshots...\n");
+
+    ObjectMap map;
+    map.publish();
+    test(snapshotMatches(map), "First publish copies the map");
+
+    map.setObjectAt(10, 20, ObjectType::BUILDING);
+    test(map.getPublished().getObjectAt(10, 20) == ObjectType::NONE,
+         "Changes are not visible before publishing");
+    test(map.getPublished().getVersion() != map.getVersion(), "Snapshot keeps the published version");
+
+    map.setObjectAt(10, 20, ObjectType::SMOKING_BUILDING);
+    map.setObjectAt(255, 0, ObjectType::ROCKET);
+    map.publish();
+    test(map.getPublished().getObjectAt(10, 20) == ObjectType::SMOKING_BUILDING,
+         "A tile changed twice publishes its latest object");
+    test(snapshotMatches(map), "Logged changes are published");
+
+    uint32_t version = map.getPublished().getVersion();
+    map.publish();
+    test(map.getPublished().getVersion() == version, "Publishing nothing keeps the version");
+
+    // More changes than the log holds fall back to a full copy
+    for (int i = 0; i < ObjectMap::MAX_LOGGED_CHANGES + 100; i++) {
+        map.setObjectAt(static_cast<uint8_t>(i), static_cast<uint8_t>(i >> 8), ObjectType::FIR_TREE);
+    }
+    map.publish();
+    test(snapshotMatches(map), "Overflowing the log publishes the whole map");
+
+    map.restoreDestroyedObjects();
+    map.clear();
+    map.setObjectAt(1, 2, ObjectType::GAZEBO);
+    map.publish();
+    test(snapshotMatches(map), "clear is published");
+
+    placeObjectsOnMap();
+    test(snapshotMatches(objectMap), "Object placement publishes the new map");
+}
+
 // =============================================================================
 // Main
 // =============================================================================
@@ -389,6 +515,9 @@ int main() {
     testMapSize();
     testRNG();
     testObjectPlacement();
+    testChangeCallback();
+    testVersion();
+    testPublish();
 
     // Summary
     printf("\n=== Summary ===\n");
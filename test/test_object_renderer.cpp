@@ -2,6 +2,7 @@
 #include "object3d.h"
 #include "math3d.h"
 #include "screen.h"
+#include "frame_stats.h"
 #include <cstdio>
 #include <cstdlib>
 
@@ -105,12 +106,88 @@ void testRotatedShip() {
     printf("  Saved test_ship_rotated.png for visual verification\n");
 }
 
+void testObjectCulling() {
+    printf("\nObject Culling Tests:\n");
+
+    Mat3x3 identity = Mat3x3::identity();
+
+    // In front of the camera: kept
+    Vec3 ahead(Fixed::fromInt(0), Fixed::fromInt(0), Fixed::fromInt(5));
+    TEST(!isObjectOffScreen(shipBlueprint, ahead), "Object ahead is not culled");
+
+    // Behind the camera, and far off to each side of the view
+    Vec3 behind(Fixed::fromInt(0), Fixed::fromInt(0), Fixed::fromInt(-3));
+    Vec3 left(Fixed::fromInt(-10), Fixed::fromInt(0), Fixed::fromInt(5));
+    Vec3 right(Fixed::fromInt(10), Fixed::fromInt(0), Fixed::fromInt(5));
+    Vec3 above(Fixed::fromInt(0), Fixed::fromInt(-10), Fixed::fromInt(5));
+    Vec3 below(Fixed::fromInt(0), Fixed::fromInt(10), Fixed::fromInt(5));
+    TEST(isObjectOffScreen(shipBlueprint, behind), "Object behind the camera is culled");
+    TEST(isObjectOffScreen(shipBlueprint, left) && isObjectOffScreen(shipBlueprint, right),
+         "Objects left and right of the view are culled");
+    TEST(isObjectOffScreen(shipBlueprint, above) && isObjectOffScreen(shipBlueprint, below),
+         "Objects above and below the view are culled");
+
+    // A shadow can be on screen when its object is above the view
+    TEST(!isShadowOffScreen(shipBlueprint, above, Fixed::fromInt(0)),
+         "Shadow of an object above the view is not culled");
+    ObjectBlueprint noShadow = shipBlueprint;
+    noShadow.flags |= ObjectFlags::NO_SHADOW;
+    TEST(isShadowOffScreen(noShadow, ahead, Fixed::fromInt(0)),
+         "Object with no shadow has its shadow culled");
+
+    // Culled objects add nothing, and are counted
+    frameStats.reset();
+    graphicsBuffers.clearAll();
+    bufferObject(shipBlueprint, left, identity, 0);
+    bufferObject(shipBlueprint, ahead, identity, 0);
+    TEST(frameStats.objectsCulled == 1 && frameStats.objectsDrawn == 1,
+         "bufferObject skips only the culled object");
+
+    // Culling is conservative: whatever is culled, at any rotation, has every
+    // vertex off the same edge of the screen (or behind the camera)
+    bool conservative = true;
+    uint32_t seed = 0x2468ACE1;
+    for (int i = 0; i < 20000; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        Mat3x3 rotation = calculateRotationMatrix(static_cast<int32_t>(seed), static_cast<int32_t>(seed * 3u));
+        seed = seed * 1664525u + 1013904223u;
+        int32_t x = static_cast<int32_t>(seed) >> 4;
+        seed = seed * 1664525u + 1013904223u;
+        int32_t y = static_cast<int32_t>(seed) >> 5;
+        seed = seed * 1664525u + 1013904223u;
+        int32_t z = static_cast<int32_t>(seed) >> 5;
+        Vec3 position(Fixed::fromRaw(x), Fixed::fromRaw(y), Fixed::fromRaw(z));
+        if (!isObjectOffScreen(shipBlueprint, position)) {
+            continue;
+        }
+
+        int sides = 0x1F;
+        for (uint32_t v = 0; v < shipBlueprint.vertexCount; v++) {
+            const ObjectVertex& vertex = shipBlueprint.vertices[v];
+            Vec3 point = rotation * Vec3(Fixed::fromRaw(vertex.x), Fixed::fromRaw(vertex.y), Fixed::fromRaw(vertex.z));
+            ProjectedVertex p = projectVertex(position + point);
+            int vertexSides = 0;
+            if (!p.visible) vertexSides = 0x1F;
+            else {
+                if (p.screenX < 0) vertexSides |= 0x01;
+                if (p.screenX >= ScreenBuffer::PHYSICAL_WIDTH()) vertexSides |= 0x02;
+                if (p.screenY < 0) vertexSides |= 0x04;
+                if (p.screenY >= ScreenBuffer::PHYSICAL_HEIGHT()) vertexSides |= 0x08;
+            }
+            sides &= vertexSides;
+        }
+        if (sides == 0) conservative = false;
+    }
+    TEST(conservative, "Culled objects never reach the screen");
+}
+
 int main() {
     printf("=== Object Renderer Tests ===\n\n");
 
     testLightingCalculation();
     testObjectRendering();
     testRotatedShip();
+    testObjectCulling();
 
     printf("\n=== Summary ===\n");
     printf("Passed: %d\n", testsPassed);
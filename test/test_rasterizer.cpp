@@ -0,0 +1,269 @@
+// test_rasterizer.cpp
+// Checks that the block rasterizer covers exactly the same pixels as the
+// scanline rasterizer
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "../src/screen.h"
+
+// =============================================================================
+// Simple Test Framework
+// =============================================================================
+
+static int testsRun = 0;
+static int testsPassed = 0;
+static int testsFailed = 0;
+
+#define TEST(name) void test_##name()
+#define RUN_TEST(name) do { \
+    std::printf("  %s... ", #name); \
+    testsRun++; \
+    int failedBefore = testsFailed; \
+    test_##name(); \
+    if (testsFailed == failedBefore) { \
+        testsPassed++; \
+        std::printf("PASSED\n"); \
+    } \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        std::printf("FAILED\n    Assertion failed: %s\n    at %s:%d\n", \
+                    #cond, __FILE__, __LINE__); \
+        testsFailed++; \
+        return; \
+    } \
+} while(0)
+
+// =============================================================================
+// Coverage Comparison Harness
+// =============================================================================
+
+struct Triangle {
+    int x0, y0, x1, y1, x2, y2;
+    Color color;
+};
+
+// Small deterministic generator so failures are reproducible
+static uint32_t randomState = 1;
+
+static int randomInt(int lo, int hi) {
+    randomState = randomState * 1664525u + 1013904223u;
+    return lo + static_cast<int>((randomState >> 8) % static_cast<uint32_t>(hi - lo + 1));
+}
+
+static Color randomColor() {
+    return Color(static_cast<uint8_t>(randomInt(1, 255)),
+                 static_cast<uint8_t>(randomInt(1, 255)),
+                 static_cast<uint8_t>(randomInt(1, 255)));
+}
+
+// Triangle with all vertices inside a box around (cx, cy)
+static Triangle randomTriangle(int cx, int cy, int size) {
+    Triangle t;
+    t.x0 = cx + randomInt(-size, size); t.y0 = cy + randomInt(-size, size);
+    t.x1 = cx + randomInt(-size, size); t.y1 = cy + randomInt(-size, size);
+    t.x2 = cx + randomInt(-size, size); t.y2 = cy + randomInt(-size, size);
+    t.color = randomColor();
+    return t;
+}
+
+// Draw the triangles with both backends and compare the visible area
+// Prints the first mismatching pixel and triangle index on failure
+static bool backendsMatch(const Triangle* tris, int count) {
+    static ScreenBuffer scanline;
+    static ScreenBuffer blocks;
+
+    for (int i = 0; i < count; i++) {
+        const Triangle& t = tris[i];
+        scanline.clear();
+        blocks.clear();
+        scanline.drawTriangleScanline(t.x0, t.y0, t.x1, t.y1, t.x2, t.y2, t.color);
+        blocks.drawTriangleBlocks(t.x0, t.y0, t.x1, t.y1, t.x2, t.y2, t.color);
+
+        for (int y = 0; y < ScreenBuffer::PHYSICAL_HEIGHT(); y++) {
+            const uint8_t* rowA = scanline.getData() + y * ScreenBuffer::getPitch();
+            const uint8_t* rowB = blocks.getData() + y * ScreenBuffer::getPitch();
+            if (std::memcmp(rowA, rowB, ScreenBuffer::getCurrentPitch()) != 0) {
+                for (int x = 0; x < ScreenBuffer::PHYSICAL_WIDTH(); x++) {
+                    if (std::memcmp(rowA + x * 4, rowB + x * 4, 4) != 0) {
+                        std::printf("\n    Triangle %d (%d,%d) (%d,%d) (%d,%d) differs at (%d,%d)\n    ",
+                                    i, t.x0, t.y0, t.x1, t.y1, t.x2, t.y2, x, y);
+                        return false;
+                    }
+                }
+            }
+        }
+    }
+    return true;
+}
+
+// Run a batch of random triangles of the given size at every display scale
+static bool randomBatchMatches(int count, int size, int margin) {
+    static Triangle tris[256];
+    int originalScale = DisplayConfig::scale;
+    bool ok = true;
+
+    for (int scale = 1; scale <= 4 && ok; scale *= 2) {
+        DisplayConfig::scale = scale;
+        int width = ScreenBuffer::PHYSICAL_WIDTH();
+        int height = ScreenBuffer::PHYSICAL_HEIGHT();
+        for (int i = 0; i < count; i++) {
+            tris[i] = randomTriangle(randomInt(-margin, width + margin),
+                                     randomInt(-margin, height + margin), size);
+        }
+        ok = backendsMatch(tris, count);
+    }
+
+    DisplayConfig::scale = originalScale;
+    return ok;
+}
+
+// =============================================================================
+// Tests
+// =============================================================================
+
+TEST(tiny_triangles) {
+    randomState = 1;
+    ASSERT(randomBatchMatches(256, 4, 8));
+}
+
+TEST(small_triangles) {
+    randomState = 2;
+    ASSERT(randomBatchMatches(256, 12, 16));
+}
+
+TEST(medium_triangles) {
+    randomState = 3;
+    ASSERT(randomBatchMatches(128, 80, 64));
+}
+
+TEST(large_triangles) {
+    randomState = 4;
+    ASSERT(randomBatchMatches(32, 900, 200));
+}
+
+TEST(thin_triangles) {
+    // Slivers where the truncated edges cross over near the vertices
+    static Triangle tris[200];
+    randomState = 5;
+    for (int i = 0; i < 200; i++) {
+        int x = randomInt(-20, 1300);
+        int y = randomInt(-20, 1040);
+        int dx = randomInt(-400, 400);
+        int dy = randomInt(-400, 400);
+        tris[i] = {x, y, x + dx, y + dy, x + dx + randomInt(-2, 2), y + dy + randomInt(-2, 2),
+                   randomColor()};
+    }
+    ASSERT(backendsMatch(tris, 200));
+}
+
+TEST(degenerate_triangles) {
+    static const Triangle tris[] = {
+        {100, 100, 100, 100, 100, 100, Color::red()},      // Point
+        {100, 100, 300, 100, 200, 100, Color::green()},    // Horizontal line
+        {100, 100, 100, 300, 100, 200, Color::blue()},     // Vertical line
+        {100, 100, 200, 200, 300, 300, Color::yellow()},   // Diagonal line
+        {-50, 500, 1400, 500, 600, 500, Color::cyan()},    // Row wider than the screen
+        {0, 0, 1279, 0, 0, 1023, Color::white()},          // Screen corners
+        {1279, 1023, 0, 1023, 1279, 0, Color::magenta()},
+    };
+    ASSERT(backendsMatch(tris, sizeof(tris) / sizeof(tris[0])));
+}
+
+TEST(extreme_coordinates) {
+    static const Triangle tris[] = {
+        {-20000, -20000, 20000, 500, 640, 30000, Color::red()},
+        {-15000, 100, -12000, 900, 700, 512, Color::green()},
+        {640, -50000, 660, 50000, 650, 512, Color::blue()},
+        {-20000, -20000, -15000, -20000, -18000, -12000, Color::white()},  // Rejected
+    };
+    ASSERT(backendsMatch(tris, sizeof(tris) / sizeof(tris[0])));
+}
+
+TEST(painter_order) {
+    // Overlapping triangles drawn in sequence must give the same image
+    static ScreenBuffer scanline;
+    static ScreenBuffer blocks;
+    scanline.clear();
+    blocks.clear();
+
+    randomState = 6;
+    for (int i = 0; i < 500; i++) {
+        Triangle t = randomTriangle(randomInt(0, 1279), randomInt(0, 1023), randomInt(2, 300));
+        scanline.drawTriangleScanline(t.x0, t.y0, t.x1, t.y1, t.x2, t.y2, t.color);
+        blocks.drawTriangleBlocks(t.x0, t.y0, t.x1, t.y1, t.x2, t.y2, t.color);
+    }
+    ASSERT(std::memcmp(scanline.getData(), blocks.getData(), ScreenBuffer::getBufferSize()) == 0);
+}
+
+TEST(backend_selection) {
+    static ScreenBuffer selected;
+    static ScreenBuffer reference;
+    selected.clear();
+    reference.clear();
+
+    RasterConfig::backend = RasterBackend::EdgeBlocks;
+    selected.drawTriangle(10, 10, 700, 40, 300, 900, Color::red());
+    RasterConfig::backend = RasterBackend::Scanline;
+    reference.drawTriangleBlocks(10, 10, 700, 40, 300, 900, Color::red());
+
+    ASSERT(std::memcmp(selected.getData(), reference.getData(), ScreenBuffer::getBufferSize()) == 0);
+}
+
+TEST(strip_with_blocks_backend) {
+    // Quad strips drawn with the block backend match the scanline strip
+    static ScreenBuffer blocks;
+    static ScreenBuffer scanline;
+    blocks.clear();
+    scanline.clear();
+
+    StripCorner top[6];
+    StripCorner bottom[6];
+    Color colors[5];
+    randomState = 7;
+    for (int i = 0; i < 6; i++) {
+        top[i] = {i * 250 + randomInt(-40, 40), 300 + randomInt(-100, 100)};
+        bottom[i] = {i * 260 + randomInt(-40, 40), 600 + randomInt(-100, 100)};
+    }
+    for (int i = 0; i < 5; i++) {
+        colors[i] = randomColor();
+    }
+
+    scanline.drawQuadStrip(top, bottom, colors, 5);
+    RasterConfig::backend = RasterBackend::EdgeBlocks;
+    blocks.drawQuadStrip(top, bottom, colors, 5);
+    RasterConfig::backend = RasterBackend::Scanline;
+
+    ASSERT(std::memcmp(scanline.getData(), blocks.getData(), ScreenBuffer::getBufferSize()) == 0);
+}
+
+// =============================================================================
+// Main
+// =============================================================================
+
+int main() {
+    std::printf("Rasterizer Backend Tests\n");
+    std::printf("========================\n\n");
+
+    std::printf("Coverage tests:\n");
+    RUN_TEST(tiny_triangles);
+    RUN_TEST(small_triangles);
+    RUN_TEST(medium_triangles);
+    RUN_TEST(large_triangles);
+    RUN_TEST(thin_triangles);
+    RUN_TEST(degenerate_triangles);
+    RUN_TEST(extreme_coordinates);
+
+    std::printf("\nDrawing tests:\n");
+    RUN_TEST(painter_order);
+    RUN_TEST(backend_selection);
+    RUN_TEST(strip_with_blocks_backend);
+
+    std::printf("\n========================\n");
+    std::printf("Tests: %d total, %d passed, %d failed\n",
+                testsRun, testsPassed, testsFailed);
+
+    return testsFailed > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,218 @@
+// test_reciprocal.cpp
+// Test division by reciprocal gives exactly the hardware division's results,
+// and time the two
+
+#include "reciprocal.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+// =============================================================================
+// Simple Test Framework
+// =============================================================================
+
+static int testsRun = 0;
+static int testsPassed = 0;
+static int testsFailed = 0;
+
+#define TEST(name) void test_##name()
+#define RUN_TEST(name) do { \
+    std::printf("  %s... ", #name); \
+    std::fflush(stdout); \
+    testsRun++; \
+    int failedBefore = testsFailed; \
+    test_##name(); \
+    if (testsFailed == failedBefore) { \
+        testsPassed++; \
+        std::printf("PASSED\n"); \
+    } \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        std::printf("FAILED\n    Assertion failed: %s\n    at %s:%d\n", \
+                    #cond, __FILE__, __LINE__); \
+        testsFailed++; \
+        return; \
+    } \
+} while(0)
+
+// =============================================================================
+// Helpers
+// =============================================================================
+
+// Small deterministic generator, so failures can be reproduced
+static uint64_t randomState = 0x9E3779B97F4A7C15ULL;
+
+static uint64_t randomBits()
+{
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 7;
+    randomState ^= randomState << 17;
+    return randomState;
+}
+
+// Numerators of every size up to 63 bits, either sign
+static int64_t randomNumerator()
+{
+    int64_t value = static_cast<int64_t>(randomBits() >> 1) >> (randomBits() % 63);
+    return (randomBits() & 1) ? -value : value;
+}
+
+static const int32_t edgeDivisors[] = {
+    1, -1, 2, -2, 3, 7, 255, 256, 257, 1023, 1024, 0x00FFFFFF, 0x01000000, 0x01000001,
+    0x40000000, 0x7FFFFFFF, -0x7FFFFFFF, INT32_MIN, INT32_MIN + 1
+};
+
+static const int64_t edgeNumerators[] = {
+    0, 1, -1, 2, -2, 0x7FFFFFFF, -0x7FFFFFFFLL - 1, 0xFFFFFFFFLL, 0x100000000LL,
+    INT64_MAX, -INT64_MAX, INT64_MAX / 3, 0x00FFFFFFFFFFFFFFLL, -0x0100000000000000LL
+};
+
+// =============================================================================
+// Tests
+// =============================================================================
+
+TEST(edge_cases)
+{
+    for (int32_t divisor : edgeDivisors) {
+        Reciprocal reciprocal(divisor);
+        ASSERT(reciprocal.getDivisor() == divisor);
+        for (int64_t numerator : edgeNumerators) {
+            ASSERT(reciprocal.divide(numerator) == numerator / divisor);
+        }
+        for (int64_t n = -1000; n <= 1000; n++) {
+            ASSERT(reciprocal.divide(n) == n / divisor);
+        }
+    }
+
+    // The default is a reciprocal of 1
+    Reciprocal one;
+    ASSERT(one.getDivisor() == 1 && one.divide(-12345) == -12345);
+}
+
+TEST(random)
+{
+    for (int i = 0; i < 1000000; i++) {
+        int32_t divisor = static_cast<int32_t>(randomBits());
+        if (divisor == 0) continue;
+        divisor >>= randomBits() % 31;
+        if (divisor == 0) divisor = 1;
+
+        Reciprocal reciprocal(divisor);
+        for (int j = 0; j < 4; j++) {
+            int64_t numerator = randomNumerator();
+            ASSERT(reciprocal.divide(numerator) == numerator / divisor);
+        }
+    }
+}
+
+TEST(small_divisors)
+{
+    for (int divisor = 1; divisor < Reciprocal::SMALL_DIVISORS; divisor++) {
+        const Reciprocal& reciprocal = Reciprocal::forSmall(divisor);
+        ASSERT(reciprocal.getDivisor() == divisor);
+
+        // Triangle edge slopes: 16.16 widths across the clamped screen range
+        for (int dx = -20000; dx <= 20000; dx += 97) {
+            int64_t numerator = static_cast<int64_t>(dx) << 16;
+            ASSERT(reciprocal.divide(numerator) == numerator / divisor);
+        }
+        for (int j = 0; j < 64; j++) {
+            int64_t numerator = randomNumerator();
+            ASSERT(reciprocal.divide(numerator) == numerator / divisor);
+        }
+    }
+}
+
+// =============================================================================
+// Benchmark
+// =============================================================================
+//
+// Not a pass/fail test: prints the time per division for the hardware divide
+// and for reciprocals, both made fresh for every two divisions and ready-made.
+//
+// =============================================================================
+
+template <typename Divide>
+static double timeDivisions(const std::vector<int64_t>& numerators, const std::vector<int32_t>& divisors,
+                            Divide divide, int64_t& checksum)
+{
+    auto start = std::chrono::steady_clock::now();
+    int64_t sum = 0;
+    for (int pass = 0; pass < 10; pass++) {
+        for (size_t i = 0; i < divisors.size(); i++) {
+            sum += divide(numerators[2 * i], numerators[2 * i + 1], divisors[i]);
+        }
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    checksum = sum;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / (10.0 * 2.0 * divisors.size());
+}
+
+void benchmark()
+{
+    std::printf("Benchmarking (ns per division)...\n");
+
+    const size_t COUNT = 1 << 18;
+
+    // Two numerators per divisor, as in a vertex projection
+    std::vector<int64_t> numerators(2 * COUNT);
+    std::vector<int32_t> depths(COUNT);
+    std::vector<int32_t> heights(COUNT);
+    for (size_t i = 0; i < COUNT; i++) {
+        numerators[2 * i] = static_cast<int64_t>(static_cast<int32_t>(randomBits())) * 256;
+        numerators[2 * i + 1] = static_cast<int64_t>(static_cast<int32_t>(randomBits())) * 256;
+        depths[i] = static_cast<int32_t>(randomBits() >> 34) + 1;
+        heights[i] = static_cast<int32_t>(randomBits() % 300) + 1;
+    }
+
+    int64_t hardwareSum, reciprocalSum, smallHardwareSum, smallSum;
+    double hardware = timeDivisions(numerators, depths, [](int64_t a, int64_t b, int32_t d) {
+        return a / d + b / d;
+    }, hardwareSum);
+    double fresh = timeDivisions(numerators, depths, [](int64_t a, int64_t b, int32_t d) {
+        Reciprocal depth(d);
+        return depth.divide(a) + depth.divide(b);
+    }, reciprocalSum);
+
+    // Triangle slopes: numerators over small edge heights
+    double smallHardware = timeDivisions(numerators, heights, [](int64_t a, int64_t b, int32_t d) {
+        return a / d + b / d;
+    }, smallHardwareSum);
+    double small = timeDivisions(numerators, heights, [](int64_t a, int64_t b, int32_t d) {
+        const Reciprocal& height = Reciprocal::forSmall(d);
+        return height.divide(a) + height.divide(b);
+    }, smallSum);
+
+    ASSERT(hardwareSum == reciprocalSum);
+    ASSERT(smallHardwareSum == smallSum);
+
+    std::printf("  any divisor:    hardware %.2f, fresh reciprocal %.2f\n", hardware, fresh);
+    std::printf("  small divisors: hardware %.2f, ready-made reciprocal %.2f\n", smallHardware, small);
+}
+
+// =============================================================================
+// Main
+// =============================================================================
+
+int main()
+{
+    std::printf("Reciprocal Tests\n");
+    std::printf("================\n\n");
+
+    RUN_TEST(edge_cases);
+    RUN_TEST(random);
+    RUN_TEST(small_divisors);
+
+    std::printf("\n");
+    benchmark();
+
+    std::printf("\n================\n");
+    std::printf("Tests: %d total, %d passed, %d failed\n",
+                testsRun, testsPassed, testsFailed);
+
+    return testsFailed > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -1,5 +1,6 @@
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include "../src/screen.h"
 
 // =============================================================================
@@ -701,6 +702,92 @@ TEST(hline_full_row) {
     ASSERT_EQ(screen.getPhysicalPixel(640, 513).r, 0);
 }
 
+// =============================================================================
+// Quad Strip Tests
+// =============================================================================
+
+// Draw a strip as independent triangles, the way drawTile() used to
+static void drawStripAsTriangles(ScreenBuffer& screen, const StripCorner* top,
+                                 const StripCorner* bottom, const Color* colors,
+                                 int quadCount) {
+    for (int i = 0; i < quadCount; i++) {
+        screen.drawTriangle(top[i].x, top[i].y, top[i + 1].x, top[i + 1].y,
+                            bottom[i].x, bottom[i].y, colors[i]);
+        screen.drawTriangle(top[i + 1].x, top[i + 1].y, bottom[i + 1].x, bottom[i + 1].y,
+                            bottom[i].x, bottom[i].y, colors[i]);
+    }
+}
+
+static bool buffersMatch(const ScreenBuffer& a, const ScreenBuffer& b) {
+    return std::memcmp(a.getData(), b.getData(), ScreenBuffer::getBufferSize()) == 0;
+}
+
+TEST(strip_matches_triangles) {
+    ScreenBuffer strip;
+    ScreenBuffer reference;
+
+    // A regular row of terrain-like quads
+    StripCorner top[9];
+    StripCorner bottom[9];
+    Color colors[8];
+    for (int i = 0; i < 9; i++) {
+        top[i] = {100 + i * 120, 400 + (i % 3) * 17};
+        bottom[i] = {60 + i * 140, 520 - (i % 2) * 23};
+    }
+    for (int i = 0; i < 8; i++) {
+        colors[i] = Color(static_cast<uint8_t>(30 * i), 200, static_cast<uint8_t>(255 - 30 * i));
+    }
+
+    strip.drawQuadStrip(top, bottom, colors, 8);
+    drawStripAsTriangles(reference, top, bottom, colors, 8);
+    ASSERT(buffersMatch(strip, reference));
+}
+
+TEST(strip_matches_triangles_random) {
+    ScreenBuffer strip;
+    ScreenBuffer reference;
+
+    // Jittered corners produce overlapping, flat and folded quads
+    uint32_t seed = 12345;
+    auto next = [&seed](int range) {
+        seed = seed * 1664525u + 1013904223u;
+        return static_cast<int>((seed >> 8) % static_cast<uint32_t>(range));
+    };
+
+    for (int pass = 0; pass < 200; pass++) {
+        StripCorner top[13];
+        StripCorner bottom[13];
+        Color colors[12];
+        int quadCount = 1 + next(12);
+        for (int i = 0; i <= quadCount; i++) {
+            top[i] = {-200 + i * 130 + next(120), -100 + next(900)};
+            bottom[i] = {-200 + i * 130 + next(120), top[i].y + next(300) - 60};
+        }
+        for (int i = 0; i < quadCount; i++) {
+            colors[i] = Color(static_cast<uint8_t>(next(256)), static_cast<uint8_t>(next(256)),
+                              static_cast<uint8_t>(next(256)));
+        }
+
+        strip.drawQuadStrip(top, bottom, colors, quadCount);
+        drawStripAsTriangles(reference, top, bottom, colors, quadCount);
+    }
+    ASSERT(buffersMatch(strip, reference));
+}
+
+TEST(strip_extreme_coordinates) {
+    ScreenBuffer strip;
+    ScreenBuffer reference;
+
+    // Corners beyond the clamp range must match drawTriangle's clamping
+    StripCorner top[3] = {{-20000, 100}, {400, 200}, {900, -15000}};
+    StripCorner bottom[3] = {{-300, 700}, {500, 800}, {30000, 900}};
+    Color colors[2] = {Color::red(), Color::green()};
+
+    strip.drawQuadStrip(top, bottom, colors, 2);
+    drawStripAsTriangles(reference, top, bottom, colors, 2);
+    ASSERT(buffersMatch(strip, reference));
+}
+
 // =============================================================================
 // Main
 // =============================================================================
@@ -764,6 +851,11 @@ int main() {
     RUN_TEST(hline_screen_edges);
     RUN_TEST(hline_full_row);
 
+    std::printf("\nQuad strip tests:\n");
+    RUN_TEST(strip_matches_triangles);
+    RUN_TEST(strip_matches_triangles_random);
+    RUN_TEST(strip_extreme_coordinates);
+
     std::printf("\n========================\n");
     std::printf("Tests: %d total, %d passed, %d failed\n",
                 testsRun, testsPassed, testsFailed);
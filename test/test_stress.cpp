@@ -0,0 +1,225 @@
+// test_stress.cpp
+// Test the stress scenario scripts and report
+
+#include "stress.h"
+#include "particles.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// =============================================================================
+// Simple Test Framework
+// =============================================================================
+
+static int testsRun = 0;
+static int testsPassed = 0;
+static int testsFailed = 0;
+
+#define TEST(name) void test_##name()
+#define RUN_TEST(name) do { \
+    std::printf("  %s... ", #name); \
+    std::fflush(stdout); \
+    testsRun++; \
+    int failedBefore = testsFailed; \
+    test_##name(); \
+    if (testsFailed == failedBefore) { \
+        testsPassed++; \
+        std::printf("PASSED\n"); \
+    } \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        std::printf("FAILED\n    Assertion failed: %s\n    at %s:%d\n", \
+                    #cond, __FILE__, __LINE__); \
+        testsFailed++; \
+        return; \
+    } \
+} while(0)
+
+// =============================================================================
+// Tests
+// =============================================================================
+
+TEST(scenario_names)
+{
+    for (int i = 0; i < STRESS_SCENARIO_COUNT; i++) {
+        StressScenario scenario = StressScenario::Count;
+        StressScenario expected = static_cast<StressScenario>(i);
+        bool found = findStressScenario(getStressScenarioName(expected), scenario);
+        ASSERT(found);
+        ASSERT(scenario == expected);
+    }
+    StressScenario scenario = StressScenario::Rocks;
+    bool found = findStressScenario("rock", scenario);
+    ASSERT(!found);
+    found = findStressScenario("", scenario);
+    ASSERT(!found);
+    ASSERT(scenario == StressScenario::Rocks);
+    ASSERT(std::strcmp(getStressScenarioName(StressScenario::Forest), "forest") == 0);
+}
+
+TEST(densest_view)
+{
+    ObjectMap objects;
+    objects.clear();
+
+    // A scattering of objects, and a cluster that fits one 13x11 view
+    for (int i = 0; i < 40; i++) {
+        objects.setObjectAt(static_cast<uint8_t>(i * 37), static_cast<uint8_t>(i * 91), 1);
+    }
+    for (int z = 0; z < 11; z++) {
+        for (int x = 0; x < 12; x += 2) {
+            objects.setObjectAt(static_cast<uint8_t>(100 + x), static_cast<uint8_t>(50 + z), 2);
+        }
+    }
+
+    // Objects are drawn from column 1 (camera tile - 6 + 1) to 12
+    StressView view = findDensestView(objects, 13, 11);
+    ASSERT(view.objects == 66);
+    ASSERT(view.cameraTileZ == 50);
+    ASSERT(view.cameraTileX - 6 + 1 <= 100);
+    ASSERT(view.cameraTileX - 6 + 12 >= 110);
+
+    // Destroyed objects don't count
+    for (int x = 0; x < 12; x += 2) {
+        objects.setObjectAt(static_cast<uint8_t>(100 + x), 50, ObjectMap::getDestroyedType(2));
+    }
+    view = findDensestView(objects, 13, 11);
+    ASSERT(view.objects == 60);
+
+    // Views wrap around the edge of the world
+    objects.clear();
+    for (int x = 250; x < 262; x++) {
+        objects.setObjectAt(static_cast<uint8_t>(x), 3, 4);
+    }
+    view = findDensestView(objects, 13, 11);
+    ASSERT(view.objects == 12);
+    ASSERT(view.cameraTileX == 255);
+}
+
+TEST(explosions_script)
+{
+    ObjectMap objects;
+    objects.clear();
+    for (int i = 0; i < 5; i++) {
+        objects.setObjectAt(static_cast<uint8_t>(30 + i), 80, 3);
+    }
+
+    StressScript script(StressScenario::Explosions);
+    ASSERT(script.getLandscapeScale(2) == 2);
+    script.start(objects);
+
+    // One object in view goes every few frames, with an explosion
+    particleSystem.clear();
+    StressFrame first = script.step(0, objects);
+    ASSERT(first.buttons == 0);
+    ASSERT(particleSystem.getParticleCount() > 0);
+    int destroyed = 0;
+    for (int frame = 1; frame < 5 * 8; frame++) {
+        StressFrame next = script.step(frame, objects);
+        ASSERT(next.shipPosition.x == first.shipPosition.x);
+        ASSERT(next.shipPosition.z == first.shipPosition.z);
+    }
+    for (int i = 0; i < 5; i++) {
+        if (ObjectMap::isDestroyedType(objects.getObjectAt(static_cast<uint8_t>(30 + i), 80))) {
+            destroyed++;
+        }
+    }
+    ASSERT(destroyed == 5);
+
+    // Then they are all put back and it starts again
+    script.step(5 * 8, objects);
+    destroyed = 0;
+    for (int i = 0; i < 5; i++) {
+        if (ObjectMap::isDestroyedType(objects.getObjectAt(static_cast<uint8_t>(30 + i), 80))) {
+            destroyed++;
+        }
+    }
+    ASSERT(destroyed == 1);
+}
+
+TEST(script_settings)
+{
+    ObjectMap objects;
+    objects.clear();
+
+    StressScript forest(StressScenario::Forest);
+    ASSERT(forest.getLandscapeScale(1) == GameConstants::MAX_SCALE);
+    ASSERT(!forest.getStars(false));
+
+    StressScript stars(StressScenario::Stars);
+    ASSERT(stars.getStars(false));
+    stars.start(objects);
+    StressFrame frame = stars.step(0, objects);
+    ASSERT(frame.shipPosition.y.raw == -StarConfig::MAX_ALTITUDE);
+    StressFrame later = stars.step(100, objects);
+    ASSERT(later.shipPosition.z.raw > frame.shipPosition.z.raw);
+
+    StressScript splashes(StressScenario::Splashes);
+    splashes.start(objects);
+    frame = splashes.step(0, objects);
+    ASSERT(frame.buttons == 1);
+
+    // The same script plays the same way
+    particleSystem.clear();
+    StressScript rocks(StressScenario::Rocks);
+    rocks.start(objects);
+    rocks.step(0, objects);
+    int count = particleSystem.getParticleCount();
+    Vec3 position = particleSystem.getParticle(0).position;
+    ASSERT(count > 0);
+
+    particleSystem.clear();
+    StressScript again(StressScenario::Rocks);
+    again.start(objects);
+    again.step(0, objects);
+    ASSERT(particleSystem.getParticleCount() == count);
+    ASSERT(particleSystem.getParticle(0).position.x == position.x);
+    ASSERT(particleSystem.getParticle(0).position.z == position.z);
+}
+
+TEST(report)
+{
+    StressReport report;
+    ASSERT(report.getPercentile(50) == 0);
+
+    FrameStats stats;
+    for (uint32_t micros = 1; micros <= 100; micros++) {
+        stats.trianglesDrawn = static_cast<int>(micros * 10);
+        report.addFrame(micros * 1000, stats);
+    }
+    ASSERT(report.getFrameCount() == 100);
+    ASSERT(report.getPercentile(50) == 50000);
+    ASSERT(report.getPercentile(99) == 99000);
+    ASSERT(report.getPercentile(100) == 100000);
+    ASSERT(report.getPercentile(0) == 1000);
+    ASSERT(report.getPeakTriangles() == 1000);
+
+    // A single slow frame is the maximum but not the median
+    report.addFrame(900000, stats);
+    ASSERT(report.getPercentile(100) == 900000);
+    ASSERT(report.getPercentile(50) == 51000);
+}
+
+// =============================================================================
+// Main
+// =============================================================================
+
+int main()
+{
+    std::printf("Stress Tests\n");
+    std::printf("============\n\n");
+
+    RUN_TEST(scenario_names);
+    RUN_TEST(densest_view);
+    RUN_TEST(explosions_script);
+    RUN_TEST(script_settings);
+    RUN_TEST(report);
+
+    std::printf("\n============\n");
+    std::printf("Tests: %d total, %d passed, %d failed\n",
+                testsRun, testsPassed, testsFailed);
+
+    return testsFailed > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,94 @@
+// test_task_pool.cpp
+// Test the startup task pool
+
+#include "task_pool.h"
+#include <iostream>
+#include <cassert>
+#include <atomic>
+#include <chrono>
+
+void testRunsAllTasks()
+{
+    std::cout << "Testing all submitted tasks run..." << std::endl;
+
+    std::atomic<int> count{0};
+    {
+        TaskPool pool(3);
+        assert(pool.getThreadCount() == 3);
+        for (int i = 0; i < 100; i++) {
+            pool.submit([&count] { count++; });
+        }
+        // Destroying the pool runs the queued tasks before joining
+    }
+    assert(count == 100);
+
+    std::cout << "  PASS" << std::endl;
+}
+
+void testFutureWaitsForTask()
+{
+    std::cout << "Testing future waits for its task..." << std::endl;
+
+    TaskPool pool(2);
+    int result = 0;
+    std::future<void> done = pool.submit([&result] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        result = 42;
+    });
+    done.wait();
+    assert(result == 42);
+
+    std::cout << "  PASS" << std::endl;
+}
+
+void testTasksOverlap()
+{
+    std::cout << "Testing tasks run in parallel..." << std::endl;
+
+    // Two tasks that each wait for the other can only finish if they run at
+    // the same time on different workers
+    TaskPool pool(2);
+    std::atomic<int> arrived{0};
+    auto meet = [&arrived] {
+        arrived++;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (arrived < 2 && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::yield();
+        }
+    };
+    std::future<void> a = pool.submit(meet);
+    std::future<void> b = pool.submit(meet);
+    a.wait();
+    b.wait();
+    assert(arrived == 2);
+
+    std::cout << "  PASS" << std::endl;
+}
+
+void testZeroThreadsStillRuns()
+{
+    std::cout << "Testing pool with zero threads requested..." << std::endl;
+
+    TaskPool pool(0);
+    assert(pool.getThreadCount() == 1);
+    bool ran = false;
+    pool.submit([&ran] { ran = true; }).wait();
+    assert(ran);
+
+    std::cout << "  PASS" << std::endl;
+}
+
+int main()
+{
+    std::cout << "=== Task Pool Tests ===" << std::endl;
+
+    testRunsAllTasks();
+    testFutureWaitsForTask();
+    testTasksOverlap();
+    testZeroThreadsStillRuns();
+
+    std::cout << std::endl;
+    std::cout << "All task pool tests passed!" << std::endl;
+
+    return 0;
+}
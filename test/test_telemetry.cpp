@@ -0,0 +1,208 @@
+// test_telemetry.cpp
+// Test the telemetry line format and the non-blocking Unix socket endpoint
+
+#include "telemetry.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// =============================================================================
+// Simple Test Framework
+// =============================================================================
+
+static int testsRun = 0;
+static int testsPassed = 0;
+static int testsFailed = 0;
+
+#define TEST(name) void test_##name()
+#define RUN_TEST(name) do { \
+    std::printf("  %s... ", #name); \
+    std::fflush(stdout); \
+    testsRun++; \
+    int failedBefore = testsFailed; \
+    test_##name(); \
+    if (testsFailed == failedBefore) { \
+        testsPassed++; \
+        std::printf("PASSED\n"); \
+    } \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        std::printf("FAILED\n    Assertion failed: %s\n    at %s:%d\n", \
+                    #cond, __FILE__, __LINE__); \
+        testsFailed++; \
+        return; \
+    } \
+} while(0)
+
+// =============================================================================
+// Helpers
+// =============================================================================
+
+static const char* SOCKET_PATH = "test_telemetry.sock";
+
+static void recordFrames(TelemetryServer& server, int count, uint32_t firstMicros)
+{
+    FrameStats stats;
+    stats.particles[static_cast<int>(ParticleKind::Exhaust)] = 12;
+    stats.particles[static_cast<int>(ParticleKind::Star)] = 30;
+    stats.particlesRejected = 1;
+    const uint32_t stages[TELEMETRY_STAGE_COUNT] = {1000, 4000, 2000};
+    for (int i = 0; i < count; i++) {
+        server.recordFrame(firstMicros + i * 1000, stages, stats);
+    }
+}
+
+// Connected socket, or -1
+static int connectClient()
+{
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    std::strcpy(address.sun_path, SOCKET_PATH);
+    if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// =============================================================================
+// Tests
+// =============================================================================
+
+TEST(format_line)
+{
+    TelemetryServer server;
+    // 100 frames of 1ms, 2ms, ... 100ms
+    recordFrames(server, 100, 1000);
+
+    TelemetryStatus status;
+    status.displayScale = 4;
+    status.landscapeScale = 2;
+    status.targetFPS = 60;
+    status.stars = true;
+    status.audioVoices = 3;
+
+    char line[TelemetryServer::MAX_LINE];
+    int length = server.formatLine(line, sizeof(line), status);
+    ASSERT(length > 0);
+    ASSERT(line[length - 1] == '\n');
+
+    std::string text(line, length);
+    ASSERT(text.find("\"frames\":100") != std::string::npos);
+    ASSERT(text.find("\"p50\":50.00") != std::string::npos);
+    ASSERT(text.find("\"p90\":90.00") != std::string::npos);
+    ASSERT(text.find("\"p99\":99.00") != std::string::npos);
+    ASSERT(text.find("\"max\":100.00") != std::string::npos);
+    ASSERT(text.find("\"scene\":4.00") != std::string::npos);
+    ASSERT(text.find("\"scale\":4,\"landscape_scale\":2") != std::string::npos);
+    ASSERT(text.find("\"stars\":true,\"clipping\":false") != std::string::npos);
+    ASSERT(text.find("\"total\":42") != std::string::npos);
+    ASSERT(text.find("\"rejected\":100") != std::string::npos);
+    ASSERT(text.find("\"voices\":3") != std::string::npos);
+
+    // Too small a buffer gives no line rather than a truncated one
+    length = server.formatLine(line, 16, status);
+    ASSERT(length == 0);
+}
+
+TEST(publish_to_client)
+{
+    TelemetryServer server;
+    bool opened = server.open(SOCKET_PATH);
+    ASSERT(opened);
+    int client = connectClient();
+    ASSERT(client >= 0);
+
+    recordFrames(server, 10, 5000);
+    server.publish(TelemetryStatus());
+    ASSERT(server.getClientCount() == 1);
+    ASSERT(server.getLinesSent() == 1);
+
+    char buffer[TelemetryServer::MAX_LINE];
+    ssize_t received = recv(client, buffer, sizeof(buffer), 0);
+    ASSERT(received > 0);
+    std::string text(buffer, received);
+    ASSERT(text.find("{\"seq\":0,\"frames\":10") == 0);
+    ASSERT(text.back() == '\n');
+
+    // The interval restarts after each publish
+    server.publish(TelemetryStatus());
+    received = recv(client, buffer, sizeof(buffer), 0);
+    text.assign(buffer, received);
+    ASSERT(text.find("{\"seq\":1,\"frames\":0") == 0);
+
+    // A collector that goes away is dropped without disturbing the game
+    close(client);
+    server.publish(TelemetryStatus());
+    server.publish(TelemetryStatus());
+    ASSERT(server.getClientCount() == 0);
+
+    server.close();
+    ASSERT(access(SOCKET_PATH, F_OK) != 0);
+}
+
+TEST(backpressure_drops_lines)
+{
+    TelemetryServer server;
+    bool opened = server.open(SOCKET_PATH);
+    ASSERT(opened);
+    int client = connectClient();
+    ASSERT(client >= 0);
+
+    // The collector never reads: publishing must keep returning and the
+    // lines that don't fit in the socket buffer are dropped
+    for (int i = 0; i < 20000; i++) {
+        recordFrames(server, 4, 1000);
+        server.publish(TelemetryStatus());
+    }
+    ASSERT(server.getLinesDropped() > 0);
+    ASSERT(server.getLinesSent() + server.getLinesDropped() == 20000);
+
+    // Everything the collector does receive is made of whole lines
+    char buffer[4096];
+    std::string text;
+    ssize_t received;
+    while ((received = recv(client, buffer, sizeof(buffer), MSG_DONTWAIT)) > 0) {
+        text.append(buffer, received);
+    }
+    size_t lines = 0;
+    size_t start = 0;
+    for (size_t newline; (newline = text.find('\n', start)) != std::string::npos; start = newline + 1) {
+        ASSERT(text.compare(start, 7, "{\"seq\":") == 0);
+        ASSERT(text[newline - 1] == '}');
+        lines++;
+    }
+    ASSERT(lines > 0);
+
+    close(client);
+    server.close();
+}
+
+// =============================================================================
+// Main
+// =============================================================================
+
+int main()
+{
+    std::printf("Telemetry Tests\n");
+    std::printf("===============\n\n");
+
+    RUN_TEST(format_line);
+    RUN_TEST(publish_to_client);
+    RUN_TEST(backpressure_drops_lines);
+
+    std::printf("\n===============\n");
+    std::printf("Tests: %d total, %d passed, %d failed\n",
+                testsRun, testsPassed, testsFailed);
+
+    return testsFailed > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,211 @@
+// test_thread_config.cpp
+// Test thread policy parsing and applying policies to the calling thread
+
+#include "thread_config.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// =============================================================================
+// Simple Test Framework
+// =============================================================================
+
+static int testsRun = 0;
+static int testsPassed = 0;
+static int testsFailed = 0;
+
+#define TEST(name) void test_##name()
+#define RUN_TEST(name) do { \
+    std::printf("  %s... ", #name); \
+    std::fflush(stdout); \
+    testsRun++; \
+    int failedBefore = testsFailed; \
+    test_##name(); \
+    if (testsFailed == failedBefore) { \
+        testsPassed++; \
+        std::printf("PASSED\n"); \
+    } \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        std::printf("FAILED\n    Assertion failed: %s\n    at %s:%d\n", \
+                    #cond, __FILE__, __LINE__); \
+        testsFailed++; \
+        return; \
+    } \
+} while(0)
+
+// =============================================================================
+// Tests
+// =============================================================================
+
+TEST(cpu_lists)
+{
+    uint64_t mask = 0x5;
+    bool parsed = parseCpuList("", mask);
+    ASSERT(parsed && mask == 0);
+    parsed = parseCpuList("3", mask);
+    ASSERT(parsed && mask == 0x8);
+    parsed = parseCpuList("0,2-4", mask);
+    ASSERT(parsed && mask == 0x1D);
+    parsed = parseCpuList("63", mask);
+    ASSERT(parsed && mask == (uint64_t(1) << 63));
+
+    // Malformed lists leave the mask alone
+    mask = 0x5;
+    static const char* const MALFORMED[] = {"64", "4-2", "1,", "a", "-1"};
+    for (const char* malformed : MALFORMED) {
+        parsed = parseCpuList(malformed, mask);
+        ASSERT(!parsed);
+    }
+    ASSERT(mask == 0x5);
+
+    char text[64];
+    formatCpuList(0x1D, text, sizeof(text));
+    ASSERT(std::strcmp(text, "0,2-4") == 0);
+    formatCpuList(0, text, sizeof(text));
+    ASSERT(text[0] == '\0');
+
+    // Round trip
+    formatCpuList(0xF0F00001ull, text, sizeof(text));
+    parsed = parseCpuList(text, mask);
+    ASSERT(parsed && mask == 0xF0F00001ull);
+}
+
+TEST(sched_class_names)
+{
+    for (int i = 0; i < SCHED_CLASS_COUNT; i++) {
+        SchedClass parsed = SchedClass::Default;
+        SchedClass schedClass = static_cast<SchedClass>(i);
+        bool known = parseSchedClass(getSchedClassName(schedClass), parsed);
+        ASSERT(known);
+        ASSERT(parsed == schedClass);
+    }
+
+    SchedClass unchanged = SchedClass::Batch;
+    bool known = parseSchedClass("realtime", unchanged);
+    ASSERT(!known);
+    ASSERT(unchanged == SchedClass::Batch);
+}
+
+TEST(default_policy)
+{
+    char error[256];
+    for (int role = 0; role < THREAD_ROLE_COUNT; role++) {
+        ASSERT(ThreadConfig::policies[role].isDefault());
+        bool applied = applyThreadPolicy(static_cast<ThreadRole>(role), error, sizeof(error));
+        ASSERT(applied);
+        ASSERT(error[0] == '\0');
+    }
+}
+
+#ifdef __linux__
+
+TEST(affinity_and_nice)
+{
+    // Pin to the first CPU this process may use
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    int result = sched_getaffinity(0, sizeof(allowed), &allowed);
+    ASSERT(result == 0);
+    int cpu = 0;
+    while (cpu < 64 && !CPU_ISSET(cpu, &allowed)) cpu++;
+    ASSERT(cpu < 64);
+
+    ThreadPolicy& policy = ThreadConfig::policies[static_cast<int>(ThreadRole::Worker)];
+    policy.cpuMask = uint64_t(1) << cpu;
+    policy.nice = ThreadConfig::MAX_NICE;  // Always permitted
+
+    int mainNice = getpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)));
+    bool applied = false;
+    int niceSeen = 0;
+    bool pinned = false;
+    std::thread worker([&] {
+        char error[256];
+        applied = applyThreadPolicy(ThreadRole::Worker, error, sizeof(error));
+
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        pthread_getaffinity_np(pthread_self(), sizeof(set), &set);
+        pinned = CPU_COUNT(&set) == 1 && CPU_ISSET(cpu, &set);
+        niceSeen = getpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)));
+    });
+    worker.join();
+    policy = ThreadPolicy();
+
+    ASSERT(applied);
+    ASSERT(pinned);
+    ASSERT(niceSeen == ThreadConfig::MAX_NICE);
+
+    // Only the worker changed
+    int niceNow = getpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)));
+    ASSERT(niceNow == mainNice);
+}
+
+TEST(real_time_fallback)
+{
+    ThreadPolicy& policy = ThreadConfig::policies[static_cast<int>(ThreadRole::Audio)];
+    policy.schedClass = SchedClass::Fifo;
+    policy.priority = 20;
+    policy.nice = ThreadConfig::MAX_NICE;
+
+    bool applied = false;
+    int schedPolicy = -1;
+    int niceSeen = 0;
+    char error[256] = "";
+    std::thread audio([&] {
+        applied = applyThreadPolicy(ThreadRole::Audio, error, sizeof(error));
+        sched_param param;
+        pthread_getschedparam(pthread_self(), &schedPolicy, &param);
+        niceSeen = getpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)));
+    });
+    audio.join();
+    policy = ThreadPolicy();
+
+    if (applied) {
+        // Privileged: the thread is real-time
+        ASSERT(schedPolicy == SCHED_FIFO);
+        ASSERT(error[0] == '\0');
+    } else {
+        // Unprivileged: reported, left on the default class with the nice level
+        ASSERT(std::strstr(error, "fifo") != nullptr);
+        ASSERT(schedPolicy == SCHED_OTHER);
+        ASSERT(niceSeen == ThreadConfig::MAX_NICE);
+    }
+}
+
+#endif // __linux__
+
+// =============================================================================
+// Main
+// =============================================================================
+
+int main()
+{
+    std::printf("Thread Config Tests\n");
+    std::printf("===================\n\n");
+
+    RUN_TEST(cpu_lists);
+    RUN_TEST(sched_class_names);
+    RUN_TEST(default_policy);
+#ifdef __linux__
+    RUN_TEST(affinity_and_nice);
+    RUN_TEST(real_time_fallback);
+#endif
+
+    std::printf("\n===================\n");
+    std::printf("Tests: %d total, %d passed, %d failed\n",
+                testsRun, testsPassed, testsFailed);
+
+    return testsFailed > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
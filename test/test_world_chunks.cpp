@@ -0,0 +1,229 @@
+// test_world_chunks.cpp
+// Test wide positions and streaming the unbounded world's object chunks
+
+#include "world_chunks.h"
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+
+// =============================================================================
+// Simple Test Framework
+// =============================================================================
+
+static int testsRun = 0;
+static int testsPassed = 0;
+static int testsFailed = 0;
+
+#define TEST(name) void test_##name()
+#define RUN_TEST(name) do { \
+    std::printf("  %s... ", #name); \
+    std::fflush(stdout); \
+    testsRun++; \
+    int failedBefore = testsFailed; \
+    test_##name(); \
+    if (testsFailed == failedBefore) { \
+        testsPassed++; \
+        std::printf("PASSED\n"); \
+    } \
+} while(0)
+
+#define ASSERT(cond) do { \
+    if (!(cond)) { \
+        std::printf("FAILED\n    Assertion failed: %s\n    at %s:%d\n", \
+                    #cond, __FILE__, __LINE__); \
+        testsFailed++; \
+        return; \
+    } \
+} while(0)
+
+// =============================================================================
+// Helpers
+// =============================================================================
+
+static Vec3 makePosition(int64_t wideX, int64_t wideZ)
+{
+    return Vec3(Fixed::fromRaw(static_cast<int32_t>(static_cast<uint32_t>(wideX))), Fixed(0),
+                Fixed::fromRaw(static_cast<int32_t>(static_cast<uint32_t>(wideZ))));
+}
+
+static int64_t tiles(int64_t count)
+{
+    return count << 24;
+}
+
+// Fly the player in steps of less than half a wrap, streaming as the game
+// does; false if the cache grew past its limit or the player didn't arrive
+static bool flyTo(ChunkedWorld& world, WidePosition& player, int64_t tileX, int64_t tileZ)
+{
+    const int64_t step = tiles(100);
+    int64_t targetX = tiles(tileX);
+    int64_t targetZ = tiles(tileZ);
+    int64_t x = player.x;
+    int64_t z = player.z;
+    while (x != targetX || z != targetZ) {
+        if (x < targetX) x = (targetX - x > step) ? x + step : targetX;
+        if (x > targetX) x = (x - targetX > step) ? x - step : targetX;
+        if (z < targetZ) z = (targetZ - z > step) ? z + step : targetZ;
+        if (z > targetZ) z = (z - targetZ > step) ? z - step : targetZ;
+
+        // The game only sees the wrapped 8.24 position
+        player.follow(makePosition(x, z));
+        world.update(player);
+        if (world.getCachedChunks() > ChunkedWorld::CACHE_CHUNKS) return false;
+    }
+    return player.x == targetX && player.z == targetZ;
+}
+
+// =============================================================================
+// Tests
+// =============================================================================
+
+TEST(wide_position)
+{
+    WidePosition position;
+    position.set(makePosition(tiles(3), tiles(4)));
+    ASSERT(position.getTileX() == 3 && position.getTileZ() == 4);
+
+    // Ten steps of 64 tiles cross the 8.24 range twice
+    for (int i = 1; i <= 10; i++) {
+        position.follow(makePosition(tiles(3 + 64 * i), tiles(4 - 64 * i)));
+    }
+    ASSERT(position.getTileX() == 643);
+    ASSERT(position.getTileZ() == -636);
+}
+
+TEST(generation)
+{
+    auto windowA = std::make_unique<ObjectMap>();
+    auto windowB = std::make_unique<ObjectMap>();
+    auto worldA = std::make_unique<ChunkedWorld>(*windowA);
+    auto worldB = std::make_unique<ChunkedWorld>(*windowB);
+
+    // The same tiles far away are the same in both worlds
+    bool sameEverywhere = true;
+    for (int64_t z = 0; z < ChunkedWorld::CHUNK_SIZE; z++) {
+        for (int64_t x = 0; x < ChunkedWorld::CHUNK_SIZE; x++) {
+            if (worldA->getObjectAt(1000000 + x, -5000 + z) != worldB->getObjectAt(1000000 + x, -5000 + z)) {
+                sameEverywhere = false;
+            }
+        }
+    }
+    ASSERT(sameEverywhere);
+
+    // Chunks one wrap apart are different
+    int objects = 0;
+    int differences = 0;
+    for (int64_t z = 0; z < ChunkedWorld::CHUNK_SIZE; z++) {
+        for (int64_t x = 64; x < 128; x++) {
+            uint8_t here = worldA->getObjectAt(x, z);
+            if (here != ObjectType::NONE) objects++;
+            if (here != worldA->getObjectAt(x + 256, z)) differences++;
+        }
+    }
+    ASSERT(objects > 0);
+    ASSERT(differences > 0);
+
+    // Every launchpad has its rockets
+    ASSERT(worldA->getObjectAt(7, 1) == ObjectType::LAUNCHPAD_OBJECT);
+    ASSERT(worldA->getObjectAt(256 + 7, 512 + 3) == ObjectType::LAUNCHPAD_OBJECT);
+}
+
+TEST(window)
+{
+    auto window = std::make_unique<ObjectMap>();
+    auto world = std::make_unique<ChunkedWorld>(*window);
+    WidePosition player;
+    player.set(makePosition(tiles(4), tiles(4)));
+    world->reset(player);
+    ASSERT(window->getObjectAt(7, 1) == ObjectType::LAUNCHPAD_OBJECT);
+
+    // At least 96 tiles each way, read through the 8.24 tile
+    bool flew = flyTo(*world, player, 5000, -3000);
+    ASSERT(flew);
+    for (int64_t z = -96; z <= 96; z += 8) {
+        for (int64_t x = -96; x <= 96; x += 8) {
+            int64_t tileX = 5000 + x;
+            int64_t tileZ = -3000 + z;
+            ASSERT(window->getObjectAt(static_cast<uint8_t>(tileX), static_cast<uint8_t>(tileZ)) ==
+                   world->getObjectAt(tileX, tileZ));
+        }
+    }
+
+    // Staying in the same chunk streams nothing
+    int generated = world->getChunksGenerated();
+    flew = flyTo(*world, player, 5010, -2990);
+    ASSERT(flew);
+    ASSERT(world->getChunksGenerated() == generated);
+}
+
+TEST(deltas)
+{
+    auto window = std::make_unique<ObjectMap>();
+    auto world = std::make_unique<ChunkedWorld>(*window);
+    WidePosition player;
+    player.set(makePosition(tiles(4), tiles(4)));
+    world->reset(player);
+
+    // Destroy the first object found near the launchpad, through the window
+    int64_t targetX = -1;
+    int64_t targetZ = -1;
+    for (int64_t z = 10; z < 60 && targetX < 0; z++) {
+        for (int64_t x = 10; x < 60; x++) {
+            uint8_t objectType = window->getObjectAt(static_cast<uint8_t>(x), static_cast<uint8_t>(z));
+            if (objectType != ObjectType::NONE) {
+                window->setObjectAt(static_cast<uint8_t>(x), static_cast<uint8_t>(z),
+                                    ObjectMap::getDestroyedType(objectType));
+                targetX = x;
+                targetZ = z;
+                break;
+            }
+        }
+    }
+    ASSERT(targetX >= 0);
+    uint8_t destroyed = world->getObjectAt(targetX, targetZ);
+    ASSERT(ObjectMap::isDestroyedType(destroyed));
+
+    // Far enough away for the chunk to leave the window and the cache
+    bool flew = flyTo(*world, player, 20000, 20000);
+    ASSERT(flew);
+    ASSERT(world->getDeltaCount() == 1);
+    ASSERT(world->getObjectAt(targetX, targetZ) == destroyed);
+
+    // The same 8.24 tile out here is the nearest wide tile that wraps to it
+    uint8_t wrapped = window->getObjectAt(static_cast<uint8_t>(targetX), static_cast<uint8_t>(targetZ));
+    int64_t nearX = 20000 + static_cast<int8_t>(static_cast<uint8_t>(targetX - 20000));
+    int64_t nearZ = 20000 + static_cast<int8_t>(static_cast<uint8_t>(targetZ - 20000));
+    ASSERT(wrapped == world->getObjectAt(nearX, nearZ));
+
+    // Back home it is still destroyed
+    flew = flyTo(*world, player, 4, 4);
+    ASSERT(flew);
+    ASSERT(window->getObjectAt(static_cast<uint8_t>(targetX), static_cast<uint8_t>(targetZ)) == destroyed);
+
+    // A reset restores it
+    world->reset(player);
+    ASSERT(world->getDeltaCount() == 0);
+    ASSERT(!ObjectMap::isDestroyedType(
+        window->getObjectAt(static_cast<uint8_t>(targetX), static_cast<uint8_t>(targetZ))));
+}
+
+// =============================================================================
+// Main
+// =============================================================================
+
+int main()
+{
+    std::printf("World Chunk Tests\n");
+    std::printf("=================\n\n");
+
+    RUN_TEST(wide_position);
+    RUN_TEST(generation);
+    RUN_TEST(window);
+    RUN_TEST(deltas);
+
+    std::printf("\n=================\n");
+    std::printf("Tests: %d total, %d passed, %d failed\n",
+                testsRun, testsPassed, testsFailed);
+
+    return testsFailed > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}